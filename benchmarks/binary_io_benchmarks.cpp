@@ -0,0 +1,814 @@
+/******************************************************************************/
+/*!
+ * @file   binary_io_benchmarks.cpp
+ * @author Shareef Abdoul-Raheem (https://blufedora.github.io/)
+ * @date   2024-11-06
+ * @brief
+ *   Throughput and latency measurements for the stream backends and helpers.
+ *
+ *   Usage: BinaryIO_Benchmarks [name_filter]
+ *
+ * @copyright Copyright (c) 2024 Shareef Abdoul-Raheem
+ */
+/******************************************************************************/
+#include "binaryio/binary_bit_stream.hpp"
+#include "binaryio/binary_chunk.hpp"
+#include "binaryio/binary_chunk_io.hpp"
+#include "binaryio/binary_compression.hpp"
+#include "binaryio/binary_executor.hpp"
+#include "binaryio/binary_pipe_stream.hpp"
+#include "binaryio/binary_schema.hpp"
+#include "binaryio/binary_span_stream.hpp"
+#include "binaryio/binary_stream.hpp"
+#include "binaryio/binary_stream_ext.hpp"
+#include "binaryio/rel_ptr.hpp"
+
+#include <chrono>              // steady_clock
+#include <condition_variable>  // condition_variable
+#include <cstdio>              // printf, tmpfile
+#include <cstring>             // strstr
+#include <deque>               // deque
+#include <mutex>               // mutex, unique_lock, lock_guard
+#include <thread>              // thread
+#include <vector>              // vector
+
+using namespace binaryIO;
+
+namespace
+{
+  using Clock = std::chrono::steady_clock;
+
+  constexpr double k_MinBenchmarkSeconds = 0.2;
+
+  const char* g_Filter = nullptr;
+
+  template<typename T>
+  void DoNotOptimize(const T& value)
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* s_Sink;
+    s_Sink = &value;
+#endif
+  }
+
+  //
+  // Runs `fn` repeatedly until enough time has passed for a stable measurement,
+  // returns seconds per call of `fn`.
+  //
+  template<typename F>
+  double Measure(F&& fn)
+  {
+    fn();  // Warm up.
+
+    std::size_t       num_iterations = 1u;
+    Clock::time_point start;
+    double            elapsed;
+
+    for (;;)
+    {
+      start = Clock::now();
+      for (std::size_t i = 0u; i < num_iterations; ++i)
+      {
+        fn();
+      }
+      elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+      if (elapsed >= k_MinBenchmarkSeconds)
+      {
+        break;
+      }
+
+      num_iterations *= 2u;
+    }
+
+    return elapsed / double(num_iterations);
+  }
+
+  bool ShouldRun(const char* const name)
+  {
+    return g_Filter == nullptr || std::strstr(name, g_Filter) != nullptr;
+  }
+
+  template<typename F>
+  void Throughput(const char* const name, const IOSize num_bytes, F&& fn)
+  {
+    if (ShouldRun(name))
+    {
+      const double seconds = Measure(fn);
+      std::printf("%-48s %10llu B %10.3f GB/s\n", name, static_cast<unsigned long long>(num_bytes), double(num_bytes) / seconds / 1e9);
+    }
+  }
+
+  template<typename F>
+  void Latency(const char* const name, const IOSize num_calls, F&& fn)
+  {
+    if (ShouldRun(name))
+    {
+      const double seconds = Measure(fn);
+      std::printf("%-48s %10llu x %10.3f ns/call\n", name, static_cast<unsigned long long>(num_calls), seconds / double(num_calls) * 1e9);
+    }
+  }
+
+  const IOSize k_PayloadSizes[] = {4u << 10, 64u << 10, 1u << 20, 16u << 20};
+
+  constexpr IOSize k_NumCalls = 1u << 16;
+
+  // Stream Backends
+
+  void BenchmarkMemoryStreams()
+  {
+    char name[64];
+
+    for (const IOSize payload_size : k_PayloadSizes)
+    {
+      std::vector<std::uint8_t> source(payload_size, 0xAB);
+      std::vector<std::uint8_t> destination(payload_size);
+
+      std::snprintf(name, sizeof(name), "IOStream_FromRWMemory/Write/%llu", static_cast<unsigned long long>(payload_size));
+      Throughput(name, payload_size, [&]() {
+        IOStream stream = IOStream_FromRWMemory(destination.data(), destination.size());
+        IOStream_Write(&stream, source.data(), source.size());
+        DoNotOptimize(destination[0]);
+      });
+
+      std::snprintf(name, sizeof(name), "IOStream_FromROMemory/Read/%llu", static_cast<unsigned long long>(payload_size));
+      Throughput(name, payload_size, [&]() {
+        IOStream stream = IOStream_FromROMemory(source.data(), source.size());
+        IOStream_Read(&stream, destination.data(), destination.size());
+        DoNotOptimize(destination[0]);
+      });
+
+      std::snprintf(name, sizeof(name), "IOStream_FromVector/Write/%llu", static_cast<unsigned long long>(payload_size));
+      Throughput(name, payload_size, [&]() {
+        std::vector<std::uint8_t> buffer;
+        IOStream                  stream = IOStream_FromVector(&buffer);
+        IOStream_Write(&stream, source.data(), source.size());
+        DoNotOptimize(buffer.data());
+      });
+
+      std::vector<std::uint8_t> vector_source = source;
+
+      std::snprintf(name, sizeof(name), "IOStream_FromVector/Read/%llu", static_cast<unsigned long long>(payload_size));
+      Throughput(name, payload_size, [&]() {
+        IOStream stream = IOStream_FromVector(&vector_source);
+        IOStream_Read(&stream, destination.data(), destination.size());
+        DoNotOptimize(destination[0]);
+      });
+    }
+  }
+
+  void BenchmarkCFileStreams()
+  {
+    char name[64];
+
+    for (const IOSize payload_size : k_PayloadSizes)
+    {
+      std::FILE* const file_handle = std::tmpfile();
+
+      if (!file_handle)
+      {
+        std::printf("IOStream_FromCFile: failed to create a temporary file.\n");
+        return;
+      }
+
+      std::vector<std::uint8_t> source(payload_size, 0xCD);
+      std::vector<std::uint8_t> destination(payload_size);
+      IOStream                  stream = IOStream_FromCFile(file_handle);
+
+      std::snprintf(name, sizeof(name), "IOStream_FromCFile/Write/%llu", static_cast<unsigned long long>(payload_size));
+      Throughput(name, payload_size, [&]() {
+        IOStream_Seek(&stream, 0, SeekOrigin::BEGIN);
+        IOStream_Write(&stream, source.data(), source.size());
+      });
+
+      std::snprintf(name, sizeof(name), "IOStream_FromCFile/Read/%llu", static_cast<unsigned long long>(payload_size));
+      Throughput(name, payload_size, [&]() {
+        IOStream_Seek(&stream, 0, SeekOrigin::BEGIN);
+        IOStream_Read(&stream, destination.data(), destination.size());
+        DoNotOptimize(destination[0]);
+      });
+
+      IOStream_Close(&stream);
+    }
+  }
+
+  // Endian Helpers
+
+  template<typename T>
+  void BenchmarkEndianHelpers(const char* const type_name)
+  {
+    char name[64];
+
+    std::vector<std::uint8_t> buffer(k_NumCalls * sizeof(T));
+
+    std::snprintf(name, sizeof(name), "writeBE<%s>/RWMemory", type_name);
+    Latency(name, k_NumCalls, [&]() {
+      IOStream stream = IOStream_FromRWMemory(buffer.data(), buffer.size());
+      for (IOSize i = 0u; i < k_NumCalls; ++i)
+      {
+        writeBE(&stream, T(i));
+      }
+      DoNotOptimize(buffer[0]);
+    });
+
+    std::snprintf(name, sizeof(name), "writeLE<%s>/Vector", type_name);
+    Latency(name, k_NumCalls, [&]() {
+      std::vector<std::uint8_t> destination;
+      IOStream                  stream = IOStream_FromVector(&destination, buffer.size());
+      for (IOSize i = 0u; i < k_NumCalls; ++i)
+      {
+        writeLE(&stream, T(i));
+      }
+      IOStream_Close(&stream);
+      DoNotOptimize(destination[0]);
+    });
+
+    std::snprintf(name, sizeof(name), "readLE<%s>/ROMemory", type_name);
+    Latency(name, k_NumCalls, [&]() {
+      IOStream stream = IOStream_FromROMemory(buffer.data(), buffer.size());
+      T        value  = {};
+      for (IOSize i = 0u; i < k_NumCalls; ++i)
+      {
+        readLE(&stream, &value);
+        DoNotOptimize(value);
+      }
+    });
+
+    std::snprintf(name, sizeof(name), "readBE<%s>/Vector", type_name);
+    Latency(name, k_NumCalls, [&]() {
+      IOStream stream = IOStream_FromVector(&buffer);
+      T        value  = {};
+      for (IOSize i = 0u; i < k_NumCalls; ++i)
+      {
+        readBE(&stream, &value);
+        DoNotOptimize(value);
+      }
+    });
+  }
+
+  // Variable Length Integers
+
+  void BenchmarkVarInts()
+  {
+    std::vector<std::uint32_t> values(k_NumCalls);
+    std::vector<std::uint8_t>  encoded;
+
+    // Mostly small values with the occasional large one like typical ids and counts, scattered by a hash
+    // so that the encoded lengths are not a pattern the branch predictor can learn.
+    for (IOSize i = 0u; i < values.size(); ++i)
+    {
+      const std::uint32_t hash = std::uint32_t(i * 2654435761u);
+
+      values[i] = (hash >> 28u) == 0u ? hash : (hash >> 20u) % 300u;
+    }
+
+    IOStream encode_stream = IOStream_FromVector(&encoded);
+    writeVarUIntArray(&encode_stream, values.data(), values.size());
+    IOStream_Close(&encode_stream);
+
+    Latency("writeVarUInt<uint32_t>/Vector", k_NumCalls, [&]() {
+      std::vector<std::uint8_t> buffer;
+      IOStream                  stream = IOStream_FromVector(&buffer, encoded.size());
+      for (IOSize i = 0u; i < k_NumCalls; ++i)
+      {
+        writeVarUInt(&stream, values[i]);
+      }
+      DoNotOptimize(buffer[0]);
+    });
+
+    Latency("readVarUInt<uint32_t>/ROMemory", k_NumCalls, [&]() {
+      IOStream      stream = IOStream_FromROMemory(encoded.data(), encoded.size());
+      std::uint32_t value  = 0u;
+      for (IOSize i = 0u; i < k_NumCalls; ++i)
+      {
+        readVarUInt(&stream, &value);
+        DoNotOptimize(value);
+      }
+    });
+
+    Latency("readVarUIntArray<uint32_t>/ROMemory", k_NumCalls, [&]() {
+      IOStream stream = IOStream_FromROMemory(encoded.data(), encoded.size());
+      readVarUIntArray(&stream, values.data(), values.size());
+      DoNotOptimize(values[0]);
+    });
+  }
+
+  // Bit Stream
+
+  void BenchmarkBitStream()
+  {
+    static constexpr unsigned k_FieldBits = 12u;
+
+    std::vector<std::uint8_t> encoded;
+    IOStream                  encode_stream = IOStream_FromVector(&encoded);
+    BitWriter                 encoder{&encode_stream};
+
+    for (IOSize i = 0u; i < k_NumCalls; ++i)
+    {
+      encoder.writeBits(i, k_FieldBits);
+    }
+    encoder.flush();
+    IOStream_Close(&encode_stream);
+
+    Latency("BitWriter::writeBits/12b/Vector", k_NumCalls, [&]() {
+      std::vector<std::uint8_t> buffer;
+      IOStream                  stream = IOStream_FromVector(&buffer, encoded.size());
+      BitWriter                 writer{&stream};
+      for (IOSize i = 0u; i < k_NumCalls; ++i)
+      {
+        writer.writeBits(i, k_FieldBits);
+      }
+      writer.flush();
+      DoNotOptimize(buffer[0]);
+    });
+
+    Latency("BitReader::readBits/12b/ROMemory", k_NumCalls, [&]() {
+      IOStream  stream = IOStream_FromROMemory(encoded.data(), encoded.size());
+      BitReader reader{&stream};
+      for (IOSize i = 0u; i < k_NumCalls; ++i)
+      {
+        std::uint64_t value = reader.readBits(k_FieldBits);
+        DoNotOptimize(value);
+      }
+      reader.finish();
+    });
+  }
+
+  // Compression
+
+  void BenchmarkCompression()
+  {
+    static constexpr IOSize k_PayloadSize = 4u << 20;
+
+    // Table like data, small counters and repeated fields compress the way typical asset data does.
+    std::vector<std::uint32_t> source(k_PayloadSize / sizeof(std::uint32_t));
+
+    for (IOSize i = 0u; i < source.size(); ++i)
+    {
+      source[i] = (i % 4u) == 0u ? std::uint32_t(i / 4u) : std::uint32_t(i * 2654435761u) >> 29u;
+    }
+
+    const IOCodec             codec     = IOCodec_LZ4();
+    const IOAllocator         allocator = IOAllocator_Default();
+    std::vector<std::uint8_t> compressed;
+
+    IOStream encode_stream = IOStream_FromVector(&compressed);
+    IOStream compressor    = IOStream_FromCompressor(&encode_stream, codec, allocator);
+    IOStream_Write(&compressor, source.data(), k_PayloadSize);
+    IOStream_Close(&compressor);
+    IOStream_Close(&encode_stream);
+
+    Throughput("IOStream_FromCompressor/LZ4", k_PayloadSize, [&]() {
+      std::vector<std::uint8_t> buffer;
+      IOStream                  destination = IOStream_FromVector(&buffer, compressed.size());
+      IOStream                  stream      = IOStream_FromCompressor(&destination, codec, allocator);
+      IOStream_Write(&stream, source.data(), k_PayloadSize);
+      IOStream_Close(&stream);
+      DoNotOptimize(buffer[0]);
+    });
+
+    Throughput("IOStream_FromDecompressor/LZ4/ROMemory", k_PayloadSize, [&]() {
+      IOStream    compressed_stream = IOStream_FromROMemory(compressed.data(), compressed.size());
+      IOStream    stream            = IOStream_FromDecompressor(&compressed_stream, codec, allocator);
+      std::size_t checksum          = 0u;
+      while (IOSteam_SupportsBufferedRead(&stream) && BufferedIO_Refill(&stream) == IOErrorCode::Success)
+      {
+        checksum += BufferedIO_NumBytesAvailable(&stream);
+        stream.buffered_io.cursor = stream.buffered_io.buffer_end;
+      }
+      IOStream_Close(&stream);
+      DoNotOptimize(checksum);
+    });
+
+    Executor threads = Executor_FromThreads(std::thread::hardware_concurrency());
+
+    Throughput("IOStream_FromParallelCompressor/LZ4", k_PayloadSize, [&]() {
+      std::vector<std::uint8_t> buffer;
+      IOStream                  destination = IOStream_FromVector(&buffer, compressed.size());
+      IOStream                  stream      = IOStream_FromParallelCompressor(&destination, codec, allocator, threads);
+      IOStream_Write(&stream, source.data(), k_PayloadSize);
+      IOStream_Close(&stream);
+      DoNotOptimize(buffer[0]);
+    });
+
+    Throughput("IOStream_FromParallelDecompressor/LZ4/ROMemory", k_PayloadSize, [&]() {
+      IOStream    compressed_stream = IOStream_FromROMemory(compressed.data(), compressed.size());
+      IOStream    stream            = IOStream_FromParallelDecompressor(&compressed_stream, codec, allocator, threads);
+      std::size_t checksum          = 0u;
+      while (IOSteam_SupportsBufferedRead(&stream) && BufferedIO_Refill(&stream) == IOErrorCode::Success)
+      {
+        checksum += BufferedIO_NumBytesAvailable(&stream);
+        stream.buffered_io.cursor = stream.buffered_io.buffer_end;
+      }
+      IOStream_Close(&stream);
+      DoNotOptimize(checksum);
+    });
+
+    Executor_Destroy(&threads);
+
+    // Random 4KiB reads out of a seekable chunk only decompress the blocks they touch.
+    static constexpr IOSize k_NumRandomReads = 256u;
+    static constexpr IOSize k_RandomReadSize = 4u << 10;
+
+    std::vector<std::uint8_t> chunk_file;
+    IOStream                  chunk_stream = IOStream_FromVector(&chunk_file);
+    ChunkWriter               chunk_writer;
+    chunk_writer.beginCompressedSeekable(&chunk_stream, BinaryChunkTypeID("BNCH"), 1u, codec, allocator);
+    chunk_writer.write(source.data(), k_PayloadSize);
+    chunk_writer.end();
+    IOStream_Close(&chunk_stream);
+
+    IOStream    chunk_reader_stream = IOStream_FromROMemory(chunk_file.data(), chunk_file.size());
+    ChunkReader chunk_reader{&chunk_reader_stream};
+    ChunkView   chunk;
+    chunk_reader.next(&chunk);
+
+    Latency("IOStream_Seek+Read/4KiB/SeekableChunk/LZ4", k_NumRandomReads, [&]() {
+      IOStream     stream = IOStream_FromCompressedChunk(chunk, codec, allocator);
+      std::uint8_t destination[k_RandomReadSize];
+      for (IOSize i = 0u; i < k_NumRandomReads; ++i)
+      {
+        IOStream_Seek(&stream, IOOffset(std::uint32_t(i * 2654435761u) % (k_PayloadSize - k_RandomReadSize)), SeekOrigin::BEGIN);
+        IOStream_Read(&stream, destination, sizeof(destination));
+        DoNotOptimize(destination[0]);
+      }
+      IOStream_Close(&stream);
+    });
+  }
+
+  // Buffered IO
+
+  void BenchmarkBufferedRead()
+  {
+    static constexpr IOSize k_ReadSize    = 16u;
+    static constexpr IOSize k_PayloadSize = k_NumCalls * k_ReadSize;
+
+    std::vector<std::uint8_t> source(k_PayloadSize, 0xEF);
+    std::uint8_t              destination[k_ReadSize];
+
+    Latency("IOStream_Read/16B/ROMemory", k_NumCalls, [&]() {
+      IOStream stream = IOStream_FromROMemory(source.data(), source.size());
+      for (IOSize i = 0u; i < k_NumCalls; ++i)
+      {
+        IOStream_Read(&stream, destination, sizeof(destination));
+        DoNotOptimize(destination[0]);
+      }
+    });
+
+    Latency("BufferedIO_Read/16B/ROMemory", k_NumCalls, [&]() {
+      IOStream stream = IOStream_FromROMemory(source.data(), source.size());
+      for (IOSize i = 0u; i < k_NumCalls; ++i)
+      {
+        BufferedIO_Read(&stream, destination, sizeof(destination));
+        DoNotOptimize(destination[0]);
+      }
+    });
+  }
+
+  // Checksums
+
+  void BenchmarkCrc32()
+  {
+    char name[64];
+
+    for (const IOSize payload_size : k_PayloadSizes)
+    {
+      std::vector<std::uint8_t> source(payload_size, 0x5A);
+
+      std::snprintf(name, sizeof(name), "crc32_addBytes/%llu", static_cast<unsigned long long>(payload_size));
+      Throughput(name, payload_size, [&]() {
+        std::uint32_t crc = crc32_begin();
+        crc32_addBytes(&crc, source.data(), source.size());
+        crc32_end(&crc);
+        DoNotOptimize(crc);
+      });
+    }
+  }
+
+  // Schema Serialization
+
+  struct SchemaRecord
+  {
+    std::uint8_t  tag;
+    std::uint32_t id;
+    std::uint16_t flags;
+    float         position[3];
+    std::uint64_t timestamp;
+  };
+
+  IOSchema<BINARYIO_FIELD(SchemaRecord, tag), BINARYIO_FIELD(SchemaRecord, id), BINARYIO_FIELD(SchemaRecord, flags), BINARYIO_FIELD(SchemaRecord, position), BINARYIO_FIELD(SchemaRecord, timestamp)> ioSchema(const SchemaRecord*) { return {}; }
+
+  struct SchemaPackedRecord
+  {
+    std::uint32_t id;
+    float         position[3];
+  };
+
+  IOSchema<BINARYIO_FIELD(SchemaPackedRecord, id), BINARYIO_FIELD(SchemaPackedRecord, position)> ioSchema(const SchemaPackedRecord*) { return {}; }
+
+  void BenchmarkSchema()
+  {
+    std::vector<SchemaRecord>       records(k_NumCalls, SchemaRecord{1u, 2u, 3u, {4.0f, 5.0f, 6.0f}, 7u});
+    std::vector<SchemaPackedRecord> packed_records(k_NumCalls, SchemaPackedRecord{1u, {2.0f, 3.0f, 4.0f}});
+    std::vector<std::uint8_t>       buffer(k_NumCalls * k_WireSize<SchemaRecord>);
+    std::uint8_t                    scratch[4096];
+
+    // Writes go through `IOStream_MakeBuffered` so that there is a `BufferedWriteIO` window.
+
+    Latency("writeLE/PerField/Buffered", k_NumCalls, [&]() {
+      IOStream memory = IOStream_FromRWMemory(buffer.data(), buffer.size());
+      IOStream stream = IOStream_MakeBuffered(&memory, scratch, sizeof(scratch));
+      for (const SchemaRecord& record : records)
+      {
+        std::uint32_t position_bits[3];
+        std::memcpy(position_bits, record.position, sizeof(position_bits));
+
+        writeLE(&stream, record.tag);
+        writeLE(&stream, record.id);
+        writeLE(&stream, record.flags);
+        writeLE(&stream, position_bits[0]);
+        writeLE(&stream, position_bits[1]);
+        writeLE(&stream, position_bits[2]);
+        writeLE(&stream, record.timestamp);
+      }
+      IOStream_Close(&stream);
+      DoNotOptimize(buffer[0]);
+    });
+
+    Latency("writeSchema/Buffered", k_NumCalls, [&]() {
+      IOStream memory = IOStream_FromRWMemory(buffer.data(), buffer.size());
+      IOStream stream = IOStream_MakeBuffered(&memory, scratch, sizeof(scratch));
+      for (const SchemaRecord& record : records)
+      {
+        writeSchema(&stream, record);
+      }
+      IOStream_Close(&stream);
+      DoNotOptimize(buffer[0]);
+    });
+
+    Latency("readSchema/ROMemory", k_NumCalls, [&]() {
+      IOStream stream = IOStream_FromROMemory(buffer.data(), buffer.size());
+      for (SchemaRecord& record : records)
+      {
+        readSchema(&stream, &record);
+      }
+      DoNotOptimize(records[0]);
+    });
+
+    Latency("writeSchemaArray/Buffered", k_NumCalls, [&]() {
+      IOStream memory = IOStream_FromRWMemory(buffer.data(), buffer.size());
+      IOStream stream = IOStream_MakeBuffered(&memory, scratch, sizeof(scratch));
+      writeSchemaArray(&stream, records.data(), records.size());
+      IOStream_Close(&stream);
+      DoNotOptimize(buffer[0]);
+    });
+
+    Latency("writeSchemaArray/Packed/Buffered", k_NumCalls, [&]() {
+      IOStream memory = IOStream_FromRWMemory(buffer.data(), buffer.size());
+      IOStream stream = IOStream_MakeBuffered(&memory, scratch, sizeof(scratch));
+      writeSchemaArray(&stream, packed_records.data(), packed_records.size());
+      IOStream_Close(&stream);
+      DoNotOptimize(buffer[0]);
+    });
+  }
+
+  // Span Streams
+
+  // Packs small messages into a 1500 byte packet, starting a new packet whenever the next message does not fit.
+  template<typename Stream>
+  void WriteTickMessage(Stream* const stream, const std::uint32_t i)
+  {
+    writeLE(stream, std::uint16_t(i & 0x7u));
+    writeLE(stream, std::uint32_t(i));
+    writeLE(stream, std::uint8_t(i >> 3u));
+    writeVarUInt(stream, i & 0x3FFFu);
+  }
+
+  void BenchmarkSpanStream()
+  {
+    constexpr IOSize k_PacketSize     = 1500u;
+    constexpr IOSize k_MaxMessageSize = 2u + 4u + 1u + 2u;
+
+    std::uint8_t packet[k_PacketSize];
+
+    Latency("writeLE+writeVarUInt/RWMemory/Packet", k_NumCalls, [&]() {
+      IOStream stream = IOStream_FromRWMemory(packet, sizeof(packet));
+      for (std::uint32_t i = 0u; i < k_NumCalls; ++i)
+      {
+        if (stream.user_data.memory_stream.BytesLeft() < k_MaxMessageSize)
+        {
+          DoNotOptimize(packet[0]);
+          stream = IOStream_FromRWMemory(packet, sizeof(packet));
+        }
+        WriteTickMessage(&stream, i);
+      }
+      DoNotOptimize(packet[0]);
+    });
+
+    Latency("writeLE+writeVarUInt/StaticMemoryStream/Packet", k_NumCalls, [&]() {
+      StaticMemoryStream<k_PacketSize> stream;
+      for (std::uint32_t i = 0u; i < k_NumCalls; ++i)
+      {
+        if (stream.bytesLeft() < k_MaxMessageSize)
+        {
+          DoNotOptimize(stream.storage[0]);
+          stream.reset();
+        }
+        WriteTickMessage(&stream, i);
+      }
+      DoNotOptimize(stream.storage[0]);
+    });
+  }
+
+  // Thread Hand Off
+
+  void BenchmarkPipeStream()
+  {
+    constexpr IOSize k_PayloadSize = 16u << 20;
+    constexpr IOSize k_BlockSize   = 64u << 10;
+    constexpr IOSize k_NumValues   = k_PayloadSize / sizeof(std::uint32_t);
+
+    std::vector<std::uint8_t> block(k_BlockSize, 0x5Au);
+
+    // The status quo, a mutex guarded queue of vectors each parsed through a memory stream.
+    Throughput("readLE<uint32_t>/MutexQueue", k_PayloadSize, [&]() {
+      std::mutex                            lock;
+      std::condition_variable               signal;
+      std::deque<std::vector<std::uint8_t>> queue;
+
+      std::thread producer([&]() {
+        for (IOSize offset = 0u; offset < k_PayloadSize; offset += k_BlockSize)
+        {
+          std::vector<std::uint8_t> copy = block;
+          {
+            const std::lock_guard<std::mutex> guard{lock};
+            queue.push_back(std::move(copy));
+          }
+          signal.notify_one();
+        }
+      });
+
+      std::uint32_t sum = 0u;
+      for (IOSize offset = 0u; offset < k_PayloadSize; offset += k_BlockSize)
+      {
+        std::vector<std::uint8_t> bytes;
+        {
+          std::unique_lock<std::mutex> guard{lock};
+          signal.wait(guard, [&]() { return !queue.empty(); });
+          bytes = std::move(queue.front());
+          queue.pop_front();
+        }
+
+        IOStream stream = IOStream_FromROMemory(bytes.data(), bytes.size());
+        for (IOSize i = 0u; i < k_BlockSize / sizeof(std::uint32_t); ++i)
+        {
+          std::uint32_t value = 0u;
+          if (readLE(&stream, &value).ErrorCode() != IOErrorCode::Success)
+          {
+            break;
+          }
+          sum += value;
+        }
+      }
+      producer.join();
+      DoNotOptimize(sum);
+    });
+
+    std::vector<std::uint8_t> scratch(4u * k_BlockSize);
+
+    Throughput("readLE<uint32_t>/Pipe", k_PayloadSize, [&]() {
+      IOPipe pipe = IOStream_MakePipe(scratch.data(), scratch.size());
+
+      std::thread producer([&]() {
+        for (IOSize offset = 0u; offset < k_PayloadSize; offset += k_BlockSize)
+        {
+          IOStream_Write(&pipe.writer, block.data(), block.size());
+        }
+        IOStream_Close(&pipe.writer);
+      });
+
+      std::uint32_t sum = 0u;
+      for (IOSize i = 0u; i < k_NumValues; ++i)
+      {
+        std::uint32_t value = 0u;
+        if (readLE(&pipe.reader, &value).ErrorCode() != IOErrorCode::Success)
+        {
+          break;
+        }
+        sum += value;
+      }
+      // Closing the reader first fails any write still blocked on a full ring rather than hanging the join.
+      IOStream_Close(&pipe.reader);
+      producer.join();
+      DoNotOptimize(sum);
+    });
+  }
+
+  // Relative Pointers
+
+  struct RelPtrNode
+  {
+    rel_ptr32<RelPtrNode> next;
+    std::uint32_t         value;
+  };
+
+  void BenchmarkRelPtr()
+  {
+    std::vector<RelPtrNode> nodes(k_NumCalls);
+
+    for (IOSize i = 0u; i < nodes.size(); ++i)
+    {
+      nodes[i].value = std::uint32_t(i);
+      nodes[i].next  = &nodes[(i * 7919u) % nodes.size()];
+    }
+
+    Latency("rel_ptr::get/PointerChase", k_NumCalls, [&]() {
+      const RelPtrNode* node = &nodes[0];
+      std::uint32_t     sum  = 0u;
+      for (IOSize i = 0u; i < k_NumCalls; ++i)
+      {
+        sum += node->value;
+        node = node->next.get();
+      }
+      DoNotOptimize(sum);
+    });
+
+    // Every fourth pointer is null so the branch in `get` is unpredictable.
+    std::vector<rel_ptr32<RelPtrNode>> pointers(k_NumCalls);
+    std::vector<RelPtrNode*>           absolute(k_NumCalls);
+
+    for (IOSize i = 0u; i < pointers.size(); ++i)
+    {
+      pointers[i] = (i * 2654435761u) % 7u < 2u ? nullptr : &nodes[(i * 7919u) % nodes.size()];
+    }
+
+    Latency("rel_ptr::get/Array", k_NumCalls, [&]() {
+      for (IOSize i = 0u; i < k_NumCalls; ++i)
+      {
+        absolute[i] = pointers[i].get();
+      }
+      DoNotOptimize(absolute[0]);
+    });
+
+    Latency("RelPtr_ToPointers/Array", k_NumCalls, [&]() {
+      RelPtr_ToPointers(pointers.data(), k_NumCalls, absolute.data());
+      DoNotOptimize(absolute[0]);
+    });
+
+    Latency("RelPtr_FromPointers/Array", k_NumCalls, [&]() {
+      RelPtr_FromPointers(absolute.data(), k_NumCalls, pointers.data());
+      DoNotOptimize(pointers[0]);
+    });
+  }
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+  g_Filter = argc > 1 ? argv[1] : nullptr;
+
+  BenchmarkMemoryStreams();
+  BenchmarkCFileStreams();
+  BenchmarkEndianHelpers<std::uint8_t>("uint8_t");
+  BenchmarkEndianHelpers<std::uint16_t>("uint16_t");
+  BenchmarkEndianHelpers<std::uint32_t>("uint32_t");
+  BenchmarkEndianHelpers<std::uint64_t>("uint64_t");
+  BenchmarkVarInts();
+  BenchmarkSchema();
+  BenchmarkSpanStream();
+  BenchmarkPipeStream();
+  BenchmarkBitStream();
+  BenchmarkCompression();
+  BenchmarkBufferedRead();
+  BenchmarkCrc32();
+  BenchmarkRelPtr();
+
+  return 0;
+}
+
+/******************************************************************************/
+/*
+  MIT License
+
+  Copyright (c) 2024 Shareef Abdoul-Raheem
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+/******************************************************************************/
@@ -0,0 +1,124 @@
+/******************************************************************************/
+/*!
+ * @file   binary_async_io.hpp
+ * @author Shareef Abdoul-Raheem (https://blufedora.github.io/)
+ * @date   2024-11-06
+ * @brief
+ *   Asynchronous positional file reads with a submit / poll interface
+ *   and a read ahead `IOStream` built on top of them.
+ *
+ * @copyright Copyright (c) 2024 Shareef Abdoul-Raheem
+ */
+/******************************************************************************/
+#ifndef BINARY_ASYNC_IO_HPP
+#define BINARY_ASYNC_IO_HPP
+
+#include "binary_stream.hpp"
+
+namespace binaryIO
+{
+  struct AsyncRead;
+
+  using AsyncReadCompleteFn = void (*)(AsyncRead* const request);
+
+  /*!
+   * @brief
+   *   A read of `num_bytes` at an absolute file `offset` into `destination`.
+   *
+   *   Owned by the caller, the request and its destination must stay alive until it completes.
+   */
+  struct AsyncRead
+  {
+    void*               destination = nullptr;
+    IOSize              offset      = 0u;
+    IOSize              num_bytes   = 0u;
+    AsyncReadCompleteFn on_complete = nullptr;  //!< Optional, called from `AsyncFile_Poll` on the polling thread.
+    void*               user_data   = nullptr;  //!< Not used by the library.
+
+    /* Written by the Implementation */
+
+    IOResult   result      = IOErrorCode::Success;  //!< Value is the number of bytes read, `IOErrorCode::EndOfStream` on a short read.
+    bool       is_complete = false;                 //!< Set by `AsyncFile_Poll` right before `on_complete` is called.
+    AsyncRead* next        = nullptr;               //!< Intrusive queue link.
+  };
+
+  /*!
+   * @brief
+   *   A read only file that services `AsyncRead`s on background workers.
+   *
+   *   Submission and completion are separate queues so that the caller decides
+   *   on which thread and when completion callbacks run, the same model as io_uring and IOCP.
+   */
+  struct AsyncFile
+  {
+    void* impl = nullptr;
+  };
+
+  IOErrorCode AsyncFile_Open(AsyncFile* const out_file, const char* const path, const IOSize num_workers = 1u);
+  IOResult    AsyncFile_Size(const AsyncFile* const file);
+  IOErrorCode AsyncFile_Submit(AsyncFile* const file, AsyncRead* const request);
+
+  /*!
+   * @brief
+   *   Runs the completion of every finished request.
+   *
+   * @param wait_for_one
+   *   Blocks until at least one request completes, unless nothing is in flight.
+   *
+   * @return
+   *   The number of requests completed by this call.
+   */
+  IOSize AsyncFile_Poll(AsyncFile* const file, const bool wait_for_one);
+
+  /*!
+   * @brief
+   *   Polls until `request` completes, completions of other requests may run while waiting.
+   */
+  IOErrorCode AsyncFile_Wait(AsyncFile* const file, AsyncRead* const request);
+
+  /*!
+   * @brief
+   *   Waits for every in flight request then releases the file, completions that were not polled are not called.
+   */
+  void AsyncFile_Close(AsyncFile* const file);
+
+  /*!
+   * @brief
+   *   Sequential read stream that double buffers, the next block is read in the background while the
+   *   current one is consumed through the `BufferedIO` window.
+   *
+   *   The start of `scratch` holds the stream's state and the rest is split into two blocks,
+   *   both `file` and `scratch` must outlive the returned stream.
+   *   Closing the returned stream waits for the prefetch but does not close `file`.
+   */
+  IOStream IOStream_FromAsyncFile(AsyncFile* const file, void* const scratch, const IOSize scratch_size);
+
+}  // namespace binaryIO
+
+#endif /* BINARY_ASYNC_IO_HPP */
+
+/******************************************************************************/
+/*
+  MIT License
+
+  Copyright (c) 2024 Shareef Abdoul-Raheem
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+/******************************************************************************/
@@ -0,0 +1,239 @@
+/******************************************************************************/
+/*!
+ * @file   binary_bit_stream.hpp
+ * @author Shareef Abdoul-Raheem (https://blufedora.github.io/)
+ * @date   2024-11-07
+ * @brief
+ *   Bit level packing of arbitrary width fields on top of an `IOStream`.
+ *
+ *   Fields are packed least significant bit first into a 64 bit accumulator
+ *   that is written as little endian words, so the encoded bytes do not
+ *   depend on the host byte order.
+ *
+ *   References:
+ *     [Reading bits in far too many ways](https://fgiesen.wordpress.com/2018/02/19/reading-bits-in-far-too-many-ways-part-1/)
+ *
+ * @copyright Copyright (c) 2024 Shareef Abdoul-Raheem
+ */
+/******************************************************************************/
+#ifndef BINARY_BIT_STREAM_HPP
+#define BINARY_BIT_STREAM_HPP
+
+#include "binary_stream.hpp"  // IOStream, writeLE
+
+namespace binaryIO
+{
+  namespace detail
+  {
+    // Mask of the low `num_bits` bits, `num_bits` must be in [1, 64].
+    constexpr std::uint64_t lowBitsMask(const unsigned num_bits) noexcept
+    {
+      return ~std::uint64_t(0u) >> (64u - num_bits);
+    }
+
+    // Maps `value` clamped to [min_value, max_value] onto [0, 2^num_bits - 1], NaN maps to `min_value`.
+    inline std::uint64_t quantizeFloat(const float value, const float min_value, const float max_value, const unsigned num_bits) noexcept
+    {
+      const double max_quantized = double(lowBitsMask(num_bits));
+      const double clamped       = !(value > min_value) ? min_value : value < max_value ? value : max_value;
+
+      return std::uint64_t((clamped - min_value) / (double(max_value) - min_value) * max_quantized + 0.5);
+    }
+
+    inline float dequantizeFloat(const std::uint64_t quantized, const float min_value, const float max_value, const unsigned num_bits) noexcept
+    {
+      return float(min_value + double(quantized) * ((double(max_value) - min_value) / double(lowBitsMask(num_bits))));
+    }
+  }  // namespace detail
+
+  /*!
+   * @brief
+   *   Packs fields of 1 to 64 bits, whole 64 bit words are written to the stream
+   *   through `writeLE` so a `BufferedWriteIO` window is used when the stream has one.
+   *
+   *   `flush` must be called once done, it pads the last partial byte with zeros.
+   *   Errors are sticky in `error_state` so that a whole packet can be written before checking.
+   */
+  struct BitWriter
+  {
+    IOStream*     stream      = nullptr;
+    std::uint64_t bits        = 0u;  //!< Pending bits, the oldest in the least significant bit.
+    unsigned      num_bits    = 0u;  //!< Invariant: num_bits < 64.
+    IOErrorCode   error_state = IOErrorCode::Success;
+
+    explicit BitWriter(IOStream* const stream) :
+      stream{stream}
+    {
+    }
+
+    void writeBits(const std::uint64_t value, const unsigned num_value_bits) noexcept
+    {
+      const std::uint64_t field      = value & detail::lowBitsMask(num_value_bits);
+      const unsigned      total_bits = num_bits + num_value_bits;
+
+      bits |= field << num_bits;
+
+      if (total_bits < 64u)
+      {
+        num_bits = total_bits;
+        return;
+      }
+
+      writeWord(bits);
+
+      // The bits of `field` that did not fit, split into two shifts since `num_bits` may be 0.
+      bits     = (field >> 1u) >> (63u - num_bits);
+      num_bits = total_bits - 64u;
+    }
+
+    void writeBool(const bool value) noexcept
+    {
+      writeBits(value ? 1u : 0u, 1u);
+    }
+
+    /*!
+     * @brief
+     *   Writes `value` quantized to `num_value_bits` (1 to 32) bits over the range [min_value, max_value],
+     *   values outside of the range are clamped.
+     */
+    void writeQuantizedFloat(const float value, const float min_value, const float max_value, const unsigned num_value_bits) noexcept
+    {
+      writeBits(detail::quantizeFloat(value, min_value, max_value, num_value_bits), num_value_bits);
+    }
+
+    /*!
+     * @brief
+     *   Pads to a byte boundary with zeros and writes the pending bytes,
+     *   afterwards the stream's position is right after the last field.
+     *
+     * @return
+     *   The first error encountered by this writer.
+     */
+    IOErrorCode flush();
+
+    void writeWord(const std::uint64_t word) noexcept
+    {
+      const IOErrorCode result = writeLE(stream, word).ErrorCode();
+
+      if (error_state == IOErrorCode::Success)
+      {
+        error_state = result;
+      }
+    }
+  };
+
+  /*!
+   * @brief
+   *   Reads fields written by `BitWriter`.
+   *
+   *   While at least 8 bytes are left in the stream's `BufferedIO` window the accumulator is
+   *   refilled with a single unaligned load, otherwise only the bytes needed are read through `IOStream_Read`.
+   *
+   *   Reading past the end of the stream returns zero bits and sets `error_state` to `IOErrorCode::EndOfStream`.
+   *   The stream must not be used directly until `finish` has been called.
+   */
+  struct BitReader
+  {
+    IOStream*     stream      = nullptr;
+    std::uint64_t bits        = 0u;  //!< Bits that have been consumed from the stream but not yet read, next bit in the least significant bit.
+    unsigned      num_bits    = 0u;  //!< Number of valid bits in `bits`.
+    IOErrorCode   error_state = IOErrorCode::Success;
+
+    explicit BitReader(IOStream* const stream) :
+      stream{stream}
+    {
+    }
+
+    std::uint64_t readBits(const unsigned num_value_bits) noexcept
+    {
+      // A refill guarantees 56 bits, wider fields are read in two halves.
+      if (num_value_bits > 56u)
+      {
+        const std::uint64_t low_bits = readBits(32u);
+
+        return low_bits | (readBits(num_value_bits - 32u) << 32u);
+      }
+
+      if (num_bits < num_value_bits)
+      {
+        refill(num_value_bits);
+      }
+
+      const std::uint64_t value = bits & detail::lowBitsMask(num_value_bits);
+
+      bits >>= num_value_bits;
+      num_bits -= num_value_bits;
+
+      return value;
+    }
+
+    bool readBool() noexcept
+    {
+      return readBits(1u) != 0u;
+    }
+
+    float readQuantizedFloat(const float min_value, const float max_value, const unsigned num_value_bits) noexcept
+    {
+      return detail::dequantizeFloat(readBits(num_value_bits), min_value, max_value, num_value_bits);
+    }
+
+    /*!
+     * @brief
+     *   Skips the rest of the current byte, matching the padding written by `BitWriter::flush`,
+     *   and hands the bytes that were consumed but not read back to the stream.
+     *
+     * @return
+     *   The first error encountered by this reader.
+     */
+    IOErrorCode finish();
+
+    void refill(const unsigned num_needed_bits) noexcept
+    {
+      BufferedIO* const buffered_io = &stream->buffered_io;
+
+      // Fast path: take as many whole bytes as fit in the accumulator from a single load.
+      if (detail::readWindowSize(stream) >= sizeof(std::uint64_t))
+      {
+        const std::uint64_t word = detail::decodeXEndian<std::uint64_t>(buffered_io->cursor, [](const std::size_t i) { return i; });
+
+        bits |= word << num_bits;
+        buffered_io->cursor += (63u - num_bits) >> 3u;
+        num_bits |= 56u;
+        return;
+      }
+
+      refillSlow(num_needed_bits);
+    }
+
+    void refillSlow(const unsigned num_needed_bits) noexcept;
+  };
+
+}  // namespace binaryIO
+
+#endif /* BINARY_BIT_STREAM_HPP */
+
+/******************************************************************************/
+/*
+  MIT License
+
+  Copyright (c) 2024 Shareef Abdoul-Raheem
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+/******************************************************************************/
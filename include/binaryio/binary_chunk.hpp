@@ -62,8 +62,27 @@ inline constexpr std::uint32_t k_Crc32Table[256] =
 };
 // clang-format on
 
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define BINARY_IO_HAS_IS_CONSTANT_EVALUATED 1
+#endif
+#elif defined(_MSC_VER) && _MSC_VER >= 1925
+#define BINARY_IO_HAS_IS_CONSTANT_EVALUATED 1
+#endif
+
 // crc-32b
 
+//
+// Same result as `crc32_addBytes` but uses slicing-by-8 tables
+// or the CPU's carry-less multiply / crc instructions when available.
+//
+void crc32_addBytesRuntime(std::uint32_t* in_out_crc, const void* bytes, std::size_t num_bytes);
+
+//
+// Given the finished crcs of two byte sequences A and B returns the finished crc of A followed by B.
+//
+std::uint32_t crc32_combine(std::uint32_t crc_a, std::uint32_t crc_b, std::uint64_t num_bytes_b);
+
 inline constexpr std::uint32_t crc32_begin()
 {
   return 0xFFFFFFFF;
@@ -71,6 +90,14 @@ inline constexpr std::uint32_t crc32_begin()
 
 inline constexpr void crc32_addBytes(std::uint32_t* in_out_crc, const void* bytes, std::size_t num_bytes)
 {
+#if BINARY_IO_HAS_IS_CONSTANT_EVALUATED
+  if (!__builtin_is_constant_evaluated())
+  {
+    crc32_addBytesRuntime(in_out_crc, bytes, num_bytes);
+    return;
+  }
+#endif
+
   std::uint32_t crc = *in_out_crc;
 
   for (std::size_t i = 0; i < num_bytes; ++i)
@@ -217,6 +244,76 @@ namespace binaryIO
     }
   };
 
+  // Table of Contents
+  //
+  // Optional index placed at the end of a chunk file for direct lookup of chunks by type.
+  //
+  // ...chunks...
+  // toc_chunk     : Chunk with type `k_ChunkTOCTypeID`, data is `BinaryChunkTOCEntry[]` sorted by (type_id, offset).
+  // trailer_chunk : Chunk with type `k_ChunkTOCTrailerTypeID`, data is a `BinaryChunkTOCTrailer`.
+  //
+  // Both are regular chunks so the file is still a valid chain of chunks,
+  // the trailer has a fixed size of `k_ChunkTOCTrailerChunkSize` so it can be found from the end of the file.
+  //
+
+  inline constexpr BinaryChunkTypeID k_ChunkTOCTypeID        = BinaryChunkTypeID("BTOC");
+  inline constexpr BinaryChunkTypeID k_ChunkTOCTrailerTypeID = BinaryChunkTypeID("BTRL");
+  inline constexpr VersionType       k_ChunkTOCVersion       = 1u;
+
+  struct BinaryChunkTOCEntry
+  {
+    BinaryChunkTypeID type_id;         //!< The indexed chunk's type.
+    VersionType       version;         //!< The indexed chunk's version.
+    std::uint16_t     reserved0;       //!< Must be zero.
+    std::uint32_t     crc32_checksum;  //!< Copy of the indexed chunk's footer checksum.
+    std::uint32_t     reserved1;       //!< Must be zero.
+    std::uint64_t     offset;          //!< Offset in bytes from the start of the file to the chunk's header.
+    std::uint64_t     size;            //!< Total size of the chunk including header and footer.
+  };
+  static_assert(sizeof(BinaryChunkTOCEntry) == 32u, "");
+
+  struct BinaryChunkTOCTrailer
+  {
+    std::uint64_t toc_offset;  //!< Offset in bytes from the start of the file to the toc chunk's header.
+  };
+  static_assert(sizeof(BinaryChunkTOCTrailer) == sizeof(std::uint64_t), "");
+
+  inline constexpr std::uint64_t k_ChunkTOCTrailerChunkSize = sizeof(BinaryChunkHeader) + sizeof(BinaryChunkTOCTrailer) + sizeof(BinaryChunkFooter);
+
+  // Compressed Chunks
+  //
+  // A chunk whose data is a compressed stream (see binary_compression.hpp) starts its additional
+  // header data with a `BinaryChunkCompressionInfo`, any other additional header data follows it.
+  //
+  // Seekable compressed chunks place a `BinaryChunkBlockIndexInfo` right after the compression info
+  // and store a block offset table after the last block:
+  //
+  // data : block[num_blocks], std::uint64_t[num_blocks + 1] (little endian offsets of each block from the start of the data, the last is the end of the blocks)
+  //
+  // Every block but the last decompresses to exactly `block_size` bytes so the block
+  // covering any uncompressed offset is found with a single division.
+  //
+
+  inline constexpr BinaryChunkTypeID k_ChunkCompressionTag = BinaryChunkTypeID("BCMP");
+  inline constexpr BinaryChunkTypeID k_ChunkBlockIndexTag  = BinaryChunkTypeID("BBLK");
+
+  struct BinaryChunkCompressionInfo
+  {
+    BinaryChunkTypeID tag;                //!< Always `k_ChunkCompressionTag`.
+    std::uint32_t     codec;              //!< A `CompressionCodec`.
+    std::uint64_t     uncompressed_size;  //!< Size in bytes of the chunk's data once decompressed.
+  };
+  static_assert(sizeof(BinaryChunkCompressionInfo) == 16u, "");
+
+  struct BinaryChunkBlockIndexInfo
+  {
+    BinaryChunkTypeID tag;           //!< Always `k_ChunkBlockIndexTag`.
+    std::uint32_t     block_size;    //!< Uncompressed size in bytes of every block but the last.
+    std::uint64_t     num_blocks;    //!< Number of blocks.
+    std::uint64_t     table_offset;  //!< Offset in bytes from the start of the chunk's data to the block offset table.
+  };
+  static_assert(sizeof(BinaryChunkBlockIndexInfo) == 24u, "");
+
   namespace ChunkUtils
   {
     template<typename SubClass>
@@ -226,10 +323,24 @@ namespace binaryIO
     }
   }  // namespace ChunkUtils
 
+  /*!
+   * @brief
+   *   Walks every chunk in an in-memory file checking that each footer's crc matches its data,
+   *   large chunks are split into sub-ranges so that a single chunk can use multiple workers.
+   *
+   * @return
+   *   Value is the number of leading chunks that were valid,
+   *   error is `IOErrorCode::InvalidData` on a checksum mismatch or malformed header chain.
+   */
+  IOResult VerifyChunks(const void* const file_bytes, const IOSize size, Executor& executor);
+
 #if __cplusplus >= 201703L
   static_assert(std::has_unique_object_representations_v<BinaryChunkTypeID>, "Chunk Header ID should not have any padding.");
   static_assert(std::has_unique_object_representations_v<BinaryChunkHeader>, "Chunk Header should not have any padding.");
   static_assert(std::has_unique_object_representations_v<BinaryChunkFooter>, "Chunk Footer should not have any padding.");
+  static_assert(std::has_unique_object_representations_v<BinaryChunkTOCEntry>, "Chunk TOC Entry should not have any padding.");
+  static_assert(std::has_unique_object_representations_v<BinaryChunkCompressionInfo>, "Chunk Compression Info should not have any padding.");
+  static_assert(std::has_unique_object_representations_v<BinaryChunkBlockIndexInfo>, "Chunk Block Index Info should not have any padding.");
 #endif
 }  // namespace assetio
 
@@ -0,0 +1,249 @@
+/******************************************************************************/
+/*!
+ * @file   binary_chunk_io.hpp
+ * @author Shareef Abdoul-Raheem (https://blufedora.github.io/)
+ * @date   2024-11-04
+ * @brief
+ *   Helpers for reading and writing the chunk based binary file format through an `IOStream`.
+ *
+ * @copyright Copyright (c) 2024 Shareef Abdoul-Raheem
+ */
+/******************************************************************************/
+#ifndef BINARY_CHUNK_IO_HPP
+#define BINARY_CHUNK_IO_HPP
+
+#include "binary_chunk.hpp"        // BinaryChunkHeader, BinaryChunkTOCEntry
+#include "binary_compression.hpp"  // IOCodec, k_CompressionDefaultBlockSize
+#include "binary_stream.hpp"       // IOStream
+
+#include <vector>  // vector<T>
+
+namespace binaryIO
+{
+  /*!
+   * @brief
+   *   Collects the location of each chunk written to a file so that a table of contents can be appended.
+   */
+  struct ChunkTOCWriter
+  {
+    std::vector<BinaryChunkTOCEntry> entries = {};
+
+    void addChunk(const BinaryChunkHeader& header, const IOSize offset, const std::uint32_t crc32_checksum);
+
+    /*!
+     * @brief
+     *   Writes the toc chunk followed by the trailer chunk at the current position of the stream,
+     *   this should be the last thing written to the file.
+     *
+     * @return
+     *   Value is the offset of the toc chunk.
+     */
+    IOResult write(IOStream* const stream);
+  };
+
+  /*!
+   * @brief
+   *   Writes a single chunk without knowing the data size up front.
+   *
+   *   For seekable streams a placeholder header is written by `begin`, the data is streamed
+   *   straight through while being checksummed and `end` seeks back to patch in the data size.
+   *   Non seekable streams fall back to holding up to `max_buffered_bytes` of data in memory
+   *   until `end` is called, exceeding that limit is an `IOErrorCode::AllocationFailure`.
+   *
+   *   Chunks started with `beginCompressed` pass the data through a compressing stream and
+   *   record a `BinaryChunkCompressionInfo` in front of the additional header,
+   *   `beginCompressedSeekable` also records a block offset table for random access.
+   *
+   *   The writer must not be copied or moved between `begin` and `end`.
+   */
+  struct ChunkWriter
+  {
+    static constexpr IOSize k_DefaultMaxBufferedBytes = 16u << 20;
+
+    IOStream                   payload            = {};  //!< Stream interface for the chunk's data, usable with all the stream helpers.
+    IOStream                   compressed_data    = {};  //!< Where the compressing `payload` writes to, only used by compressed chunks.
+    IOStream*                  stream             = nullptr;
+    BinaryChunkHeader          header             = BinaryChunkHeader();
+    BinaryChunkCompressionInfo compression        = {};  //!< Only valid for compressed chunks.
+    BinaryChunkBlockIndexInfo  block_index        = {};  //!< Only valid for seekable compressed chunks.
+    IOSize                     header_offset      = 0u;  //!< Only valid for seekable streams.
+    std::uint32_t              crc                = 0u;
+    bool                       is_seekable        = false;
+    bool                       is_compressed      = false;
+    bool                       has_block_index    = false;
+    IOErrorCode                block_error        = IOErrorCode::Success;  //!< Set when a block other than the last is short.
+    IOErrorCode                data_error         = IOErrorCode::Success;  //!< First error writing the chunk's data, reported again by `end`.
+    IOSize                     max_buffered_bytes = 0u;
+    std::vector<std::uint8_t>  buffered_bytes     = {};  //!< Additional header bytes followed by data for non seekable streams.
+    std::vector<std::uint64_t> block_offsets      = {};  //!< Offset of each block from the start of the data, only used by seekable compressed chunks.
+
+    ChunkWriter()                              = default;
+    ChunkWriter(const ChunkWriter&)            = delete;
+    ChunkWriter& operator=(const ChunkWriter&) = delete;
+
+    IOErrorCode begin(IOStream* const          stream,
+                      const BinaryChunkTypeID& type_id,
+                      const VersionType        version,
+                      const void* const        additional_header      = nullptr,
+                      const std::uint16_t      additional_header_size = 0u,
+                      const IOSize             max_buffered_bytes     = k_DefaultMaxBufferedBytes);
+
+    /*!
+     * @brief
+     *   Same as `begin` but everything written is compressed with `codec`, the checksum and `data_size` cover the compressed bytes.
+     *   Read the chunk back with `IOStream_FromCompressedChunk`.
+     *   Passing an `executor` compresses through `IOStream_FromParallelCompressor`, the chunk is identical either way.
+     */
+    IOErrorCode beginCompressed(IOStream* const          stream,
+                                const BinaryChunkTypeID& type_id,
+                                const VersionType        version,
+                                const IOCodec&           codec,
+                                const IOAllocator&       allocator,
+                                const IOSize             block_size             = k_CompressionDefaultBlockSize,
+                                const void* const        additional_header      = nullptr,
+                                const std::uint16_t      additional_header_size = 0u,
+                                const IOSize             max_buffered_bytes     = k_DefaultMaxBufferedBytes,
+                                Executor* const          executor               = nullptr);
+
+    /*!
+     * @brief
+     *   Same as `beginCompressed` but also writes a block offset table so `IOStream_FromCompressedChunk` can seek.
+     *   Every block but the last must be full so `payload` must not be flushed with `BufferedWrite_Flush`,
+     *   doing so is reported by `end` as `IOErrorCode::InvalidOperation`.
+     */
+    IOErrorCode beginCompressedSeekable(IOStream* const          stream,
+                                        const BinaryChunkTypeID& type_id,
+                                        const VersionType        version,
+                                        const IOCodec&           codec,
+                                        const IOAllocator&       allocator,
+                                        const IOSize             block_size             = k_CompressionDefaultBlockSize,
+                                        const void* const        additional_header      = nullptr,
+                                        const std::uint16_t      additional_header_size = 0u,
+                                        const IOSize             max_buffered_bytes     = k_DefaultMaxBufferedBytes,
+                                        Executor* const          executor               = nullptr);
+
+    IOResult write(const void* const bytes, const IOSize num_bytes);
+
+    /*!
+     * @brief
+     *   Finalizes the header and writes the footer, optionally recording the chunk in `toc`.
+     *   Recording into a toc requires a seekable stream, on a non seekable stream the chunk
+     *   is still written and `IOErrorCode::InvalidOperation` reports the skipped toc entry.
+     *
+     * @return
+     *   Value is the total size of the chunk.
+     */
+    IOResult end(ChunkTOCWriter* const toc = nullptr);
+  };
+
+  /*!
+   * @brief
+   *   A chunk returned from `ChunkReader::next`.
+   *
+   *   Points either directly into the stream's `BufferedIO` window or into the reader's copy buffer,
+   *   in both cases the memory is only valid until the next call to `ChunkReader::next`.
+   */
+  struct ChunkView
+  {
+    const BinaryChunkHeader* header  = nullptr;  //!< Followed by `header->header_size - sizeof(BinaryChunkHeader)` additional header bytes.
+    const std::uint8_t*      data    = nullptr;  //!< `header->data_size` bytes of chunk data.
+    BinaryChunkFooter        footer  = {};       //!< Copied out since the footer is not guaranteed to be aligned.
+    bool                     is_copy = false;    //!< True if the chunk did not fit in the window and had to be copied.
+
+    const std::uint8_t* additionalHeader() const { return reinterpret_cast<const std::uint8_t*>(header) + sizeof(BinaryChunkHeader); }
+    bool                verifyChecksum() const;
+
+    /*!
+     * @brief
+     *   Copies out the compression info of a chunk written with `ChunkWriter::beginCompressed`.
+     *
+     * @return
+     *   false if the chunk's data is not compressed.
+     */
+    bool compressionInfo(BinaryChunkCompressionInfo* const out_info) const;
+  };
+
+  /*!
+   * @brief
+   *   Iterates the chunks of a stream, avoiding copies whenever the whole chunk
+   *   is available in the stream's `BufferedIO` window (memory, vector or mapped file streams).
+   */
+  struct ChunkReader
+  {
+    IOStream*                 stream      = nullptr;
+    std::vector<std::uint8_t> copy_buffer = {};  //!< Holds chunks that straddled the window boundary.
+
+    explicit ChunkReader(IOStream* const stream) :
+      stream{stream}
+    {
+    }
+
+    /*!
+     * @return
+     *   `IOErrorCode::EndOfStream` once there are no more chunks,
+     *   `IOErrorCode::InvalidData` for truncated or malformed chunks.
+     */
+    IOErrorCode next(ChunkView* const out_chunk);
+  };
+
+  /*!
+   * @brief
+   *   Table of contents loaded from the end of a chunk file.
+   */
+  struct ChunkTOC
+  {
+    std::vector<BinaryChunkTOCEntry> entries = {};  //!< Sorted by (type_id, offset).
+
+    /*!
+     * @brief
+     *   Loads the table of contents using the trailer chunk at the end of the stream.
+     *   The stream must support seeking, its position is left unspecified.
+     *
+     * @return
+     *   `IOErrorCode::InvalidData` if the file does not end with a valid table of contents.
+     */
+    IOErrorCode load(IOStream* const stream);
+
+    /*!
+     * @return
+     *   The first chunk with the matching type or nullptr if there is none,
+     *   chunks of the same type are adjacent so the following entries may also match.
+     */
+    const BinaryChunkTOCEntry* find(const BinaryChunkTypeID& type_id) const;
+
+    /*!
+     * @brief
+     *   Seeks the stream to the header of the chunk referenced by `entry`.
+     */
+    static IOResult seekToChunk(IOStream* const stream, const BinaryChunkTOCEntry& entry);
+  };
+
+}  // namespace binaryIO
+
+#endif /* BINARY_CHUNK_IO_HPP */
+
+/******************************************************************************/
+/*
+  MIT License
+
+  Copyright (c) 2024 Shareef Abdoul-Raheem
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+/******************************************************************************/
@@ -0,0 +1,126 @@
+/******************************************************************************/
+/*!
+ * @file   binary_chunk_patch.hpp
+ * @author Shareef Abdoul-Raheem (https://blufedora.github.io/)
+ * @date   2024-11-13
+ * @brief
+ *   Binary patches between two versions of a chunk file so that hot reloading or
+ *   downloading an update costs the changed bytes rather than the whole file.
+ *
+ *   Chunks are matched by type and the order they appear in within that type, a chunk whose
+ *   version, size and checksum are unchanged is copied without reading it. Changed chunks are
+ *   delta encoded against their previous version with a rolling hash.
+ *
+ *   References:
+ *     [The rsync algorithm](https://rsync.samba.org/tech_report/)
+ *
+ * @copyright Copyright (c) 2024 Shareef Abdoul-Raheem
+ */
+/******************************************************************************/
+#ifndef BINARY_CHUNK_PATCH_HPP
+#define BINARY_CHUNK_PATCH_HPP
+
+#include "binary_chunk.hpp"     // BinaryChunkTypeID, BinaryChunkTOCEntry
+#include "binary_chunk_io.hpp"  // ChunkTOC, ChunkTOCWriter, ChunkView
+#include "binary_stream.hpp"    // IOStream
+
+#include <cstdint>  // uint8_t, uint32_t, uint64_t
+
+namespace binaryIO
+{
+  // Patch Chunk
+  //
+  // A patch is a single chunk whose additional header is a `BinaryChunkPatchInfo`.
+  //
+  // data : op[], each op is:
+  //   std::uint8_t kind, var uint destination offset, var uint size,
+  //   then for `Copy` a var uint source offset and for `Data` `size` literal bytes.
+  //
+  // Ops are applied in order, `Rebuild` patches write every byte of the target exactly once front to back
+  // while `InPlace` patches only contain `Data` ops for the byte ranges that changed.
+  //
+
+  inline constexpr BinaryChunkTypeID k_ChunkPatchTypeID  = BinaryChunkTypeID("BPCH");
+  inline constexpr VersionType       k_ChunkPatchVersion = 1u;
+
+  enum class ChunkPatchMode : std::uint32_t
+  {
+    Rebuild,  //!< The target is built into a new stream from copies of the source and literal data, the smallest patches.
+    InPlace,  //!< Only overwrites the changed byte ranges so the patch can be applied to the source itself, cheapest when chunk sizes are unchanged.
+  };
+
+  enum class ChunkPatchOp : std::uint8_t
+  {
+    Copy,  //!< Copies `size` bytes from the source.
+    Data,  //!< Writes `size` literal bytes stored in the patch.
+  };
+
+  struct BinaryChunkPatchInfo
+  {
+    std::uint64_t  source_size;       //!< Size in bytes of the file the patch applies to.
+    std::uint64_t  target_size;       //!< Size in bytes of the file after the patch.
+    std::uint32_t  source_toc_crc32;  //!< Checksum of the source's table of contents entries, identifies the exact source file.
+    ChunkPatchMode mode;
+  };
+  static_assert(sizeof(BinaryChunkPatchInfo) == 24u, "");
+
+  /*!
+   * @brief
+   *   Writes a patch turning `source` into `target`, both must be seekable chunk files ending with a table of contents.
+   *   Bytes outside of the toc listed chunks, such as the toc itself, are diffed in place or stored literally.
+   *
+   * @return
+   *   Value is the total size of the patch chunk.
+   */
+  IOResult ChunkPatch_Create(IOStream* const       source,
+                             IOStream* const       target,
+                             IOStream* const       patch,
+                             const ChunkPatchMode  mode = ChunkPatchMode::Rebuild,
+                             ChunkTOCWriter* const toc  = nullptr);
+
+  /*!
+   * @brief
+   *   Applies a patch chunk read by `ChunkReader`, `destination` must be `source` for `ChunkPatchMode::InPlace` patches
+   *   and a different stream for `ChunkPatchMode::Rebuild` patches.
+   *   The checksum of the patch and the identity of `source` are verified before anything is written.
+   *
+   *   Applying in place is detected by pointer equality only, a `Rebuild` patch applied through two streams
+   *   over the same file reads its source while overwriting it and corrupts the file.
+   *
+   *   Patching in place cannot shrink a file, truncate it to the returned size when it is smaller than before.
+   *
+   * @return
+   *   Value is the size of the patched file, `IOErrorCode::InvalidData` if the patch is corrupt or for a different source
+   *   and `IOErrorCode::InvalidOperation` when a `Rebuild` patch is applied in place or an `InPlace` patch is not.
+   */
+  IOResult ChunkPatch_Apply(IOStream* const source, const ChunkView& patch, IOStream* const destination);
+
+}  // namespace binaryIO
+
+#endif /* BINARY_CHUNK_PATCH_HPP */
+
+/******************************************************************************/
+/*
+  MIT License
+
+  Copyright (c) 2024 Shareef Abdoul-Raheem
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+/******************************************************************************/
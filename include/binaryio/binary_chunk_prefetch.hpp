@@ -0,0 +1,182 @@
+/******************************************************************************/
+/*!
+ * @file   binary_chunk_prefetch.hpp
+ * @author Shareef Abdoul-Raheem (https://blufedora.github.io/)
+ * @date   2024-11-12
+ * @brief
+ *   Readahead for chunk files driven by a recording of which chunks a load touched.
+ *
+ *   A load is recorded once with `ChunkAccessTrace`, offline tooling turns the trace into a
+ *   `ChunkPrefetchPlan` (stored as a chunk next to the data) or rewrites the file with
+ *   `ChunkFile_Reorder` so the load reads it front to back. At runtime `ChunkPrefetcher`
+ *   walks the plan a fixed number of bytes ahead of the load, hinting the OS to read in
+ *   upcoming chunks through `IOStream_AdviseWillNeed`.
+ *
+ * @copyright Copyright (c) 2024 Shareef Abdoul-Raheem
+ */
+/******************************************************************************/
+#ifndef BINARY_CHUNK_PREFETCH_HPP
+#define BINARY_CHUNK_PREFETCH_HPP
+
+#include "binary_chunk.hpp"     // BinaryChunkTOCEntry, BinaryChunkTypeID
+#include "binary_chunk_io.hpp"  // ChunkTOC, ChunkTOCWriter, ChunkView
+#include "binary_stream.hpp"    // IOStream
+
+#include <cstddef>  // size_t, max_align_t
+#include <vector>   // vector<T>
+
+namespace binaryIO
+{
+  // Prefetch Plan Chunk
+  //
+  // data : ChunkPrefetchRange[data_size / 16] (little endian offset and size pairs)
+  //
+  // Padding Chunk
+  //
+  // Written by `ChunkFile_Reorder` in front of a moved chunk to keep its offset modulo `k_ChunkReorderAlignment`,
+  // the data is all zeros and the chunk is not listed in the table of contents.
+  //
+
+  inline constexpr BinaryChunkTypeID k_ChunkPrefetchPlanTypeID  = BinaryChunkTypeID("BPFP");
+  inline constexpr VersionType       k_ChunkPrefetchPlanVersion = 1u;
+  inline constexpr BinaryChunkTypeID k_ChunkPaddingTypeID       = BinaryChunkTypeID("BPAD");
+  inline constexpr VersionType       k_ChunkPaddingVersion      = 1u;
+
+  //! `RelBuilder` aligns chunk data to at most this within the file, moving a chunk keeps its offset modulo this.
+  inline constexpr IOSize k_ChunkReorderAlignment = alignof(std::max_align_t);
+
+  /*!
+   * @brief
+   *   Records the chunks a load visits, in order.
+   */
+  struct ChunkAccessTrace
+  {
+    std::vector<BinaryChunkTOCEntry> accesses = {};  //!< A chunk visited more than once is recorded each time.
+
+    void record(const BinaryChunkTOCEntry& entry) { accesses.push_back(entry); }
+
+    //! `ChunkTOC::seekToChunk` that also records the access.
+    IOResult seekToChunk(IOStream* const stream, const BinaryChunkTOCEntry& entry);
+  };
+
+  struct ChunkPrefetchRange
+  {
+    std::uint64_t offset;  //!< Offset in bytes from the start of the file.
+    std::uint64_t size;    //!< Number of bytes to read ahead.
+  };
+
+  /*!
+   * @brief
+   *   The byte ranges a load is expected to read, in the order it will read them.
+   */
+  struct ChunkPrefetchPlan
+  {
+    std::vector<ChunkPrefetchRange> ranges = {};
+
+    /*!
+     * @brief
+     *   One range per chunk in the order of its first access, revisits are dropped.
+     *   A chunk starting at most `max_gap_bytes` after the end of the previous range
+     *   extends that range so sequential runs become a single larger readahead.
+     */
+    void build(const ChunkAccessTrace& trace, const IOSize max_gap_bytes = 0u);
+
+    IOSize totalBytes() const;
+
+    //! Writes the plan as a `k_ChunkPrefetchPlanTypeID` chunk.
+    IOResult write(IOStream* const stream, ChunkTOCWriter* const toc = nullptr) const;
+
+    /*!
+     * @return
+     *   `IOErrorCode::InvalidData` if `chunk` is not a prefetch plan chunk.
+     */
+    IOErrorCode load(const ChunkView& chunk);
+  };
+
+  /*!
+   * @brief
+   *   Issues readahead hints for the ranges of a plan as a load advances through it,
+   *   keeping up to `lookahead_bytes` hinted ahead of the chunk being read.
+   *
+   *   Accesses that are not in the plan are ignored so a load that diverges from
+   *   the recording only loses the benefit of the hints.
+   *   The plan's ranges can just as well be submitted to an `AsyncFile` for streams with no readahead hint.
+   */
+  struct ChunkPrefetcher
+  {
+    static constexpr IOSize k_DefaultLookaheadBytes = 4u << 20;
+
+    IOStream*                stream          = nullptr;
+    const ChunkPrefetchPlan* plan            = nullptr;
+    IOSize                   lookahead_bytes = k_DefaultLookaheadBytes;
+    std::size_t              current_range   = 0u;  //!< The range the load is reading.
+    std::size_t              next_range      = 0u;  //!< The first range that has not been hinted yet.
+    IOSize                   hinted_bytes    = 0u;  //!< Size of the ranges in [current_range, next_range).
+
+    ChunkPrefetcher(IOStream* const stream, const ChunkPrefetchPlan& plan, const IOSize lookahead_bytes = k_DefaultLookaheadBytes) :
+      stream{stream},
+      plan{&plan},
+      lookahead_bytes{lookahead_bytes}
+    {
+    }
+
+    /*!
+     * @brief
+     *   Tells the prefetcher the load is about to read at `offset`, call before or as each chunk is read.
+     *
+     * @return
+     *   The first error from `IOStream_AdviseWillNeed`, `IOErrorCode::InvalidOperation` means the stream has no readahead mechanism.
+     */
+    IOErrorCode advance(const std::uint64_t offset);
+
+    //! `advance` followed by `ChunkTOC::seekToChunk`.
+    IOResult seekToChunk(const BinaryChunkTOCEntry& entry);
+  };
+
+  /*!
+   * @brief
+   *   Copies every chunk listed in `toc` to `destination` in first access order, followed by the
+   *   untouched chunks in their original order, then writes a new table of contents.
+   *
+   *   Chunks are copied verbatim so their checksums stay valid, `k_ChunkPaddingTypeID` chunks are
+   *   inserted where needed so each chunk keeps its offset modulo `k_ChunkReorderAlignment`.
+   *   Chunks not listed in `toc` are not copied. `destination` must support seeking.
+   *
+   * @param out_plan
+   *   Optional plan for the rewritten file, the touched chunks are now one sequential run.
+   */
+  IOErrorCode ChunkFile_Reorder(IOStream* const          source,
+                                const ChunkTOC&          toc,
+                                const ChunkAccessTrace&  trace,
+                                IOStream* const          destination,
+                                ChunkPrefetchPlan* const out_plan = nullptr);
+
+}  // namespace binaryIO
+
+#endif /* BINARY_CHUNK_PREFETCH_HPP */
+
+/******************************************************************************/
+/*
+  MIT License
+
+  Copyright (c) 2024 Shareef Abdoul-Raheem
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+/******************************************************************************/
@@ -0,0 +1,179 @@
+/******************************************************************************/
+/*!
+ * @file   binary_compression.hpp
+ * @author Shareef Abdoul-Raheem (https://blufedora.github.io/)
+ * @date   2024-11-08
+ * @brief
+ *   Compressing / decompressing `IOStream` filters with pluggable codecs.
+ *
+ *   References:
+ *     [LZ4 Block Format](https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md)
+ *
+ * @copyright Copyright (c) 2024 Shareef Abdoul-Raheem
+ */
+/******************************************************************************/
+#ifndef BINARY_COMPRESSION_HPP
+#define BINARY_COMPRESSION_HPP
+
+#include "binary_stream.hpp"  // IOStream, IOAllocator
+
+namespace binaryIO
+{
+  struct ChunkView;
+
+  // Compressed Stream Format
+  //
+  // block : CompressedBlockHeader, byte[compressed_size];
+  //
+  // Each block is compressed independently and holds at most `k_CompressionMaxBlockSize` bytes once decompressed.
+  // A block whose `compressed_size` equals its `uncompressed_size` is stored as is, this is used whenever
+  // the codec could not make the block smaller so the compressed size never exceeds the uncompressed size.
+  //
+
+  inline constexpr IOSize k_CompressionDefaultBlockSize = 64u << 10;
+  inline constexpr IOSize k_CompressionMaxBlockSize     = 4u << 20;
+
+  /*!
+   * @brief
+   *   Identifies the codec a stream was compressed with, stored in `BinaryChunkCompressionInfo::codec`.
+   */
+  enum class CompressionCodec : std::uint32_t
+  {
+    None = 0u,  //!< Every block is stored.
+    LZ4  = 1u,  //!< LZ4 block format, built in through `IOCodec_LZ4`.
+    Zstd = 2u,  //!< Zstandard, reserved for application supplied codecs.
+  };
+
+  /*!
+   * @brief
+   *   Interface for a block compression algorithm, both functions may be called from multiple threads at once
+   *   by the parallel streams.
+   */
+  struct IOCodec
+  {
+    /*!
+     * @return
+     *   Value is the compressed size, 0 if the result would not fit in `destination_capacity` bytes.
+     */
+    IOResult (*Compress)(void* const user_data, const void* const source, const IOSize source_size, void* const destination, const IOSize destination_capacity) = nullptr;
+
+    /*!
+     * @return
+     *   `IOErrorCode::InvalidData` unless exactly `destination_size` bytes were decompressed.
+     */
+    IOErrorCode (*Decompress)(void* const user_data, const void* const source, const IOSize source_size, void* const destination, const IOSize destination_size) = nullptr;
+
+    void*            user_data = nullptr;
+    CompressionCodec codec     = CompressionCodec::None;
+  };
+
+  IOCodec IOCodec_Store();  //!< No compression, does not need a `Compress` or `Decompress` function.
+  IOCodec IOCodec_LZ4();    //!< Greedy LZ4 block compressor and a bounds checked decompressor.
+
+  struct CompressedBlockHeader
+  {
+    std::uint32_t compressed_size;    //!< Little endian.
+    std::uint32_t uncompressed_size;  //!< Little endian.
+  };
+  static_assert(sizeof(CompressedBlockHeader) == 8u, "");
+
+  /*!
+   * @brief
+   *   Write only stream that compresses into `destination` a block at a time.
+   *
+   *   The `BufferedWriteIO` window is the uncompressed block so small writes are a copy,
+   *   `IOStream_Size` is the number of uncompressed bytes written.
+   *   `IOStream_Close` writes the last block and frees the buffers but does not close `destination`.
+   *
+   *   Every block is written with a single `IOStream_WriteV` whose first segment is its `CompressedBlockHeader`,
+   *   destinations that index the blocks (`ChunkWriter::beginCompressedSeekable`) rely on this.
+   */
+  IOStream IOStream_FromCompressor(IOStream* const destination, const IOCodec& codec, const IOAllocator& allocator, const IOSize block_size = k_CompressionDefaultBlockSize);
+
+  /*!
+   * @brief
+   *   Same as `IOStream_FromCompressor` but the window holds `num_blocks_in_flight` blocks that are
+   *   compressed together on `executor` once it fills up, 0 picks two blocks per worker.
+   *
+   *   Blocks are written in order so the output is identical to `IOStream_FromCompressor`'s,
+   *   memory use is bounded by `2 * num_blocks_in_flight * block_size`.
+   */
+  IOStream IOStream_FromParallelCompressor(IOStream* const    destination,
+                                           const IOCodec&     codec,
+                                           const IOAllocator& allocator,
+                                           Executor&          executor,
+                                           const IOSize       block_size           = k_CompressionDefaultBlockSize,
+                                           const IOSize       num_blocks_in_flight = 0u);
+
+  /*!
+   * @brief
+   *   Read only stream that decompresses from `source` a block at a time, exposing each block through `BufferedIO`.
+   *
+   *   Blocks that are entirely within the source's `BufferedIO` window are decompressed straight out of it
+   *   and stored blocks are handed out without a copy, otherwise only a single block is staged.
+   *   Malformed blocks are reported as `IOErrorCode::InvalidData`.
+   */
+  IOStream IOStream_FromDecompressor(IOStream* const source, const IOCodec& codec, const IOAllocator& allocator);
+
+  /*!
+   * @brief
+   *   Same as `IOStream_FromDecompressor` but reads ahead `num_blocks_in_flight` blocks at a time and
+   *   decompresses them together on `executor`, 0 picks two blocks per worker.
+   *
+   *   Blocks are always staged in memory owned by the stream, at most two buffers per block in flight.
+   */
+  IOStream IOStream_FromParallelDecompressor(IOStream* const source, const IOCodec& codec, const IOAllocator& allocator, Executor& executor, const IOSize num_blocks_in_flight = 0u);
+
+  /*!
+   * @brief
+   *   Decompressing stream over the data of a chunk written with `ChunkWriter::beginCompressed`.
+   *
+   *   Chunks written with `ChunkWriter::beginCompressedSeekable` also support `IOStream_Seek`,
+   *   which only decompresses the block covering the new position.
+   *
+   *   The chunk's memory must outlive the stream. Fails with `IOErrorCode::InvalidData` if the chunk
+   *   has no `BinaryChunkCompressionInfo` or a malformed block index and `IOErrorCode::InvalidOperation` if `codec` does not match it.
+   *
+   *   Passing an `executor` decompresses blocks in batches as `IOStream_FromParallelDecompressor` does.
+   */
+  IOStream IOStream_FromCompressedChunk(const ChunkView& chunk, const IOCodec& codec, const IOAllocator& allocator, Executor* const executor = nullptr, const IOSize num_blocks_in_flight = 0u);
+
+  /*!
+   * @brief
+   *   Same as above but reads the chunk from `source` starting at its header, such as after `ChunkTOC::seekToChunk`,
+   *   so only the blocks that are read are loaded.
+   *
+   *   Reads stop at the end of the chunk's data. A seekable chunk requires a seekable `source`
+   *   whose positions are absolute, the stream seeks `source` whenever blocks are not read in order.
+   */
+  IOStream IOStream_FromCompressedChunk(IOStream* const source, const IOCodec& codec, const IOAllocator& allocator, Executor* const executor = nullptr, const IOSize num_blocks_in_flight = 0u);
+
+}  // namespace binaryIO
+
+#endif /* BINARY_COMPRESSION_HPP */
+
+/******************************************************************************/
+/*
+  MIT License
+
+  Copyright (c) 2024 Shareef Abdoul-Raheem
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+/******************************************************************************/
@@ -0,0 +1,92 @@
+/******************************************************************************/
+/*!
+ * @file   binary_executor.hpp
+ * @author Shareef Abdoul-Raheem (https://blufedora.github.io/)
+ * @date   2024-11-02
+ * @brief
+ *   Minimal interface for running independent tasks in parallel,
+ *   lets the heavier library operations use the application's own job system.
+ *
+ * @copyright Copyright (c) 2024 Shareef Abdoul-Raheem
+ */
+/******************************************************************************/
+#ifndef BINARY_EXECUTOR_HPP
+#define BINARY_EXECUTOR_HPP
+
+#include "binary_types.hpp"
+
+namespace binaryIO
+{
+  using ExecutorTaskFn = void (*)(void* const task_data, const IOSize task_index);
+
+  /*!
+   * @brief
+   *   Interface for an object that can run a batch of tasks concurrently.
+   */
+  struct Executor
+  {
+    /*!
+     * @brief
+     *   Must call `task(task_data, i)` exactly once for every i in [0, num_tasks),
+     *   in any order on any thread, returning only once all tasks have completed.
+     */
+    void (*ParallelFor)(Executor* const executor, const IOSize num_tasks, const ExecutorTaskFn task, void* const task_data) = nullptr;
+
+    /*!
+     * @brief
+     *   Optional, releases `user_data` once no batch is running.
+     */
+    void (*Destroy)(Executor* const executor) = nullptr;
+
+    void*  user_data   = nullptr;  //!< Implementation defined.
+    IOSize num_workers = 1u;       //!< Hint for how many tasks can run at the same time.
+  };
+
+  Executor Executor_Serial();
+
+  /*!
+   * @brief
+   *   Starts `num_threads` - 1 helper threads that sleep between batches, the calling thread also runs tasks.
+   *   Falls back to fewer helpers (down to `Executor_Serial`) when threads cannot be started,
+   *   `Executor::num_workers` is the number actually running.
+   *   Batches started from within a task or while another thread's batch is running run on the calling thread.
+   *
+   *   Copies share the helpers, `Executor_Destroy` must be called once to join them.
+   */
+  Executor Executor_FromThreads(const IOSize num_threads);
+
+  /*!
+   * @brief
+   *   Calls `Executor::Destroy` if set and resets the executor to `Executor_Serial`.
+   */
+  void Executor_Destroy(Executor* const executor);
+
+}  // namespace binaryIO
+
+#endif /* BINARY_EXECUTOR_HPP */
+
+/******************************************************************************/
+/*
+  MIT License
+
+  Copyright (c) 2024 Shareef Abdoul-Raheem
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+/******************************************************************************/
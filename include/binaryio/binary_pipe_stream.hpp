@@ -0,0 +1,86 @@
+/******************************************************************************/
+/*!
+ * @file   binary_pipe_stream.hpp
+ * @author Shareef Abdoul-Raheem (https://blufedora.github.io/)
+ * @date   2024-11-14
+ * @brief
+ *   Single producer / single consumer ring buffer connecting two threads with a pair of streams.
+ *
+ *   The producer writes straight into the ring through the writer's `BufferedWriteIO` window and
+ *   the consumer parses straight out of it through the reader's `BufferedIO` window, bytes are
+ *   copied once by whoever produces them. The positions are exchanged with atomics, a thread only
+ *   sleeps when the ring is empty (reader) or full (writer).
+ *
+ *   References:
+ *     [Buffer-centric IO](https://fgiesen.wordpress.com/2011/11/21/buffer-centric-io/)
+ *     [Optimizing a ring buffer for throughput](https://rigtorp.se/ringbuffer/)
+ *
+ * @copyright Copyright (c) 2024 Shareef Abdoul-Raheem
+ */
+/******************************************************************************/
+#ifndef BINARY_PIPE_STREAM_HPP
+#define BINARY_PIPE_STREAM_HPP
+
+#include "binary_stream.hpp"  // IOStream
+
+namespace binaryIO
+{
+  /*!
+   * @brief
+   *   The two ends of a pipe, each may be moved to and used by one thread.
+   *
+   *   `writer` supports `Write` and `BufferedWriteIO`, its window is the free space of the ring up to the point it wraps.
+   *   Staged bytes become visible to the reader when the window fills, on `BufferedWrite_Flush` and on `IOStream_Close`.
+   *   Writing blocks while the ring is full and fails with `IOErrorCode::EndOfStream` once the reader is closed.
+   *
+   *   `reader` supports `Read` and `BufferedIO`, its window is the published bytes of the ring up to the point it wraps.
+   *   `BufferedIO_Refill` hands the consumed window back to the writer and blocks until more bytes are published,
+   *   it fails with `IOErrorCode::EndOfStream` once the writer is closed and every byte has been read.
+   *
+   *   Neither end supports `Size` or `Seek`.
+   */
+  struct IOPipe
+  {
+    IOStream writer;
+    IOStream reader;
+  };
+
+  /*!
+   * @brief
+   *   Creates a pipe, the start of `scratch` holds the shared state and the rest is the ring.
+   *
+   *   Both ends must be closed with `IOStream_Close` before `scratch` is released, either may be closed first.
+   *   The consumer only returns space to the producer as it refills, a ring of a few windows worth
+   *   of bytes (such as a decompressed block or two) keeps both threads busy.
+   */
+  IOPipe IOStream_MakePipe(void* const scratch, const IOSize scratch_size);
+
+}  // namespace binaryIO
+
+#endif /* BINARY_PIPE_STREAM_HPP */
+
+/******************************************************************************/
+/*
+  MIT License
+
+  Copyright (c) 2024 Shareef Abdoul-Raheem
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+/******************************************************************************/
@@ -0,0 +1,470 @@
+/******************************************************************************/
+/*!
+ * @file   binary_schema.hpp
+ * @author Shareef Abdoul-Raheem (https://blufedora.github.io/)
+ * @date   2024-11-11
+ * @brief
+ *   Compile time field lists for serializing plain structs as packed little endian fields.
+ *
+ *   A struct opts in by declaring, next to the type so it is found by ADL:
+ *
+ *     inline binaryIO::IOSchema<BINARYIO_FIELD(Vec3, x), BINARYIO_FIELD(Vec3, y), BINARYIO_FIELD(Vec3, z)> ioSchema(const Vec3*) { return {}; }
+ *
+ *   The function is never called, the schema is read from its return type. It is defined rather than
+ *   only declared so that types with internal linkage, such as in an anonymous namespace, do not warn.
+ *   Fields are written in the listed order without padding so the wire size is the sum of the field sizes.
+ *
+ *   Supported field types are integers, enums, `bool`, IEEE-754 `float` / `double`,
+ *   fixed size arrays of supported types and other structs with a schema.
+ *
+ *   When the in memory layout of a struct already is its wire format, no padding with
+ *   the fields in order on a little endian host, it is copied with a single `memcpy`.
+ *
+ * @copyright Copyright (c) 2024 Shareef Abdoul-Raheem
+ */
+/******************************************************************************/
+#ifndef BINARY_SCHEMA_HPP
+#define BINARY_SCHEMA_HPP
+
+#include "binary_stream.hpp"  // IOStream, BufferedIO, BufferedWriteIO, k_HostIsLittleEndian, detail::encodeXEndian, detail::readWindowSize
+
+#include <algorithm>    // min, max
+#include <cstddef>      // offsetof, size_t
+#include <cstring>      // memcpy, memset
+#include <limits>       // numeric_limits
+#include <type_traits>  // is_integral_v, is_enum_v, is_floating_point_v, has_unique_object_representations_v
+
+//! Names one field of `type` for an `IOSchema`, `type` must be standard layout for `offsetof`.
+#define BINARYIO_FIELD(type, member) ::binaryIO::IOField<&type::member, offsetof(type, member)>
+
+namespace binaryIO
+{
+  template<auto member, std::size_t offset>
+  struct IOField;
+
+  template<typename Class, typename Member, Member Class::*member, std::size_t member_offset>
+  struct IOField<member, member_offset>
+  {
+    using class_type  = Class;
+    using member_type = Member;
+
+    static constexpr std::size_t k_Offset = member_offset;  //!< Offset of the member within `Class`.
+
+    static const Member& get(const Class& object) { return object.*member; }
+    static Member&       get(Class& object) { return object.*member; }
+  };
+
+  template<typename... Fields>
+  struct IOSchema
+  {
+  };
+
+  /*!
+   * @brief
+   *   Wire format of a single type.
+   *
+   *   `k_Size` is the number of bytes on the wire and `k_IsMemcpy` is true
+   *   when the in memory representation is exactly those bytes.
+   */
+  template<typename T, typename = void>
+  struct IOWire;
+
+  namespace detail
+  {
+    template<typename T>
+    using IOSchemaOf = decltype(ioSchema(static_cast<const T*>(nullptr)));
+
+    template<typename T, typename = void>
+    struct HasIOSchema : std::false_type
+    {
+    };
+
+    template<typename T>
+    struct HasIOSchema<T, std::void_t<IOSchemaOf<T>>> : std::true_type
+    {
+    };
+
+    template<typename T>
+    struct IOSchemaWire;
+
+    template<typename... Fields>
+    struct IOSchemaWire<IOSchema<Fields...>>
+    {
+      static constexpr IOSize k_Size = (IOSize(0u) + ... + IOWire<typename Fields::member_type>::k_Size);
+
+      //! True when each field is in its wire format at the running sum of the sizes of the fields before it.
+      static constexpr bool fieldsAreInPlace()
+      {
+        constexpr std::size_t memory_offsets[] = {Fields::k_Offset..., 0u};
+        constexpr IOSize      sizes[]          = {IOWire<typename Fields::member_type>::k_Size..., 0u};
+        constexpr bool        is_memcpy[]      = {IOWire<typename Fields::member_type>::k_IsMemcpy..., true};
+
+        IOSize wire_offset = 0u;
+
+        for (std::size_t i = 0u; i < sizeof...(Fields); ++i)
+        {
+          if (!is_memcpy[i] || memory_offsets[i] != wire_offset)
+          {
+            return false;
+          }
+
+          wire_offset += sizes[i];
+        }
+
+        return true;
+      }
+
+      template<typename Class>
+      static void encode(std::uint8_t* const bytes, const Class& value)
+      {
+        IOSize wire_offset = 0u;
+        ((IOWire<typename Fields::member_type>::encode(bytes + wire_offset, Fields::get(value)), wire_offset += IOWire<typename Fields::member_type>::k_Size), ...);
+      }
+
+      template<typename Class>
+      static void decode(const std::uint8_t* const bytes, Class* const out_value)
+      {
+        IOSize wire_offset = 0u;
+        ((IOWire<typename Fields::member_type>::decode(bytes + wire_offset, &Fields::get(*out_value)), wire_offset += IOWire<typename Fields::member_type>::k_Size), ...);
+      }
+    };
+  }  // namespace detail
+
+  // Integers and enums, `bool` is a byte that decodes any non zero value as true.
+  template<typename T>
+  struct IOWire<T, std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>>>
+  {
+    static constexpr IOSize k_Size     = sizeof(T);
+    static constexpr bool   k_IsMemcpy = k_HostIsLittleEndian && std::has_unique_object_representations_v<T> && !std::is_same_v<T, bool>;
+
+    // Native loads and stores on little endian hosts, the shifts are not always merged inside of loops.
+
+    static void encode(std::uint8_t* const bytes, const T value)
+    {
+      if constexpr (k_HostIsLittleEndian)
+      {
+        std::memcpy(bytes, &value, sizeof(T));
+      }
+      else
+      {
+        detail::encodeXEndian(bytes, value, [](const std::size_t i) { return i; });
+      }
+    }
+
+    static void decode(const std::uint8_t* const bytes, T* const out_value)
+    {
+      if constexpr (k_IsMemcpy)
+      {
+        std::memcpy(out_value, bytes, sizeof(T));
+      }
+      else
+      {
+        *out_value = detail::decodeXEndian<T>(bytes, [](const std::size_t i) { return i; });
+      }
+    }
+  };
+
+  // Floats are written as the little endian bytes of their IEEE-754 representation.
+  template<typename T>
+  struct IOWire<T, std::enable_if_t<std::is_floating_point_v<T>>>
+  {
+    static_assert(std::numeric_limits<T>::is_iec559 && (sizeof(T) == 4u || sizeof(T) == 8u), "Only IEEE-754 float and double are supported.");
+
+    using Bits = std::conditional_t<sizeof(T) == 4u, std::uint32_t, std::uint64_t>;
+
+    static constexpr IOSize k_Size     = sizeof(T);
+    static constexpr bool   k_IsMemcpy = k_HostIsLittleEndian;
+
+    static void encode(std::uint8_t* const bytes, const T value)
+    {
+      Bits bits;
+      std::memcpy(&bits, &value, sizeof(bits));
+      IOWire<Bits>::encode(bytes, bits);
+    }
+
+    static void decode(const std::uint8_t* const bytes, T* const out_value)
+    {
+      Bits bits;
+      IOWire<Bits>::decode(bytes, &bits);
+      std::memcpy(out_value, &bits, sizeof(bits));
+    }
+  };
+
+  template<typename T, std::size_t N>
+  struct IOWire<T[N]>
+  {
+    static constexpr IOSize k_Size     = IOWire<T>::k_Size * N;
+    static constexpr bool   k_IsMemcpy = IOWire<T>::k_IsMemcpy;
+
+    static void encode(std::uint8_t* const bytes, const T (&values)[N])
+    {
+      for (std::size_t i = 0u; i < N; ++i)
+      {
+        IOWire<T>::encode(bytes + i * IOWire<T>::k_Size, values[i]);
+      }
+    }
+
+    static void decode(const std::uint8_t* const bytes, T (*const out_values)[N])
+    {
+      for (std::size_t i = 0u; i < N; ++i)
+      {
+        IOWire<T>::decode(bytes + i * IOWire<T>::k_Size, &(*out_values)[i]);
+      }
+    }
+  };
+
+  template<typename T>
+  struct IOWire<T, std::enable_if_t<detail::HasIOSchema<T>::value>>
+  {
+    using Schema = detail::IOSchemaWire<detail::IOSchemaOf<T>>;
+
+    static_assert(Schema::k_Size != 0u, "A schema needs at least one field.");
+
+    static constexpr IOSize k_Size     = Schema::k_Size;
+    static constexpr bool   k_IsMemcpy = sizeof(T) == k_Size && Schema::fieldsAreInPlace();
+
+    static void encode(std::uint8_t* const bytes, const T& value)
+    {
+      if constexpr (k_IsMemcpy)
+      {
+        std::memcpy(bytes, &value, k_Size);
+      }
+      else
+      {
+        Schema::encode(bytes, value);
+      }
+    }
+
+    static void decode(const std::uint8_t* const bytes, T* const out_value)
+    {
+      if constexpr (k_IsMemcpy)
+      {
+        std::memcpy(out_value, bytes, k_Size);
+      }
+      else
+      {
+        Schema::decode(bytes, out_value);
+      }
+    }
+  };
+
+  template<typename T>
+  inline constexpr IOSize k_WireSize = IOWire<T>::k_Size;  //!< Bytes `writeSchema` produces for one `T`.
+
+  static_assert(k_WireSize<float> == 4u && k_WireSize<std::uint16_t[3]> == 6u, "Wire sizes are the sum of the field sizes.");
+
+  /*!
+   * @brief
+   *   Writes every field of `value` with one bounds check against the `BufferedWriteIO` window,
+   *   falling back to a single `IOStream_Write` of the encoded bytes.
+   */
+  template<typename T>
+  IOResult writeSchema(IOStream* const stream, const T& value) noexcept
+  {
+    BufferedWriteIO* const buffered_write = &stream->buffered_write;
+
+    if (IOSize(buffered_write->buffer_end - buffered_write->cursor) >= k_WireSize<T>)
+    {
+      IOWire<T>::encode(buffered_write->cursor, value);
+      buffered_write->cursor += k_WireSize<T>;
+
+      return IOResult(k_WireSize<T>, IOErrorCode::Success);
+    }
+
+    std::uint8_t bytes[k_WireSize<T>];
+    IOWire<T>::encode(bytes, value);
+
+    return IOStream_Write(stream, bytes, sizeof(bytes));
+  }
+
+  /*!
+   * @brief
+   *   Reads every field of `value` with one bounds check against the `BufferedIO` window,
+   *   falling back to a single `IOStream_Read`, `out_value` is untouched on failure.
+   */
+  template<typename T>
+  IOResult readSchema(IOStream* const stream, T* const out_value) noexcept
+  {
+    BufferedIO* const buffered_io = &stream->buffered_io;
+
+    if (detail::readWindowSize(stream) >= k_WireSize<T>)
+    {
+      IOWire<T>::decode(buffered_io->cursor, out_value);
+      buffered_io->cursor += k_WireSize<T>;
+
+      return IOResult(k_WireSize<T>, IOErrorCode::Success);
+    }
+
+    std::uint8_t   bytes[k_WireSize<T>];
+    const IOResult result = IOStream_Read(stream, bytes, sizeof(bytes));
+
+    if (result.ErrorCode() == IOErrorCode::Success)
+    {
+      IOWire<T>::decode(bytes, out_value);
+    }
+
+    return result;
+  }
+
+  // Bulk versions of the above, encoding as many elements as fit into the window at a time.
+
+  namespace detail
+  {
+    template<typename T>
+    inline constexpr IOSize k_SchemaStagingSize = std::max<IOSize>(4096u, k_WireSize<T>);
+  }
+
+  template<typename T>
+  IOResult writeSchemaArray(IOStream* const stream, const T* const values, const IOSize num_values) noexcept
+  {
+    static constexpr IOSize k_Size = k_WireSize<T>;
+
+    if constexpr (IOWire<T>::k_IsMemcpy)
+    {
+      return IOStream_Write(stream, values, num_values * k_Size);
+    }
+    else
+    {
+      BufferedWriteIO* const buffered_write    = &stream->buffered_write;
+      IOSize                 num_values_done   = 0u;
+      IOSize                 num_bytes_written = 0u;
+
+      while (num_values_done != num_values)
+      {
+        const IOSize num_window_values = std::min(num_values - num_values_done, IOSize(buffered_write->buffer_end - buffered_write->cursor) / k_Size);
+
+        if (num_window_values != 0u)
+        {
+          std::uint8_t* const cursor = buffered_write->cursor;
+
+          for (IOSize i = 0u; i < num_window_values; ++i)
+          {
+            IOWire<T>::encode(cursor + i * k_Size, values[num_values_done + i]);
+          }
+
+          buffered_write->cursor = cursor + num_window_values * k_Size;
+          num_values_done += num_window_values;
+          num_bytes_written += num_window_values * k_Size;
+          continue;
+        }
+
+        std::uint8_t staging_buffer[detail::k_SchemaStagingSize<T>];
+        const IOSize num_stage_values = std::min(num_values - num_values_done, sizeof(staging_buffer) / k_Size);
+
+        for (IOSize i = 0u; i < num_stage_values; ++i)
+        {
+          IOWire<T>::encode(staging_buffer + i * k_Size, values[num_values_done + i]);
+        }
+
+        const IOResult write_result = IOStream_Write(stream, staging_buffer, num_stage_values * k_Size);
+
+        num_bytes_written += write_result.Value();
+
+        if (write_result.ErrorCode() != IOErrorCode::Success)
+        {
+          return IOResult(num_bytes_written, write_result.ErrorCode());
+        }
+
+        num_values_done += num_stage_values;
+      }
+
+      return IOResult(num_bytes_written, IOErrorCode::Success);
+    }
+  }
+
+  //! Only whole elements are decoded on a short read, `Value() / k_WireSize<T>` of them.
+  template<typename T>
+  IOResult readSchemaArray(IOStream* const stream, T* const values, const IOSize num_values) noexcept
+  {
+    static constexpr IOSize k_Size = k_WireSize<T>;
+
+    if constexpr (IOWire<T>::k_IsMemcpy)
+    {
+      const IOResult read_result    = IOStream_Read(stream, values, num_values * k_Size);
+      const IOSize   num_tail_bytes = read_result.Value() % k_Size;
+
+      // The bytes are read in place so the element cut off by a short read is zero filled rather than left half written.
+      if (num_tail_bytes != 0u)
+      {
+        std::memset(reinterpret_cast<std::uint8_t*>(values) + (read_result.Value() - num_tail_bytes), 0, k_Size);
+      }
+
+      return read_result;
+    }
+    else
+    {
+      BufferedIO* const buffered_io     = &stream->buffered_io;
+      IOSize            num_values_done = 0u;
+      IOSize            num_bytes_read  = 0u;
+
+      while (num_values_done != num_values)
+      {
+        const IOSize num_window_values = std::min(num_values - num_values_done, detail::readWindowSize(stream) / k_Size);
+
+        if (num_window_values != 0u)
+        {
+          const std::uint8_t* const cursor = buffered_io->cursor;
+
+          for (IOSize i = 0u; i < num_window_values; ++i)
+          {
+            IOWire<T>::decode(cursor + i * k_Size, values + num_values_done + i);
+          }
+
+          buffered_io->cursor = cursor + num_window_values * k_Size;
+          num_values_done += num_window_values;
+          num_bytes_read += num_window_values * k_Size;
+          continue;
+        }
+
+        std::uint8_t   staging_buffer[detail::k_SchemaStagingSize<T>];
+        const IOSize   num_stage_values = std::min(num_values - num_values_done, sizeof(staging_buffer) / k_Size);
+        const IOResult read_result      = IOStream_Read(stream, staging_buffer, num_stage_values * k_Size);
+        const IOSize   num_read_values  = read_result.Value() / k_Size;
+
+        for (IOSize i = 0u; i < num_read_values; ++i)
+        {
+          IOWire<T>::decode(staging_buffer + i * k_Size, values + num_values_done + i);
+        }
+
+        num_bytes_read += read_result.Value();
+
+        if (read_result.ErrorCode() != IOErrorCode::Success)
+        {
+          return IOResult(num_bytes_read, read_result.ErrorCode());
+        }
+
+        num_values_done += num_stage_values;
+      }
+
+      return IOResult(num_bytes_read, IOErrorCode::Success);
+    }
+  }
+}  // namespace binaryIO
+
+#endif /* BINARY_SCHEMA_HPP */
+
+/******************************************************************************/
+/*
+  MIT License
+
+  Copyright (c) 2024 Shareef Abdoul-Raheem
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+/******************************************************************************/
@@ -0,0 +1,460 @@
+/******************************************************************************/
+/*!
+ * @file   binary_span_stream.hpp
+ * @author Shareef Abdoul-Raheem (https://blufedora.github.io/)
+ * @date   2024-11-12
+ * @brief
+ *   Fixed capacity memory writers and readers whose operations are plain inline
+ *   functions rather than calls through `IOStream`'s function pointers.
+ *
+ *   Meant for hot loops encoding many small values into a buffer known up front,
+ *   such as packing messages into a network packet. The endian and variable length
+ *   integer helpers have overloads with the same names as the `IOStream` versions
+ *   so templated serialization code can target either.
+ *
+ * @copyright Copyright (c) 2024 Shareef Abdoul-Raheem
+ */
+/******************************************************************************/
+#ifndef BINARY_SPAN_STREAM_HPP
+#define BINARY_SPAN_STREAM_HPP
+
+#include "binary_stream.hpp"  // IOStream, k_HostIsLittleEndian, detail::encodeXEndian, detail::encodeVarUInt
+#include "binary_types.hpp"   // IOSize, IOResult, IOErrorCode
+
+#include <cstdint>      // uint8_t
+#include <cstring>      // memcpy
+#include <type_traits>  // is_integral_v, is_enum_v, is_unsigned_v, is_signed_v
+
+namespace binaryIO
+{
+  /*!
+   * @brief
+   *   Writes into a caller owned buffer.
+   *
+   *   Each write either fits entirely or writes nothing and records `IOErrorCode::EndOfStream`,
+   *   the first error sticks so a batch of writes can be checked once at the end.
+   */
+  struct SpanWriter
+  {
+    std::uint8_t* buffer_start = nullptr;
+    std::uint8_t* cursor       = nullptr;
+    std::uint8_t* buffer_end   = nullptr;
+    IOErrorCode   error_state  = IOErrorCode::Success;
+
+    SpanWriter() = default;
+
+    SpanWriter(void* const bytes, const IOSize num_bytes) :
+      buffer_start{static_cast<std::uint8_t*>(bytes)},
+      cursor{buffer_start},
+      buffer_end{buffer_start + num_bytes}
+    {
+    }
+
+    IOSize size() const { return IOSize(cursor - buffer_start); }
+    IOSize capacity() const { return IOSize(buffer_end - buffer_start); }
+    IOSize bytesLeft() const { return IOSize(buffer_end - cursor); }
+
+    void reset()
+    {
+      cursor      = buffer_start;
+      error_state = IOErrorCode::Success;
+    }
+
+    //! Records `error_code` unless an earlier error already was.
+    IOErrorCode fail(const IOErrorCode error_code) noexcept
+    {
+      if (error_state == IOErrorCode::Success)
+      {
+        error_state = error_code;
+      }
+
+      return error_code;
+    }
+
+    //! Returns `num_bytes` bytes to write into directly or nullptr if they do not fit.
+    std::uint8_t* reserve(const IOSize num_bytes) noexcept
+    {
+      if (bytesLeft() < num_bytes)
+      {
+        fail(IOErrorCode::EndOfStream);
+        return nullptr;
+      }
+
+      std::uint8_t* const result = cursor;
+      cursor += num_bytes;
+
+      return result;
+    }
+
+    IOResult write(const void* const source, const IOSize num_source_bytes) noexcept
+    {
+      if (bytesLeft() < num_source_bytes)
+      {
+        return fail(IOErrorCode::EndOfStream);
+      }
+
+      std::memcpy(cursor, source, num_source_bytes);
+      cursor += num_source_bytes;
+
+      return IOResult(num_source_bytes, IOErrorCode::Success);
+    }
+  };
+
+  /*!
+   * @brief
+   *   Reads from a caller owned buffer with the same all or nothing and sticky error behavior as `SpanWriter`.
+   */
+  struct SpanReader
+  {
+    const std::uint8_t* buffer_start = nullptr;
+    const std::uint8_t* cursor       = nullptr;
+    const std::uint8_t* buffer_end   = nullptr;
+    IOErrorCode         error_state  = IOErrorCode::Success;
+
+    SpanReader() = default;
+
+    SpanReader(const void* const bytes, const IOSize num_bytes) :
+      buffer_start{static_cast<const std::uint8_t*>(bytes)},
+      cursor{buffer_start},
+      buffer_end{buffer_start + num_bytes}
+    {
+    }
+
+    IOSize position() const { return IOSize(cursor - buffer_start); }
+    IOSize size() const { return IOSize(buffer_end - buffer_start); }
+    IOSize bytesLeft() const { return IOSize(buffer_end - cursor); }
+
+    //! Records `error_code` unless an earlier error already was.
+    IOErrorCode fail(const IOErrorCode error_code) noexcept
+    {
+      if (error_state == IOErrorCode::Success)
+      {
+        error_state = error_code;
+      }
+
+      return error_code;
+    }
+
+    //! Returns the next `num_bytes` bytes and advances past them or nullptr if there are not enough left.
+    const std::uint8_t* consume(const IOSize num_bytes) noexcept
+    {
+      if (bytesLeft() < num_bytes)
+      {
+        fail(IOErrorCode::EndOfStream);
+        return nullptr;
+      }
+
+      const std::uint8_t* const result = cursor;
+      cursor += num_bytes;
+
+      return result;
+    }
+
+    IOResult read(void* const destination, const IOSize num_destination_bytes) noexcept
+    {
+      if (bytesLeft() < num_destination_bytes)
+      {
+        return fail(IOErrorCode::EndOfStream);
+      }
+
+      std::memcpy(destination, cursor, num_destination_bytes);
+      cursor += num_destination_bytes;
+
+      return IOResult(num_destination_bytes, IOErrorCode::Success);
+    }
+  };
+
+  /*!
+   * @brief
+   *   A `SpanWriter` over inline storage, suitable for the stack.
+   *   Not copyable since the writer points into its own storage.
+   */
+  template<IOSize k_Capacity>
+  struct StaticMemoryStream : public SpanWriter
+  {
+    std::uint8_t storage[k_Capacity];
+
+    StaticMemoryStream() :
+      SpanWriter(storage, k_Capacity)
+    {
+    }
+
+    StaticMemoryStream(const StaticMemoryStream&)            = delete;
+    StaticMemoryStream& operator=(const StaticMemoryStream&) = delete;
+
+    //! Reader over the bytes written so far.
+    SpanReader reader() const { return SpanReader(storage, size()); }
+  };
+
+  /*!
+   * @brief
+   *   Type erased views of a span for code that needs an `IOStream`, the stream's
+   *   `BufferedWriteIO` / `BufferedIO` window is the span's remaining bytes so
+   *   the `IOStream` endian helpers still avoid indirect calls.
+   *
+   *   The span's cursor is updated by `IOStream_Close` (and `BufferedWrite_Flush` for the writer),
+   *   the span must not be used directly while the stream is open. Neither stream supports seeking.
+   */
+  IOStream IOStream_FromSpanWriter(SpanWriter* const writer);
+  IOStream IOStream_FromSpanReader(SpanReader* const reader);
+
+  namespace detail
+  {
+    template<typename T, typename F>
+    IOResult writeXEndian(SpanWriter* const writer, const T value, F&& convertIndex) noexcept
+    {
+      static_assert(std::is_integral_v<T> || std::is_enum_v<T>, "Byte ordering is for integral types.");
+
+      std::uint8_t* const bytes = writer->reserve(sizeof(T));
+
+      if (!bytes)
+      {
+        return IOErrorCode::EndOfStream;
+      }
+
+      encodeXEndian(bytes, value, convertIndex);
+
+      return IOResult(sizeof(T), IOErrorCode::Success);
+    }
+
+    template<typename T, typename F>
+    IOResult readXEndian(SpanReader* const reader, T* const out_value, F&& convertIndex) noexcept
+    {
+      static_assert(std::is_integral_v<T> || std::is_enum_v<T>, "Byte ordering is for integral types.");
+
+      const std::uint8_t* const bytes = reader->consume(sizeof(T));
+
+      if (!bytes)
+      {
+        return IOErrorCode::EndOfStream;
+      }
+
+      *out_value = decodeXEndian<T>(bytes, convertIndex);
+
+      return IOResult(sizeof(T), IOErrorCode::Success);
+    }
+
+    template<typename T>
+    IOResult writeArrayXEndian(SpanWriter* const writer, const T* const values, const IOSize num_values, const bool needs_byte_swap) noexcept
+    {
+      static_assert(std::is_integral_v<T> || std::is_enum_v<T>, "Byte ordering is for integral types.");
+
+      // Checked by element count so that `num_values * sizeof(T)` cannot overflow.
+      if (num_values > writer->bytesLeft() / sizeof(T))
+      {
+        return writer->fail(IOErrorCode::EndOfStream);
+      }
+
+      const IOSize        num_bytes = num_values * sizeof(T);
+      std::uint8_t* const bytes     = writer->reserve(num_bytes);
+
+      if (needs_byte_swap)
+      {
+        byteSwapArray(bytes, values, num_values, sizeof(T));
+      }
+      else
+      {
+        std::memcpy(bytes, values, num_bytes);
+      }
+
+      return IOResult(num_bytes, IOErrorCode::Success);
+    }
+
+    template<typename T>
+    IOResult readArrayXEndian(SpanReader* const reader, T* const values, const IOSize num_values, const bool needs_byte_swap) noexcept
+    {
+      static_assert(std::is_integral_v<T> || std::is_enum_v<T>, "Byte ordering is for integral types.");
+
+      if (num_values > reader->bytesLeft() / sizeof(T))
+      {
+        return reader->fail(IOErrorCode::EndOfStream);
+      }
+
+      const IOSize              num_bytes = num_values * sizeof(T);
+      const std::uint8_t* const bytes     = reader->consume(num_bytes);
+
+      if (needs_byte_swap)
+      {
+        byteSwapArray(values, bytes, num_values, sizeof(T));
+      }
+      else
+      {
+        std::memcpy(values, bytes, num_bytes);
+      }
+
+      return IOResult(num_bytes, IOErrorCode::Success);
+    }
+
+    template<typename U>
+    IOResult writeVarUInt(SpanWriter* const writer, const U value) noexcept
+    {
+      // Fast path: encode directly into the buffer.
+      if (writer->bytesLeft() >= k_VarIntMaxBytes<U>)
+      {
+        const IOSize num_bytes = encodeVarUInt(writer->cursor, value);
+        writer->cursor += num_bytes;
+
+        return IOResult(num_bytes, IOErrorCode::Success);
+      }
+
+      std::uint8_t bytes[k_VarIntMaxBytes<U>];
+
+      return writer->write(bytes, encodeVarUInt(bytes, value));
+    }
+
+    template<typename U>
+    IOResult readVarUInt(SpanReader* const reader, U* const out_value) noexcept
+    {
+      const IOSize        num_bytes_left              = reader->bytesLeft();
+      const std::uint8_t* bytes                       = reader->cursor;
+      std::uint8_t        padded[k_VarIntMaxBytes<U>] = {};
+
+      // Near the end the remaining bytes are decoded from a zero padded copy so the decoder stays in bounds,
+      // a value that does not end within them is cut off rather than terminated by the padding.
+      if (num_bytes_left < k_VarIntMaxBytes<U>)
+      {
+        bool is_terminated = false;
+
+        for (IOSize i = 0u; i < num_bytes_left; ++i)
+        {
+          padded[i] = bytes[i];
+          is_terminated |= (bytes[i] & 0x80u) == 0u;
+        }
+
+        if (!is_terminated)
+        {
+          return reader->fail(IOErrorCode::EndOfStream);
+        }
+
+        bytes = padded;
+      }
+
+      U            value     = 0u;
+      const IOSize num_bytes = decodeVarUInt(bytes, &value);
+
+      if (num_bytes == 0u)
+      {
+        return reader->fail(IOErrorCode::InvalidData);
+      }
+
+      reader->cursor += num_bytes;
+      *out_value = value;
+
+      return IOResult(num_bytes, IOErrorCode::Success);
+    }
+  }  // namespace detail
+
+  template<typename T>
+  IOResult writeLE(SpanWriter* const writer, const T value) noexcept
+  {
+    return detail::writeXEndian(writer, value, [](const std::size_t i) { return i; });
+  }
+
+  template<typename T>
+  IOResult writeBE(SpanWriter* const writer, const T value) noexcept
+  {
+    return detail::writeXEndian(writer, value, [](const std::size_t i) { return sizeof(T) - i - 1; });
+  }
+
+  template<typename T>
+  IOResult readLE(SpanReader* const reader, T* const value) noexcept
+  {
+    return detail::readXEndian(reader, value, [](const std::size_t i) { return i; });
+  }
+
+  template<typename T>
+  IOResult readBE(SpanReader* const reader, T* const value) noexcept
+  {
+    return detail::readXEndian(reader, value, [](const std::size_t i) { return sizeof(T) - i - 1; });
+  }
+
+  template<typename T>
+  IOResult writeLEArray(SpanWriter* const writer, const T* const values, const IOSize num_values) noexcept
+  {
+    return detail::writeArrayXEndian(writer, values, num_values, !k_HostIsLittleEndian);
+  }
+
+  template<typename T>
+  IOResult writeBEArray(SpanWriter* const writer, const T* const values, const IOSize num_values) noexcept
+  {
+    return detail::writeArrayXEndian(writer, values, num_values, k_HostIsLittleEndian);
+  }
+
+  template<typename T>
+  IOResult readLEArray(SpanReader* const reader, T* const values, const IOSize num_values) noexcept
+  {
+    return detail::readArrayXEndian(reader, values, num_values, !k_HostIsLittleEndian);
+  }
+
+  template<typename T>
+  IOResult readBEArray(SpanReader* const reader, T* const values, const IOSize num_values) noexcept
+  {
+    return detail::readArrayXEndian(reader, values, num_values, k_HostIsLittleEndian);
+  }
+
+  template<typename T>
+  IOResult writeVarUInt(SpanWriter* const writer, const T value) noexcept
+  {
+    static_assert(std::is_integral_v<T> && std::is_unsigned_v<T>, "Use `writeVarSInt` for signed types.");
+    return detail::writeVarUInt(writer, value);
+  }
+
+  template<typename T>
+  IOResult writeVarSInt(SpanWriter* const writer, const T value) noexcept
+  {
+    static_assert(std::is_integral_v<T> && std::is_signed_v<T>, "Use `writeVarUInt` for unsigned types.");
+    return detail::writeVarUInt(writer, detail::zigzagEncode(value));
+  }
+
+  template<typename T>
+  IOResult readVarUInt(SpanReader* const reader, T* const value) noexcept
+  {
+    static_assert(std::is_integral_v<T> && std::is_unsigned_v<T>, "Use `readVarSInt` for signed types.");
+    return detail::readVarUInt(reader, value);
+  }
+
+  template<typename T>
+  IOResult readVarSInt(SpanReader* const reader, T* const value) noexcept
+  {
+    static_assert(std::is_integral_v<T> && std::is_signed_v<T>, "Use `readVarUInt` for unsigned types.");
+
+    std::make_unsigned_t<T> encoded = 0u;
+    const IOResult          result  = detail::readVarUInt(reader, &encoded);
+
+    if (result.ErrorCode() == IOErrorCode::Success)
+    {
+      *value = detail::zigzagDecode(encoded);
+    }
+
+    return result;
+  }
+
+}  // namespace binaryIO
+
+#endif /* BINARY_SPAN_STREAM_HPP */
+
+/******************************************************************************/
+/*
+  MIT License
+
+  Copyright (c) 2024 Shareef Abdoul-Raheem
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+/******************************************************************************/
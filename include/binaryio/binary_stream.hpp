@@ -19,7 +19,8 @@
 #include "binary_types.hpp"
 
 #include <climits>      // CHAR_BIT
-#include <type_traits>  // underlying_type_t, is_enum_v, is_integral_v
+#include <cstdint>      // uint64_t
+#include <type_traits>  // underlying_type_t, make_unsigned_t, make_signed_t, is_enum_v, is_integral_v, is_unsigned_v
 
 namespace binaryIO
 {
@@ -30,6 +31,9 @@ namespace binaryIO
    *
    *   Check if the stream supports this through `IOSteam_SupportsBufferedRead`.
    *
+   *   When a stream exposes a window the window's cursor is the stream's read position,
+   *   `IOStream_Read` consumes from the window so both can be freely mixed.
+   *
    *   Based on the ideas in [Buffer-centric IO](https://fgiesen.wordpress.com/2011/11/21/buffer-centric-io/).
    */
   struct BufferedIO
@@ -47,6 +51,31 @@ namespace binaryIO
     IOErrorCode (*Refill)(IOStream* const stream) = nullptr;
   };
 
+  /*!
+   * @brief
+   *   Write side counterpart of `BufferedIO`, bytes written into
+   *   [cursor, buffer_end) are staged until the stream flushes them.
+   *
+   *   An empty window (cursor == buffer_end) means writes must go through `IOStream_Write`.
+   *
+   *   Check if the stream supports this through `IOSteam_SupportsBufferedWrite`.
+   */
+  struct BufferedWriteIO
+  {
+    uint8_t* buffer_start = nullptr;  //!< Start of buffer.
+    uint8_t* cursor       = nullptr;  //!< Invariant: buffer_start <= cursor <= buffer_end, user code sets this.
+    uint8_t* buffer_end   = nullptr;  //!< End of Buffer + 1, should not be written to.
+
+    /*!
+     * @brief
+     *   Commits the bytes in [buffer_start, cursor) to the stream.
+     *
+     *   Post-condition : cursor == buffer_start.
+     *           Return : Error code state of the stream.
+     */
+    IOErrorCode (*Flush)(IOStream* const stream) = nullptr;
+  };
+
   union StreamUserDataValue
   {
     void*  as_handle;
@@ -69,37 +98,183 @@ namespace binaryIO
     StreamUserDataValue values[3];
   };
 
+  // Statistics
+  //
+  //   Compiled in with `BINARY_IO_STATS` (CMake option `BINARYIO_ENABLE_STATS`) and entirely absent otherwise.
+  //   The define changes the layout of `IOStream` so it must match for every translation unit.
+  //
+
+#ifndef BINARY_IO_STATS
+#define BINARY_IO_STATS 0
+#endif
+
+#if BINARY_IO_STATS
+  /*!
+   * @brief
+   *   Counters updated by `IOStream_Read` / `Write` / `Seek` / `ReadV` / `WriteV`,
+   *   `BufferedIO_Refill` and `BufferedWrite_Flush`.
+   *
+   *   Reads and writes served directly from the `BufferedIO` / `BufferedWriteIO` windows, such as
+   *   the `readLE` fast path, are not calls but show up as refills and flushes.
+   *   Times nest, a read's time includes the refills it caused.
+   *   `IOStream_ReadAt` / `WriteAt` are not counted so that they stay safe to call concurrently.
+   */
+  struct IOStreamStats
+  {
+    const char*   name               = nullptr;  //!< Optional label such as an asset path for attributing the counters and trace spans.
+    std::uint64_t num_reads          = 0u;
+    std::uint64_t num_bytes_read     = 0u;
+    std::uint64_t num_writes         = 0u;
+    std::uint64_t num_bytes_written  = 0u;
+    std::uint64_t num_seeks          = 0u;
+    std::uint64_t num_refills        = 0u;
+    std::uint64_t num_bytes_refilled = 0u;  //!< Total size of the windows exposed by refills.
+    std::uint64_t num_flushes        = 0u;
+    std::uint64_t read_ns            = 0u;
+    std::uint64_t write_ns           = 0u;
+    std::uint64_t seek_ns            = 0u;
+    std::uint64_t refill_ns          = 0u;
+    std::uint64_t flush_ns           = 0u;
+  };
+
+  enum class IOTraceEvent : std::uint8_t
+  {
+    Read,
+    Write,
+    Seek,
+    Refill,
+    Flush,
+  };
+
+  /*!
+   * @brief
+   *   Callbacks around each counted operation for forwarding spans to a profiler such as Tracy or Perfetto.
+   *
+   *   `End` is called on the same thread as its `Begin` with spans properly nested.
+   */
+  struct IOTraceHook
+  {
+    void  (*Begin)(void* const user_data, const IOStream* const stream, const IOTraceEvent event)                      = nullptr;
+    void  (*End)(void* const user_data, const IOStream* const stream, const IOTraceEvent event, const IOResult result) = nullptr;
+    void* user_data                                                                                                    = nullptr;
+  };
+#endif
+
+  /*!
+   * @brief
+   *   A single buffer of a scatter read.
+   */
+  struct IOSegment
+  {
+    void*  bytes;
+    IOSize num_bytes;
+  };
+
+  /*!
+   * @brief
+   *   A single buffer of a gather write.
+   */
+  struct IOConstSegment
+  {
+    const void* bytes;
+    IOSize      num_bytes;
+  };
+
   /*!
    * @brief
    *   Interface for reading and writing bytes to an abstract stream object.
+   *
+   *   `ReadV` and `WriteV` are optional, when null `IOStream_ReadV` and `IOStream_WriteV` loop over `Read` and `Write`.
+   *
+   *   `ReadAt` and `WriteAt` are optional positional versions of `Read` and `Write`, they leave the cursor
+   *   and `error_state` untouched so that multiple threads may use them on the same stream at once.
+   *
+   *   `AdviseWillNeed` is an optional readahead hint, see `IOStream_AdviseWillNeed`.
    */
   struct IOStream
   {
     /* Abstract Interface */
 
-    IOResult    (*Size)(IOStream* const stream)                                                              = nullptr;
-    IOResult    (*Read)(IOStream* const stream, void* const destination, const IOSize num_destination_bytes) = nullptr;
-    IOResult    (*Write)(IOStream* const stream, const void* const source, const IOSize num_source_bytes)    = nullptr;
-    IOResult    (*Seek)(IOStream* const stream, const IOOffset offset, const SeekOrigin seek_origin)         = nullptr;
-    IOErrorCode (*Close)(IOStream* const stream)                                                             = nullptr;
+    IOResult    (*Size)(IOStream* const stream)                                                                                     = nullptr;
+    IOResult    (*Read)(IOStream* const stream, void* const destination, const IOSize num_destination_bytes)                        = nullptr;
+    IOResult    (*Write)(IOStream* const stream, const void* const source, const IOSize num_source_bytes)                           = nullptr;
+    IOResult    (*Seek)(IOStream* const stream, const IOOffset offset, const SeekOrigin seek_origin)                                = nullptr;
+    IOErrorCode (*Close)(IOStream* const stream)                                                                                    = nullptr;
+    IOResult    (*ReadV)(IOStream* const stream, const IOSegment* const segments, const IOSize num_segments)                        = nullptr;
+    IOResult    (*WriteV)(IOStream* const stream, const IOConstSegment* const segments, const IOSize num_segments)                  = nullptr;
+    IOResult    (*ReadAt)(IOStream* const stream, const IOSize offset, void* const destination, const IOSize num_destination_bytes) = nullptr;
+    IOResult    (*WriteAt)(IOStream* const stream, const IOSize offset, const void* const source, const IOSize num_source_bytes)    = nullptr;
+    IOErrorCode (*AdviseWillNeed)(IOStream* const stream, const IOSize offset, const IOSize num_bytes)                              = nullptr;
 
     /* Data Members */
 
-    IOStreamUserData user_data   = {};
-    BufferedIO       buffered_io = {};
-    IOErrorCode      error_state = IOErrorCode::Success;
+    IOStreamUserData user_data      = {};
+    BufferedIO       buffered_io    = {};
+    BufferedWriteIO  buffered_write = {};
+    IOErrorCode      error_state    = IOErrorCode::Success;
+#if BINARY_IO_STATS
+    IOStreamStats stats = {};
+#endif
+  };
+
+  /*!
+   * @brief
+   *   Interface for user supplied memory used by streams that need to allocate.
+   *
+   *   `Free` may be null for linear arenas that release everything at once.
+   */
+  struct IOAllocator
+  {
+    void* (*Alloc)(void* const user_data, const IOSize num_bytes, const IOSize alignment) = nullptr;  //!< Returns nullptr on failure.
+    void  (*Free)(void* const user_data, void* const ptr, const IOSize num_bytes)         = nullptr;
+    void* user_data                                                                        = nullptr;
   };
 
+  IOAllocator IOAllocator_Default();  //!< Uses the C runtime heap.
+
   // IO Stream API
 
   bool IOSteam_SupportsRead(const IOStream* const stream);
   bool IOSteam_SupportsWrite(const IOStream* const stream);
   bool IOSteam_SupportsBufferedRead(const IOStream* const stream);
+  bool IOSteam_SupportsBufferedWrite(const IOStream* const stream);
   bool IOSteam_SupportsSeek(const IOStream* const stream);
+  bool IOSteam_SupportsReadAt(const IOStream* const stream);
+  bool IOSteam_SupportsWriteAt(const IOStream* const stream);
 
   IOStream IOStream_FromRWMemory(void* const bytes, const IOSize num_bytes);
   IOStream IOStream_FromROMemory(const void* const bytes, const IOSize num_bytes);
 
+  /*!
+   * @brief
+   *   Growable stream made of a chain of blocks from `allocator`, growing never copies existing data.
+   *
+   *   Each block holds at least `block_size` bytes, the `BufferedIO` window is the current block
+   *   and writes at the end of the stream are staged directly into the last block's spare capacity.
+   *   Allocation failure is reported as `IOErrorCode::AllocationFailure`, when the initial allocation fails
+   *   the returned stream has no operations. `IOStream_Close` frees the blocks, closing again does nothing.
+   */
+  IOStream IOStream_FromBlockAllocator(const IOAllocator& allocator, const IOSize block_size);
+
+  /*!
+   * @brief
+   *   Copies the whole contents of a stream created with `IOStream_FromBlockAllocator` into contiguous memory.
+   *
+   * @return
+   *   Value is the number of bytes copied, `IOErrorCode::EndOfStream` if `destination` was too small.
+   */
+  IOResult BlockStream_Linearize(IOStream* const stream, void* const destination, const IOSize num_destination_bytes);
+
+  /*!
+   * @brief
+   *   Wraps an unbuffered stream so that it supports `BufferedIO` and `BufferedWriteIO` using `scratch` as the window.
+   *
+   *   Both `inner` and `scratch` must outlive the returned stream.
+   *   Writes are staged until `BufferedWrite_Flush`, a read, a seek or `IOStream_Close`.
+   *   Closing the returned stream commits staged writes and rewinds `inner` to the logical read position but does not close it.
+   */
+  IOStream IOStream_MakeBuffered(IOStream* const inner, void* const scratch, const IOSize scratch_size);
+
   IOErrorCode IOStream_ResetErrorState(IOStream* const stream);
   IOResult    IOStream_Size(IOStream* const stream);
   IOResult    IOStream_Read(IOStream* const stream, void* const destination, const IOSize num_destination_bytes);
@@ -107,6 +282,42 @@ namespace binaryIO
   IOResult    IOStream_Seek(IOStream* const stream, const IOOffset offset, const SeekOrigin seek_origin);
   IOErrorCode IOStream_Close(IOStream* const stream);
 
+  /*!
+   * @brief
+   *   Number of bytes from the current position to the end of the stream, for sizing a destination before reading the rest.
+   *
+   * @return
+   *   `IOErrorCode::InvalidOperation` if the stream does not support both `Size` and `Seek`.
+   */
+  IOResult IOStream_Remaining(IOStream* const stream);
+
+  /*!
+   * @brief
+   *   Scatter / gather versions of `IOStream_Read` and `IOStream_Write`, the segments are processed in order.
+   *
+   * @return
+   *   Value is the total number of bytes transferred, stops at the first short transfer.
+   */
+  IOResult IOStream_ReadV(IOStream* const stream, const IOSegment* const segments, const IOSize num_segments);
+  IOResult IOStream_WriteV(IOStream* const stream, const IOConstSegment* const segments, const IOSize num_segments);
+
+  /*!
+   * @brief
+   *   Reads / writes at an absolute `offset` without moving the cursor, safe to call concurrently.
+   *
+   * @return
+   *   Value is the number of bytes transferred, `IOErrorCode::EndOfStream` on a short read and
+   *   `IOErrorCode::InvalidOperation` if the stream does not support positional IO.
+   *   Unlike the other stream operations errors are not accumulated into `error_state`.
+   */
+  IOResult IOStream_ReadAt(IOStream* const stream, const IOSize offset, void* const destination, const IOSize num_destination_bytes);
+  IOResult IOStream_WriteAt(IOStream* const stream, const IOSize offset, const void* const source, const IOSize num_source_bytes);
+
+#if BINARY_IO_STATS
+  //! Installs the process wide trace hook, pass a default constructed hook to remove it. Must not race with stream IO.
+  void IOTrace_SetHook(const IOTraceHook& hook);
+#endif
+
   // Buffered IO API
 
   IOSize      BufferedIO_NumBytesAvailable(const IOStream* const stream);
@@ -114,6 +325,11 @@ namespace binaryIO
   IOResult    BufferedIO_Read(IOStream* const stream, void* const destination, const IOSize num_destination_bytes);
   IOErrorCode BufferedIO_Failure(IOStream* const stream, const IOErrorCode error_code);
 
+  // Buffered Write API
+
+  IOSize      BufferedWrite_NumBytesAvailable(const IOStream* const stream);
+  IOErrorCode BufferedWrite_Flush(IOStream* const stream);
+
   // Helpers for Making New IO Streams
 
   binaryIO::IOResult MemoryStream_CopyBytes(
@@ -126,8 +342,26 @@ namespace binaryIO
 
   // Endianess Handling
 
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__)
+  inline constexpr bool k_HostIsLittleEndian = __BYTE_ORDER__ != __ORDER_BIG_ENDIAN__;
+#else
+  inline constexpr bool k_HostIsLittleEndian = true;  // MSVC only targets little endian platforms.
+#endif
+
   namespace detail
   {
+    //! Bytes the inline fast paths may decode from, none once the stream failed as the window is then a zero buffer rather than data.
+    inline IOSize readWindowSize(const IOStream* const stream) noexcept
+    {
+      return stream->error_state == IOErrorCode::Success ? IOSize(stream->buffered_io.buffer_end - stream->buffered_io.cursor) : 0u;
+    }
+
+    // Array Helpers, when `needs_byte_swap` is false the bytes are passed through to the stream unmodified.
+
+    void     byteSwapArray(void* const destination, const void* const source, const IOSize num_elements, const IOSize element_size);
+    IOResult writeArrayXEndian(IOStream* const stream, const void* const values, const IOSize num_elements, const IOSize element_size, const bool needs_byte_swap);
+    IOResult readArrayXEndian(IOStream* const stream, void* const values, const IOSize num_elements, const IOSize element_size, const bool needs_byte_swap);
+
     template<typename T, bool is_enum>
     struct UnderlyingTypeImpl;
 
@@ -146,17 +380,49 @@ namespace binaryIO
     template<typename T>
     using UnderlyingType = typename UnderlyingTypeImpl<T, std::is_enum_v<T>>::type;
 
+    template<typename T, typename F>
+    void encodeXEndian(std::uint8_t* const bytes, const T value, F&& convertIndex) noexcept
+    {
+      for (std::size_t i = 0u; i < sizeof(T); ++i)
+      {
+        bytes[convertIndex(i)] = (static_cast<UnderlyingType<T>>(value) >> (i * CHAR_BIT)) & 0xFF;
+      }
+    }
+
+    template<typename T, typename F>
+    T decodeXEndian(const std::uint8_t* const bytes, F&& convertIndex) noexcept
+    {
+      using UT = UnderlyingType<T>;
+
+      UT value = 0x0;
+
+      for (std::size_t i = 0u; i < sizeof(T); ++i)
+      {
+        value |= UT(UT(bytes[convertIndex(i)]) << (i * CHAR_BIT));
+      }
+
+      return static_cast<T>(value);
+    }
+
     template<typename T, typename F>
     IOResult writeXEndian(IOStream* const stream, const T value, F&& convertIndex) noexcept
     {
       static_assert(std::is_integral_v<T> || std::is_enum_v<T>, "Byte ordering is for integral types.");
 
-      std::uint8_t bytes[sizeof(T)];
-      for (std::size_t i = 0u; i < sizeof(T); ++i)
+      BufferedWriteIO* const buffered_write = &stream->buffered_write;
+
+      // Fast path: stage directly into the write window.
+      if (IOSize(buffered_write->buffer_end - buffered_write->cursor) >= sizeof(T))
       {
-        bytes[convertIndex(i)] = (static_cast<UnderlyingType<T>>(value) >> (i * CHAR_BIT)) & 0xFF;
+        encodeXEndian(buffered_write->cursor, value, convertIndex);
+        buffered_write->cursor += sizeof(T);
+
+        return IOResult(sizeof(T), IOErrorCode::Success);
       }
 
+      std::uint8_t bytes[sizeof(T)];
+      encodeXEndian(bytes, value, convertIndex);
+
       return IOStream_Write(stream, bytes, sizeof(bytes));
     }
 
@@ -165,21 +431,24 @@ namespace binaryIO
     {
       static_assert(std::is_integral_v<T> || std::is_enum_v<T>, "Byte ordering is for integral types.");
 
-      std::uint8_t      bytes[sizeof(T)];
-      const IOErrorCode result = IOStream_Read(stream, bytes, sizeof(bytes)).ErrorCode();
+      BufferedIO* const buffered_io = &stream->buffered_io;
 
-      if (result == IOErrorCode::Success)
+      // Fast path: decode directly from the read window.
+      if (readWindowSize(stream) >= sizeof(T))
       {
-        using UT = UnderlyingType<T>;
+        *out_value = decodeXEndian<T>(buffered_io->cursor, convertIndex);
+        buffered_io->cursor += sizeof(T);
 
-        UT value = 0x0;
+        return IOErrorCode::Success;
+      }
 
-        for (std::size_t i = 0u; i < sizeof(T); ++i)
-        {
-          value |= UT(UT(bytes[convertIndex(i)]) << (i * CHAR_BIT));
-        }
+      // Slow path: buffered streams refill from within `IOStream_Read`.
+      std::uint8_t      bytes[sizeof(T)];
+      const IOErrorCode result = IOStream_Read(stream, bytes, sizeof(bytes)).ErrorCode();
 
-        *out_value = static_cast<T>(value);
+      if (result == IOErrorCode::Success)
+      {
+        *out_value = decodeXEndian<T>(bytes, convertIndex);
       }
 
       return result;
@@ -210,6 +479,207 @@ namespace binaryIO
     return detail::readXEndian(stream, value, [](const std::size_t i) { return sizeof(T) - i - 1; });
   }
 
+  // Bulk versions of the above, each converts the whole array with a minimal number of stream operations.
+
+  template<typename T>
+  IOResult writeLEArray(IOStream* const stream, const T* const values, const IOSize num_values) noexcept
+  {
+    static_assert(std::is_integral_v<T> || std::is_enum_v<T>, "Byte ordering is for integral types.");
+    return detail::writeArrayXEndian(stream, values, num_values, sizeof(T), !k_HostIsLittleEndian);
+  }
+
+  template<typename T>
+  IOResult writeBEArray(IOStream* const stream, const T* const values, const IOSize num_values) noexcept
+  {
+    static_assert(std::is_integral_v<T> || std::is_enum_v<T>, "Byte ordering is for integral types.");
+    return detail::writeArrayXEndian(stream, values, num_values, sizeof(T), k_HostIsLittleEndian);
+  }
+
+  template<typename T>
+  IOResult readLEArray(IOStream* const stream, T* const values, const IOSize num_values) noexcept
+  {
+    static_assert(std::is_integral_v<T> || std::is_enum_v<T>, "Byte ordering is for integral types.");
+    return detail::readArrayXEndian(stream, values, num_values, sizeof(T), !k_HostIsLittleEndian);
+  }
+
+  template<typename T>
+  IOResult readBEArray(IOStream* const stream, T* const values, const IOSize num_values) noexcept
+  {
+    static_assert(std::is_integral_v<T> || std::is_enum_v<T>, "Byte ordering is for integral types.");
+    return detail::readArrayXEndian(stream, values, num_values, sizeof(T), k_HostIsLittleEndian);
+  }
+
+  // Variable Length Integers
+  //
+  // Unsigned values are LEB128 encoded, 7 bits per byte starting with the least significant group
+  // with the high bit set on every byte but the last. Signed values are zigzag mapped first so that
+  // small negative numbers stay small. Overlong encodings (a zero final byte after the first)
+  // and out of range encodings are `IOErrorCode::InvalidData` so every value has a single encoding.
+
+  namespace detail
+  {
+    template<typename T>
+    inline constexpr IOSize k_VarIntMaxBytes = (sizeof(T) * CHAR_BIT + 6u) / 7u;
+
+    template<typename T>
+    constexpr std::make_unsigned_t<T> zigzagEncode(const T value) noexcept
+    {
+      using U = std::make_unsigned_t<T>;
+      return U(U(value) << 1u) ^ U(value < 0 ? ~U(0u) : U(0u));
+    }
+
+    template<typename U>
+    constexpr std::make_signed_t<U> zigzagDecode(const U value) noexcept
+    {
+      return std::make_signed_t<U>(U(value >> 1u) ^ U(U(0u) - U(value & 1u)));
+    }
+
+    template<typename U>
+    IOSize encodeVarUInt(std::uint8_t* const bytes, U value) noexcept
+    {
+      IOSize num_bytes = 0u;
+
+      while (value >= 0x80u)
+      {
+        bytes[num_bytes++] = std::uint8_t(value | 0x80u);
+        value >>= 7u;
+      }
+
+      bytes[num_bytes++] = std::uint8_t(value);
+
+      return num_bytes;
+    }
+
+    // Decodes from a buffer that holds at least `k_VarIntMaxBytes<U>` bytes, returns 0 for an invalid encoding.
+    template<typename U>
+    IOSize decodeVarUInt(const std::uint8_t* const bytes, U* const out_value) noexcept
+    {
+      constexpr unsigned k_NumBits = sizeof(U) * CHAR_BIT;
+
+      U value = 0u;
+
+      for (IOSize i = 0u; i < k_VarIntMaxBytes<U>; ++i)
+      {
+        const unsigned shift = unsigned(i * 7u);
+        const U        group = U(bytes[i] & 0x7Fu);
+
+        // The last possible byte may only hold the bits that are left.
+        if (k_NumBits - shift < 7u && (group >> (k_NumBits - shift)) != 0u)
+        {
+          return 0u;
+        }
+
+        value |= U(group << shift);
+
+        if ((bytes[i] & 0x80u) == 0u)
+        {
+          if (i != 0u && bytes[i] == 0u)
+          {
+            return 0u;
+          }
+
+          *out_value = value;
+          return i + 1u;
+        }
+      }
+
+      return 0u;
+    }
+
+    IOResult readVarUIntSlow(IOStream* const stream, std::uint64_t* const out_value, const unsigned num_bits);
+
+    template<typename U>
+    IOResult writeVarUInt(IOStream* const stream, const U value) noexcept
+    {
+      BufferedWriteIO* const buffered_write = &stream->buffered_write;
+
+      // Fast path: encode directly into the write window.
+      if (IOSize(buffered_write->buffer_end - buffered_write->cursor) >= k_VarIntMaxBytes<U>)
+      {
+        const IOSize num_bytes = encodeVarUInt(buffered_write->cursor, value);
+        buffered_write->cursor += num_bytes;
+
+        return IOResult(num_bytes, IOErrorCode::Success);
+      }
+
+      std::uint8_t bytes[k_VarIntMaxBytes<U>];
+
+      return IOStream_Write(stream, bytes, encodeVarUInt(bytes, value));
+    }
+
+    template<typename U>
+    IOResult readVarUInt(IOStream* const stream, U* const out_value) noexcept
+    {
+      BufferedIO* const buffered_io = &stream->buffered_io;
+
+      // Fast path: decode directly from the read window, invalid data is reported by the slow path.
+      if (readWindowSize(stream) >= k_VarIntMaxBytes<U>)
+      {
+        const IOSize num_bytes = decodeVarUInt(buffered_io->cursor, out_value);
+
+        if (num_bytes != 0u)
+        {
+          buffered_io->cursor += num_bytes;
+          return IOResult(num_bytes, IOErrorCode::Success);
+        }
+      }
+
+      std::uint64_t  value  = 0u;
+      const IOResult result = readVarUIntSlow(stream, &value, sizeof(U) * CHAR_BIT);
+
+      if (result.ErrorCode() == IOErrorCode::Success)
+      {
+        *out_value = U(value);
+      }
+
+      return result;
+    }
+  }  // namespace detail
+
+  template<typename T>
+  IOResult writeVarUInt(IOStream* const stream, const T value) noexcept
+  {
+    static_assert(std::is_integral_v<T> && std::is_unsigned_v<T>, "Use `writeVarSInt` for signed types.");
+    return detail::writeVarUInt(stream, value);
+  }
+
+  template<typename T>
+  IOResult writeVarSInt(IOStream* const stream, const T value) noexcept
+  {
+    static_assert(std::is_integral_v<T> && std::is_signed_v<T>, "Use `writeVarUInt` for unsigned types.");
+    return detail::writeVarUInt(stream, detail::zigzagEncode(value));
+  }
+
+  template<typename T>
+  IOResult readVarUInt(IOStream* const stream, T* const value) noexcept
+  {
+    static_assert(std::is_integral_v<T> && std::is_unsigned_v<T>, "Use `readVarSInt` for signed types.");
+    return detail::readVarUInt(stream, value);
+  }
+
+  template<typename T>
+  IOResult readVarSInt(IOStream* const stream, T* const value) noexcept
+  {
+    static_assert(std::is_integral_v<T> && std::is_signed_v<T>, "Use `readVarUInt` for unsigned types.");
+
+    std::make_unsigned_t<T> encoded_value;
+    const IOResult          result = detail::readVarUInt(stream, &encoded_value);
+
+    if (result.ErrorCode() == IOErrorCode::Success)
+    {
+      *value = detail::zigzagDecode(encoded_value);
+    }
+
+    return result;
+  }
+
+  // Bulk versions of the above, decoding runs a word at a time kernel directly over the `BufferedIO` window.
+
+  IOResult writeVarUIntArray(IOStream* const stream, const std::uint32_t* const values, const IOSize num_values);
+  IOResult writeVarUIntArray(IOStream* const stream, const std::uint64_t* const values, const IOSize num_values);
+  IOResult readVarUIntArray(IOStream* const stream, std::uint32_t* const values, const IOSize num_values);  //!< Value is the number of values read.
+  IOResult readVarUIntArray(IOStream* const stream, std::uint64_t* const values, const IOSize num_values);  //!< Value is the number of values read.
+
 }  // namespace binaryIO
 
 #endif /* BINARY_STREAM_HPP */
@@ -14,8 +14,11 @@
 
 #include "binary_stream.hpp"  // ByteWriterView, IByteReader
 
-#include <cstdio>  // FILE, fread, feof
-#include <vector>  // vector<T>
+#include <algorithm>  // min, max
+#include <cstdio>     // FILE, fread, feof
+#include <cstring>    // memcpy
+#include <new>        // bad_alloc
+#include <vector>     // vector<T>
 
 namespace binaryIO
 {
@@ -26,49 +29,228 @@ namespace binaryIO
     IOSize                           position = 0u;
   };
 
+  /*!
+   * @brief
+   *   Access mode used when mapping a file into memory.
+   */
+  enum class MappedFileAccess : std::uint8_t
+  {
+    ReadOnly,   //!< The stream will not support writing.
+    ReadWrite,  //!< Writes go directly to the file, the file cannot be grown through the stream.
+  };
+
+  /*!
+   * @brief
+   *   Stream over a C file, `IOStream_Size` queries the file system (`fstat` / `GetFileSizeEx`)
+   *   without flushing or moving the file position and fails for pipes and terminals.
+   */
   IOStream IOStream_FromCFile(std::FILE* const file_handle);
 
-  template<typename Allocator>
-  IOStream IOStream_FromVector(std::vector<uint8_t, Allocator>* const buffer)
-  {
-    IOStream result = {};
-    result.Size     = +[](const IOStream* const stream) -> IOResult {
-      const std::vector<uint8_t, Allocator>* const buffer = static_cast<std::vector<uint8_t, Allocator>*>(stream->user_data.values[0].as_handle);
+  /*!
+   * @brief
+   *   Maps the whole file into memory, the `BufferedIO` window exposes the entire mapping with no copies.
+   *
+   *   On failure the returned stream has no operations and `IOStream::error_state` is set.
+   *   `IOStream_Close` must be called to unmap the file.
+   */
+  IOStream IOStream_FromMappedFile(const char* const path, const MappedFileAccess access);
 
-      return buffer->size();
-    };
-    result.Read = +[](IOStream* const stream, void* const destination, const IOSize num_destination_bytes) -> IOResult {
-      const std::vector<uint8_t, Allocator>* const buffer = static_cast<std::vector<uint8_t, Allocator>*>(stream->user_data.values[0].as_handle);
-      IOSize&                                      cursor = stream->user_data.values[1].as_size;
+  /*!
+   * @brief
+   *   Hints that [offset, offset + num_bytes) will be read soon so the OS can start reading it in the background
+   *   by calling `IOStream::AdviseWillNeed`, the stream's cursor does not move.
+   *   Mapped files use `madvise(MADV_WILLNEED)` / `PrefetchVirtualMemory`, C files and async file streams use
+   *   `posix_fadvise(POSIX_FADV_WILLNEED)` with the range clamped to what `off_t` can address,
+   *   buffered streams forward the hint to their inner stream.
+   *
+   * @return
+   *   `IOErrorCode::Success` for memory streams since the data is already resident,
+   *   `IOErrorCode::InvalidOperation` for streams with no `AdviseWillNeed` hook or no readahead mechanism
+   *   (Windows C files, an offset past what `off_t` can address) so callers can fall back to reading ahead themselves with `AsyncFile`.
+   */
+  IOErrorCode IOStream_AdviseWillNeed(IOStream* const stream, const IOSize offset, const IOSize num_bytes);
 
-      return MemoryStream_CopyBytes(destination, num_destination_bytes, buffer->data() + cursor, buffer->size() - cursor, num_destination_bytes, &cursor);
-    };
-    result.Write = +[](IOStream* const stream, const void* const source, const IOSize num_source_bytes) -> IOResult {
-      std::vector<uint8_t, Allocator>* const buffer = static_cast<std::vector<uint8_t, Allocator>*>(stream->user_data.values[0].as_handle);
-      IOSize&                                cursor = stream->user_data.values[1].as_size;
+  namespace detail
+  {
+    // Writes at `position` growing the vector with a single geometric reserve,
+    // a gap between the end and `position` is only zero filled when `zero_fill_gaps` is set.
+    template<typename Allocator>
+    IOResult vectorWriteAt(std::vector<uint8_t, Allocator>* const buffer, const IOSize position, const void* const source, const IOSize num_source_bytes, const bool zero_fill_gaps)
+    {
+      const uint8_t* const bytes = static_cast<const uint8_t*>(source);
+      const IOSize         size  = buffer->size();
+
+      if (position > size && !zero_fill_gaps)
+      {
+        return IOErrorCode::EndOfStream;
+      }
 
-      const IOSize needed_size = cursor + num_source_bytes;
+      const IOSize final_size = std::max(size, position + num_source_bytes);
 
-      if (needed_size > buffer->size())
+      try
       {
-        try
+        if (final_size > buffer->capacity())
+        {
+          buffer->reserve(std::max(final_size, IOSize(buffer->capacity()) * 2u));
+        }
+
+        if (position > size)
+        {
+          buffer->resize(position);
+        }
+
+        const IOSize num_overwrite_bytes = std::min(num_source_bytes, IOSize(buffer->size() - position));
+
+        if (num_overwrite_bytes != 0u)
+        {
+          std::memcpy(buffer->data() + position, bytes, num_overwrite_bytes);
+        }
+
+        if (num_overwrite_bytes != num_source_bytes)
         {
-          buffer->resize(needed_size);
+          buffer->insert(buffer->end(), bytes + num_overwrite_bytes, bytes + num_source_bytes);
         }
-        catch (const std::bad_alloc&)
+      }
+      catch (const std::bad_alloc&)
+      {
+        return IOErrorCode::AllocationFailure;
+      }
+      catch (...)
+      {
+        return IOErrorCode::UnknownError;
+      }
+
+      return IOResult(num_source_bytes, IOErrorCode::Success);
+    }
+
+    // Bound on the spare capacity exposed to the write window at a time, the vector value initializes it first.
+    inline constexpr IOSize k_VectorWriteWindowSize = 4096u;
+
+    //
+    // While the write window is open the vector is grown over it so `user_data.values[1]`
+    // is the offset of the window and the position is that plus the staged bytes.
+    // `user_data.values[2]` is non zero when gaps are zero filled.
+    //
+
+    template<typename Allocator>
+    std::vector<uint8_t, Allocator>* vectorStreamBuffer(const IOStream* const stream)
+    {
+      return static_cast<std::vector<uint8_t, Allocator>*>(stream->user_data.values[0].as_handle);
+    }
+
+    // Size including the staged bytes without touching the vector.
+    template<typename Allocator>
+    IOSize vectorStreamSize(const IOStream* const stream)
+    {
+      const BufferedWriteIO* const buffered_write = &stream->buffered_write;
+
+      if (buffered_write->buffer_end != nullptr)
+      {
+        return stream->user_data.values[1].as_size + IOSize(buffered_write->cursor - buffered_write->buffer_start);
+      }
+
+      return vectorStreamBuffer<Allocator>(stream)->size();
+    }
+
+    // Commits the staged bytes and closes the write window, the vector's size is exact afterwards.
+    template<typename Allocator>
+    std::vector<uint8_t, Allocator>* vectorStreamSync(IOStream* const stream)
+    {
+      std::vector<uint8_t, Allocator>* const buffer         = vectorStreamBuffer<Allocator>(stream);
+      BufferedWriteIO* const                 buffered_write = &stream->buffered_write;
+
+      if (buffered_write->buffer_end != nullptr)
+      {
+        IOSize& cursor = stream->user_data.values[1].as_size;
+
+        cursor += IOSize(buffered_write->cursor - buffered_write->buffer_start);
+        buffer->resize(cursor);
+
+        buffered_write->buffer_start = nullptr;
+        buffered_write->cursor       = nullptr;
+        buffered_write->buffer_end   = nullptr;
+      }
+
+      return buffer;
+    }
+
+    // Opens the write window over the start of the spare capacity when appending, this never reallocates.
+    template<typename Allocator>
+    void vectorStreamOpenWindow(IOStream* const stream)
+    {
+      std::vector<uint8_t, Allocator>* const buffer = vectorStreamBuffer<Allocator>(stream);
+      const IOSize                           cursor = stream->user_data.values[1].as_size;
+      const IOSize                           size   = buffer->size();
+
+      if (cursor != size)
+      {
+        return;
+      }
+
+      const IOSize window_size = std::min(IOSize(buffer->capacity() - size), k_VectorWriteWindowSize);
+
+      if (window_size != 0u)
+      {
+        try
         {
-          return IOErrorCode::AllocationFailure;
+          buffer->resize(size + window_size);
         }
         catch (...)
         {
-          return IOErrorCode::UnknownError;
+          return;
         }
+
+        uint8_t* const window = buffer->data() + cursor;
+
+        stream->buffered_write.buffer_start = window;
+        stream->buffered_write.cursor       = window;
+        stream->buffered_write.buffer_end   = window + window_size;
+      }
+    }
+  }  // namespace detail
+
+  /*!
+   * @brief
+   *   Growable stream that writes into a standard vector.
+   *
+   *   Writes that extend the vector append with geometric growth of the capacity and without zero filling,
+   *   `reserve_hint` pre-allocates for the expected final size.
+   *   Small appends are staged in a `BufferedWriteIO` window over the spare capacity, the vector is grown
+   *   over the window so call `BufferedWrite_Flush` or `IOStream_Close` before using the vector directly.
+   *   Seeking past the end does not grow the vector, writes that start past the end fail with
+   *   `IOErrorCode::EndOfStream` unless `zero_fill_gaps` is set to zero fill the gap.
+   *   Concurrent `IOStream_WriteAt` calls are only safe while they stay within the vector's current size.
+   */
+  template<typename Allocator>
+  IOStream IOStream_FromVector(std::vector<uint8_t, Allocator>* const buffer, const IOSize reserve_hint = 0u, const bool zero_fill_gaps = false)
+  {
+    IOStream result = {};
+    result.Size     = +[](IOStream* const stream) -> IOResult {
+      return detail::vectorStreamSize<Allocator>(stream);
+    };
+    result.Read = +[](IOStream* const stream, void* const destination, const IOSize num_destination_bytes) -> IOResult {
+      const std::vector<uint8_t, Allocator>* const buffer = detail::vectorStreamSync<Allocator>(stream);
+      IOSize&                                      cursor = stream->user_data.values[1].as_size;
+
+      if (cursor >= buffer->size())
+      {
+        return IOErrorCode::EndOfStream;
       }
 
-      return MemoryStream_CopyBytes(buffer->data() + cursor, buffer->size() - cursor, source, num_source_bytes, num_source_bytes, &cursor);
+      return MemoryStream_CopyBytes(destination, num_destination_bytes, buffer->data() + cursor, buffer->size() - cursor, num_destination_bytes, &cursor);
+    };
+    result.Write = +[](IOStream* const stream, const void* const source, const IOSize num_source_bytes) -> IOResult {
+      std::vector<uint8_t, Allocator>* const buffer = detail::vectorStreamSync<Allocator>(stream);
+      IOSize&                                cursor = stream->user_data.values[1].as_size;
+      const IOResult                         result = detail::vectorWriteAt(buffer, cursor, source, num_source_bytes, stream->user_data.values[2].as_size != 0u);
+
+      cursor += result.Value();
+      detail::vectorStreamOpenWindow<Allocator>(stream);
+
+      return result;
     };
     result.Seek = +[](IOStream* const stream, const IOOffset offset, const SeekOrigin seek_origin) -> IOResult {
-      std::vector<uint8_t, Allocator>* const buffer = static_cast<std::vector<uint8_t, Allocator>*>(stream->user_data.values[0].as_handle);
+      std::vector<uint8_t, Allocator>* const buffer = detail::vectorStreamSync<Allocator>(stream);
       IOSize&                                cursor = stream->user_data.values[1].as_size;
 
       IOOffset final_seek_pos = offset;
@@ -84,35 +266,59 @@ namespace binaryIO
 
       if (final_seek_pos >= 0)
       {
-        if (IOSize(final_seek_pos) > buffer->size())
-        {
-          try
-          {
-            buffer->resize(final_seek_pos);
-            cursor = final_seek_pos;
-          }
-          catch (const std::bad_alloc&)
-          {
-            return IOErrorCode::AllocationFailure;
-          }
-          catch (...)
-          {
-            return IOErrorCode::UnknownError;
-          }
-        }
-        else
-        {
-          cursor = final_seek_pos;
-        }
+        cursor = final_seek_pos;
+
+        return IOResult(cursor, IOErrorCode::Success);
+      }
 
-        return IOErrorCode::Success;
+      return IOResult(cursor, IOErrorCode::SeekError);
+    };
+    result.ReadAt = +[](IOStream* const stream, const IOSize offset, void* const destination, const IOSize num_destination_bytes) -> IOResult {
+      // Staged bytes are already in the vector's storage so positional reads do not need to commit them.
+      const IOSize size = detail::vectorStreamSize<Allocator>(stream);
+
+      if (offset >= size)
+      {
+        return IOErrorCode::EndOfStream;
       }
 
-      return IOErrorCode::SeekError;
+      IOSize position = offset;
+
+      return MemoryStream_CopyBytes(destination, num_destination_bytes, detail::vectorStreamBuffer<Allocator>(stream)->data() + offset, size - offset, num_destination_bytes, &position);
+    };
+    result.WriteAt = +[](IOStream* const stream, const IOSize offset, const void* const source, const IOSize num_source_bytes) -> IOResult {
+      // Writes that may grow the vector commit the staged bytes first.
+      std::vector<uint8_t, Allocator>* const buffer = offset + num_source_bytes <= detail::vectorStreamSize<Allocator>(stream) ?
+                                                       detail::vectorStreamBuffer<Allocator>(stream) :
+                                                       detail::vectorStreamSync<Allocator>(stream);
+
+      return detail::vectorWriteAt(buffer, offset, source, num_source_bytes, stream->user_data.values[2].as_size != 0u);
+    };
+    result.Close = +[](IOStream* const stream) -> IOErrorCode {
+      detail::vectorStreamSync<Allocator>(stream);
+
+      return IOErrorCode::Success;
+    };
+    result.buffered_write.Flush = +[](IOStream* const stream) -> IOErrorCode {
+      detail::vectorStreamSync<Allocator>(stream);
+
+      return stream->error_state;
     };
-    result.Close                         = nullptr;
     result.user_data.values[0].as_handle = buffer;
     result.user_data.values[1].as_size   = 0;
+    result.user_data.values[2].as_size   = zero_fill_gaps ? 1u : 0u;
+
+    if (reserve_hint > buffer->capacity())
+    {
+      try
+      {
+        buffer->reserve(reserve_hint);
+      }
+      catch (...)
+      {
+        result.error_state = IOErrorCode::AllocationFailure;
+      }
+    }
 
     return result;
   }
@@ -75,8 +75,14 @@ namespace binaryIO
   // Stream Types
 
   struct BufferedIO;
+  struct IOSegment;
+  struct IOConstSegment;
   struct IOStream;
 
+  // Executor Types
+
+  struct Executor;
+
   // Chunk Types
 
   struct BinaryChunkHeader;
@@ -0,0 +1,232 @@
+/******************************************************************************/
+/*!
+ * @file   rel_builder.hpp
+ * @author Shareef Abdoul-Raheem (https://blufedora.github.io/)
+ * @date   2024-11-10
+ * @brief
+ *   Builds a single contiguous buffer of objects linked with `rel_ptr` / `rel_array`
+ *   that can be loaded in place with a single read or a memory map.
+ *
+ * @copyright Copyright (c) 2024 Shareef Abdoul-Raheem
+ */
+/******************************************************************************/
+#ifndef REL_BUILDER_HPP
+#define REL_BUILDER_HPP
+
+#include "binary_chunk.hpp"   // BinaryChunkTypeID
+#include "binary_stream.hpp"  // IOStream
+#include "rel_ptr.hpp"        // rel_ptr, rel_array
+
+#include <cstddef>      // max_align_t, ptrdiff_t
+#include <cstring>      // memcpy
+#include <new>          // placement new
+#include <type_traits>  // is_trivially_copyable_v, is_signed_v
+#include <vector>       // vector
+
+namespace binaryIO
+{
+  struct ChunkTOCWriter;
+
+  /*!
+   * @brief
+   *   Handle to an object allocated by a `RelBuilder`, stays valid as the buffer grows.
+   */
+  template<typename T>
+  struct RelRef
+  {
+    IOSize offset = 0u;  //!< Offset in bytes from the start of the buffer.
+  };
+
+  /*!
+   * @brief
+   *   Allocates objects into one growable, alignment aware buffer.
+   *
+   *   Pointers say where a `rel_ptr` lives and what it should point at with `link`,
+   *   the offsets are only written by `finish` so objects never hold a stale offset while the buffer moves.
+   *   The first object allocated sits at offset 0 and is the root a loader casts the data to.
+   *
+   *   Objects must be trivially copyable since the buffer is moved with `memcpy` as it grows.
+   */
+  struct RelBuilder
+  {
+    using FixupWriteFn = bool (*)(std::uint8_t* const location, const std::ptrdiff_t byte_offset);
+
+    struct Fixup
+    {
+      IOSize       pointer_offset;  //!< Where the `rel_ptr::offset` lives.
+      IOSize       target_offset;   //!< What it points at.
+      FixupWriteFn write;
+    };
+
+    std::vector<std::uint8_t> bytes         = {};
+    std::vector<Fixup>        fixups        = {};
+    IOSize                    max_alignment = 1u;  //!< Largest alignment allocated, loaded data must be aligned to at least this.
+
+    /*!
+     * @brief
+     *   Appends `num_bytes` of zeroed memory aligned to `alignment` (a power of two up to `alignof(std::max_align_t)`).
+     *
+     * @return
+     *   The offset of the allocation from the start of the buffer.
+     */
+    IOSize allocate(const IOSize num_bytes, const IOSize alignment);
+
+    template<typename T>
+    RelRef<T> add(const T& value = T{})
+    {
+      static_assert(std::is_trivially_copyable_v<T>, "RelBuilder objects are moved with memcpy.");
+
+      const RelRef<T> result = {allocate(sizeof(T), alignof(T))};
+      new (bytes.data() + result.offset) T(value);
+
+      return result;
+    }
+
+    template<typename T>
+    RelRef<T> addArray(const IOSize num_elements)
+    {
+      static_assert(std::is_trivially_copyable_v<T>, "RelBuilder objects are moved with memcpy.");
+
+      const RelRef<T> result   = {allocate(sizeof(T) * num_elements, alignof(T))};
+      T* const        elements = get(result);
+
+      for (IOSize i = 0u; i < num_elements; ++i)
+      {
+        new (elements + i) T();
+      }
+
+      return result;
+    }
+
+    template<typename T>
+    RelRef<T> addArray(const T* const values, const IOSize num_elements)
+    {
+      static_assert(std::is_trivially_copyable_v<T>, "RelBuilder objects are moved with memcpy.");
+
+      const RelRef<T> result = {allocate(sizeof(T) * num_elements, alignof(T))};
+
+      if (num_elements != 0u)
+      {
+        std::memcpy(bytes.data() + result.offset, values, sizeof(T) * num_elements);
+      }
+
+      return result;
+    }
+
+    //! The returned pointer is invalidated by the next allocation.
+    template<typename T>
+    T* get(const RelRef<T>& ref)
+    {
+      return reinterpret_cast<T*>(bytes.data() + ref.offset);
+    }
+
+    template<typename T>
+    RelRef<T> element(const RelRef<T>& array, const IOSize index) const
+    {
+      return {array.offset + sizeof(T) * index};
+    }
+
+    /*!
+     * @brief
+     *   Records that the `rel_ptr` at `pointer`, which must be inside of the buffer, points at `target` once finished.
+     */
+    template<typename offset_type, typename T, std::uint8_t alignment>
+    void link(rel_ptr<offset_type, T, alignment>* const pointer, const RelRef<T>& target)
+    {
+      addFixup(&pointer->offset, target.offset, &writeOffset<rel_ptr<offset_type, T, alignment>>);
+    }
+
+    template<typename TCount, typename TPtr>
+    void link(rel_array<TCount, TPtr>* const array, const RelRef<typename TPtr::value_type>& elements, const TCount num_elements)
+    {
+      array->num_elements = num_elements;
+      link(&array->elements, elements);
+    }
+
+    /*!
+     * @brief
+     *   Writes every linked offset.
+     *
+     * @return
+     *   `IOErrorCode::InvalidOperation` if a target is out of range of or misaligned for its `rel_ptr` type.
+     */
+    IOErrorCode finish();
+
+    /*!
+     * @brief
+     *   Finishes then writes the buffer as the data of a single chunk.
+     *
+     *   For seekable streams the additional header is padded so the data starts at a
+     *   multiple of `max_alignment` from the start of the stream, ready to be memory mapped.
+     *
+     * @return
+     *   Value is the total size of the chunk.
+     */
+    IOResult writeChunk(IOStream* const stream, const BinaryChunkTypeID& type_id, const VersionType version, ChunkTOCWriter* const toc = nullptr);
+
+    void addFixup(const void* const pointer, const IOSize target_offset, const FixupWriteFn write);
+
+    template<typename RelPtr>
+    static bool writeOffset(std::uint8_t* const location, const std::ptrdiff_t byte_offset)
+    {
+      using offset_type = typename RelPtr::offset_type;
+
+      if (byte_offset % std::ptrdiff_t(RelPtr::k_Alignment) != 0)
+      {
+        return false;
+      }
+
+      const std::ptrdiff_t offset = byte_offset / std::ptrdiff_t(RelPtr::k_Alignment);
+
+      // The invalid offset is excluded since it reads back as null.
+      if constexpr (std::is_signed_v<offset_type>)
+      {
+        if (offset <= std::ptrdiff_t(RelPtr::k_OffsetMin) || offset > std::ptrdiff_t(RelPtr::k_OffsetMax))
+        {
+          return false;
+        }
+      }
+      else
+      {
+        if (offset < 0 || std::uintmax_t(offset) >= std::uintmax_t(RelPtr::k_OffsetMax))
+        {
+          return false;
+        }
+      }
+
+      const offset_type value = offset_type(offset);
+      std::memcpy(location, &value, sizeof(value));
+
+      return true;
+    }
+  };
+
+}  // namespace binaryIO
+
+#endif /* REL_BUILDER_HPP */
+
+/******************************************************************************/
+/*
+  MIT License
+
+  Copyright (c) 2024 Shareef Abdoul-Raheem
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+/******************************************************************************/
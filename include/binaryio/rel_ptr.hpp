@@ -16,7 +16,8 @@
 
 #include "binary_assert.hpp"  // binaryIOAssert
 
-#include <cstdint>      // int8_t, int16_t, int32_t int64_t, uint8_t, uint16_t, uint32_t uint64_t
+#include <cstddef>      // size_t, nullptr_t
+#include <cstdint>      // int8_t, int16_t, int32_t int64_t, uint8_t, uint16_t, uint32_t uint64_t, uintptr_t
 #include <limits>       // numeric_limits
 #include <type_traits>  // is_integral_v, is_unsigned_v
 
@@ -52,6 +53,7 @@ namespace binaryIO
     static constexpr offset_type k_OffsetMax     = std::numeric_limits<offset_type>::max();
     static constexpr offset_type k_OffsetMin     = std::numeric_limits<offset_type>::min();
     static constexpr offset_type k_OffsetInvalid = std::is_signed_v<offset_type> ? k_OffsetMin : k_OffsetMax;
+    static constexpr std::uint8_t k_Alignment     = alignment;
 
     /* alignas(alignment) */ offset_type offset = k_OffsetInvalid;  //!< The stored offset from the address of `this`.
 
@@ -98,6 +100,15 @@ namespace binaryIO
     T*       get() const { return isNull() ? nullptr : reinterpret_cast<T*>(base() + (offset * alignment)); }
     uint8_t* base() const { return reinterpret_cast<uint8_t*>(const_cast<offset_type*>(&offset)); }
 
+    //! Same as `get` but null is selected with a mask rather than a branch, for loops where `isNull` is unpredictable.
+    T* getBranchless() const
+    {
+      const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(base()) + std::uintptr_t(offset) * std::uintptr_t(alignment);
+      const std::uintptr_t mask    = std::uintptr_t(0u) - std::uintptr_t(!isNull());
+
+      return reinterpret_cast<T*>(address & mask);
+    }
+
     /*!
      * @brief
      *   Calculates the offset from the pointer to the base address using the `alignment_type` as the stride.
@@ -150,6 +161,8 @@ namespace binaryIO
     TCount num_elements = 0u;
     TPtr   elements     = nullptr;
 
+    // `operator[]` resolves `elements` on every call, loops should use `begin` / `end` which resolve it once.
+
     value_type& operator[](const std::size_t idx) const { return elements.get()[idx]; }
 
     value_type*       begin() { return elements.get(); }
@@ -184,6 +197,121 @@ namespace binaryIO
   template<typename T, std::uint8_t alignment = 1>
   using rel_array64 = rel_array<std::uint64_t, rel_ptr64<T, alignment>>;
 
+  // Bulk Conversion
+
+  namespace detail
+  {
+    // SIMD kernels for 32 bit offsets on 64 bit targets, `rel_ptrs` is an array of 4 byte `rel_ptr` and `pointers` an array of 8 byte pointers.
+    void RelPtr32_ToPointers(const void* const rel_ptrs, const std::size_t num_pointers, const std::uint8_t alignment, const bool is_signed, void* const out_pointers);
+    void RelPtr32_FromPointers(const void* const pointers, const std::size_t num_pointers, const std::uint8_t alignment, const bool is_signed, void* const out_rel_ptrs);
+  }  // namespace detail
+
+  /*!
+   * @brief
+   *   Converts `num_pointers` contiguous relative pointers to absolute pointers, null stays null.
+   *
+   *   32 bit offsets are converted several at a time with SIMD, other sizes use `rel_ptr::getBranchless`.
+   *   `rel_pointers` and `out_pointers` must not overlap.
+   */
+  template<typename offset_type, typename T, std::uint8_t alignment>
+  void RelPtr_ToPointers(const rel_ptr<offset_type, T, alignment>* const rel_pointers, const std::size_t num_pointers, T** const out_pointers)
+  {
+    if constexpr (sizeof(offset_type) == 4u && sizeof(T*) == 8u)
+    {
+      detail::RelPtr32_ToPointers(rel_pointers, num_pointers, alignment, std::is_signed_v<offset_type>, out_pointers);
+    }
+    else
+    {
+      for (std::size_t i = 0u; i < num_pointers; ++i)
+      {
+        out_pointers[i] = rel_pointers[i].getBranchless();
+      }
+    }
+  }
+
+  /*!
+   * @brief
+   *   Stores `num_pointers` absolute pointers into contiguous relative pointers, null stays null.
+   *
+   *   Unlike assignment the range and alignment of each target is not asserted,
+   *   every target must be representable by the `rel_ptr` at its destination.
+   *   `pointers` and `out_rel_pointers` must not overlap.
+   */
+  template<typename offset_type, typename T, std::uint8_t alignment>
+  void RelPtr_FromPointers(T* const* const pointers, const std::size_t num_pointers, rel_ptr<offset_type, T, alignment>* const out_rel_pointers)
+  {
+    using RelPtr = rel_ptr<offset_type, T, alignment>;
+
+    if constexpr (sizeof(offset_type) == 4u && sizeof(T*) == 8u)
+    {
+      detail::RelPtr32_FromPointers(pointers, num_pointers, alignment, std::is_signed_v<offset_type>, out_rel_pointers);
+    }
+    else
+    {
+      for (std::size_t i = 0u; i < num_pointers; ++i)
+      {
+        const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(pointers[i]);
+        const std::ptrdiff_t off     = std::ptrdiff_t(address - reinterpret_cast<std::uintptr_t>(out_rel_pointers[i].base()));
+
+        out_rel_pointers[i].offset = address ? offset_type(off / std::ptrdiff_t(alignment)) : RelPtr::k_OffsetInvalid;
+      }
+    }
+  }
+
+  //! `RelPtr_ToPointers` over each `rel_ptr` element of `array`, `out_pointers` must hold `array.num_elements` pointers.
+  template<typename TCount, typename TPtr>
+  void RelArray_ToPointers(const rel_array<TCount, TPtr>& array, typename TPtr::value_type::value_type** const out_pointers)
+  {
+    RelPtr_ToPointers(array.begin(), array.num_elements, out_pointers);
+  }
+
+  //! `RelPtr_FromPointers` into each `rel_ptr` element of `out_array`, `pointers` must hold `out_array->num_elements` pointers.
+  template<typename TCount, typename TPtr>
+  void RelArray_FromPointers(typename TPtr::value_type::value_type* const* const pointers, rel_array<TCount, TPtr>* const out_array)
+  {
+    RelPtr_FromPointers(pointers, out_array->num_elements, out_array->begin());
+  }
+
+  // Iteration
+
+  /*!
+   * @brief
+   *   Range over the targets of contiguous relative pointers, each step resolves
+   *   one `rel_ptr` without a branch and the array itself is only resolved once.
+   *
+   *   for (Node* const child : RelArray_Targets(node->children)) { ... }
+   */
+  template<typename RelPtr>
+  struct RelPtrTargetRange
+  {
+    using value_type = typename RelPtr::value_type;
+
+    struct iterator
+    {
+      const RelPtr* cursor;
+
+      value_type* operator*() const { return cursor->getBranchless(); }
+      iterator&   operator++() { return ++cursor, *this; }
+      bool        operator==(const iterator& rhs) const { return cursor == rhs.cursor; }
+      bool        operator!=(const iterator& rhs) const { return cursor != rhs.cursor; }
+    };
+
+    const RelPtr* first;
+    const RelPtr* last;
+
+    iterator    begin() const { return {first}; }
+    iterator    end() const { return {last}; }
+    std::size_t size() const { return std::size_t(last - first); }
+  };
+
+  template<typename TCount, typename TPtr>
+  RelPtrTargetRange<typename TPtr::value_type> RelArray_Targets(const rel_array<TCount, TPtr>& array)
+  {
+    const typename TPtr::value_type* const first = array.begin();
+
+    return {first, first + array.num_elements};
+  }
+
 }  // namespace assetio
 
 #endif /* REL_PTR_HPP */
@@ -0,0 +1,241 @@
+/******************************************************************************/
+/*!
+ * @file   rel_verify.hpp
+ * @author Shareef Abdoul-Raheem (https://blufedora.github.io/)
+ * @date   2024-11-10
+ * @brief
+ *   Bounds and alignment verification of `rel_ptr` / `rel_array` graphs in untrusted
+ *   buffers so that memory mapped or downloaded data can be used in place.
+ *
+ *   A type containing relative pointers opts in by declaring, next to the type so it is found by ADL:
+ *
+ *     bool relVerify(binaryIO::RelVerifier& verifier, const MyType& value);
+ *
+ *   which calls `verifier.verify` on each owned pointer and `verifier.verifyBounds` on each
+ *   pointer to an object owned elsewhere, such as a parent pointer.
+ *
+ *   References:
+ *     [FlatBuffers Verifier](https://flatbuffers.dev/flatbuffers_guide_use_cpp.html)
+ *
+ * @copyright Copyright (c) 2024 Shareef Abdoul-Raheem
+ */
+/******************************************************************************/
+#ifndef REL_VERIFY_HPP
+#define REL_VERIFY_HPP
+
+#include "binary_types.hpp"  // IOSize
+#include "rel_ptr.hpp"       // rel_ptr, rel_array
+
+#include <cstdint>      // uintptr_t
+#include <type_traits>  // void_t, is_signed_v
+#include <utility>      // declval
+
+namespace binaryIO
+{
+  struct RelVerifier;
+
+  namespace detail
+  {
+    template<typename T, typename = void>
+    struct HasRelVerify : std::false_type
+    {
+    };
+
+    template<typename T>
+    struct HasRelVerify<T, std::void_t<decltype(relVerify(std::declval<RelVerifier&>(), std::declval<const T&>()))>> : std::true_type
+    {
+    };
+  }  // namespace detail
+
+  /*!
+   * @brief
+   *   Walks a graph of relative pointers checking that every target lies inside of
+   *   [buffer_begin, buffer_end) and is aligned for its type, without allocating.
+   *
+   *   Shared targets are visited once per owning pointer so the walk is bounded by `max_depth`
+   *   and a budget of `num_objects_left` visited objects, which defaults to the buffer size since
+   *   every object takes at least a byte. Exceeding either fails the verification.
+   */
+  struct RelVerifier
+  {
+    static constexpr IOSize k_DefaultMaxDepth = 64u;
+
+    const std::uint8_t* buffer_begin     = nullptr;
+    const std::uint8_t* buffer_end       = nullptr;
+    IOSize              max_depth        = k_DefaultMaxDepth;
+    IOSize              num_objects_left = 0u;
+    IOSize              depth            = 0u;
+
+    RelVerifier(const void* const buffer_begin, const void* const buffer_end) :
+      buffer_begin{static_cast<const std::uint8_t*>(buffer_begin)},
+      buffer_end{static_cast<const std::uint8_t*>(buffer_end)},
+      num_objects_left{IOSize(this->buffer_end - this->buffer_begin)}
+    {
+    }
+
+    //! True if `num_elements` objects of `T` starting at `elements` are inside of the buffer and aligned.
+    template<typename T>
+    bool verifyRange(const T* const elements, const IOSize num_elements) const
+    {
+      const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(elements);
+
+      return address % alignof(T) == 0u &&
+             address >= reinterpret_cast<std::uintptr_t>(buffer_begin) &&
+             address <= reinterpret_cast<std::uintptr_t>(buffer_end) &&
+             num_elements <= (reinterpret_cast<std::uintptr_t>(buffer_end) - address) / sizeof(T);
+    }
+
+    /*!
+     * @brief
+     *   Resolves `pointer`, which must itself be inside of verified memory, checking
+     *   that `num_elements` objects fit at the target without touching the target.
+     *
+     * @return
+     *   false if the target is out of bounds or misaligned, null pointers are valid and resolve to nullptr.
+     */
+    template<typename offset_type, typename T, std::uint8_t alignment>
+    bool resolve(const rel_ptr<offset_type, T, alignment>& pointer, const IOSize num_elements, const T** const out_target) const
+    {
+      using RelPtr = rel_ptr<offset_type, T, alignment>;
+
+      *out_target = nullptr;
+
+      if (pointer.isNull())
+      {
+        return true;
+      }
+
+      // Rejects offsets larger than the buffer before scaling them so the arithmetic cannot overflow.
+      const IOSize buffer_size = IOSize(buffer_end - buffer_begin);
+      const IOSize magnitude   = std::is_signed_v<offset_type> && pointer.offset < 0 ? IOSize(0u) - IOSize(pointer.offset) : IOSize(pointer.offset);
+
+      if (magnitude > buffer_size / RelPtr::k_Alignment)
+      {
+        return false;
+      }
+
+      const std::uint8_t* const base     = pointer.base();
+      const IOSize              distance = magnitude * RelPtr::k_Alignment;
+      const bool                is_back  = std::is_signed_v<offset_type> && pointer.offset < 0;
+
+      if (is_back ? distance > IOSize(base - buffer_begin) : distance > IOSize(buffer_end - base))
+      {
+        return false;
+      }
+
+      const T* const target = reinterpret_cast<const T*>(is_back ? base - distance : base + distance);
+
+      if (!verifyRange(target, num_elements))
+      {
+        return false;
+      }
+
+      *out_target = target;
+      return true;
+    }
+
+    //! Checks a pointer to an object owned elsewhere, the target's own pointers are not followed.
+    template<typename offset_type, typename T, std::uint8_t alignment>
+    bool verifyBounds(const rel_ptr<offset_type, T, alignment>& pointer) const
+    {
+      const T* target;
+      return resolve(pointer, 1u, &target);
+    }
+
+    template<typename TCount, typename TPtr>
+    bool verifyBounds(const rel_array<TCount, TPtr>& array) const
+    {
+      const typename TPtr::value_type* elements;
+      return resolve(array.elements, array.num_elements, &elements) && (elements || array.num_elements == 0u);
+    }
+
+    //! Checks an owned pointer and everything reachable from its target.
+    template<typename offset_type, typename T, std::uint8_t alignment>
+    bool verify(const rel_ptr<offset_type, T, alignment>& pointer)
+    {
+      const T* target;
+      return resolve(pointer, 1u, &target) && (!target || verifyElements(target, 1u));
+    }
+
+    template<typename TCount, typename TPtr>
+    bool verify(const rel_array<TCount, TPtr>& array)
+    {
+      const typename TPtr::value_type* elements;
+      return resolve(array.elements, array.num_elements, &elements) && (elements ? verifyElements(elements, array.num_elements) : array.num_elements == 0u);
+    }
+
+    //! Runs `relVerify` for each element of a range that has already passed `verifyRange`.
+    template<typename T>
+    bool verifyElements(const T* const elements, const IOSize num_elements)
+    {
+      if constexpr (detail::HasRelVerify<T>::value)
+      {
+        if (depth == max_depth || num_elements > num_objects_left)
+        {
+          return false;
+        }
+
+        num_objects_left -= num_elements;
+        ++depth;
+
+        for (IOSize i = 0u; i < num_elements; ++i)
+        {
+          if (!relVerify(*this, elements[i]))
+          {
+            --depth;
+            return false;
+          }
+        }
+
+        --depth;
+      }
+
+      return true;
+    }
+  };
+
+  /*!
+   * @brief
+   *   Verifies the graph rooted at the start of the buffer, the layout `RelBuilder` produces.
+   *
+   * @return
+   *   The root object or nullptr if any reachable pointer is out of bounds or misaligned.
+   */
+  template<typename T>
+  const T* RelVerifyRoot(const void* const buffer_begin, const void* const buffer_end)
+  {
+    RelVerifier    verifier = {buffer_begin, buffer_end};
+    const T* const root     = static_cast<const T*>(buffer_begin);
+
+    return verifier.verifyRange(root, 1u) && verifier.verifyElements(root, 1u) ? root : nullptr;
+  }
+
+}  // namespace binaryIO
+
+#endif /* REL_VERIFY_HPP */
+
+/******************************************************************************/
+/*
+  MIT License
+
+  Copyright (c) 2024 Shareef Abdoul-Raheem
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+/******************************************************************************/
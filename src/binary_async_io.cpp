@@ -0,0 +1,708 @@
+/******************************************************************************/
+/*!
+ * @file   binary_async_io.cpp
+ * @author Shareef Abdoul-Raheem (https://blufedora.github.io/)
+ * @date   2024-11-06
+ * @brief
+ *   Implementation of the asynchronous file reads and the read ahead stream.
+ *
+ *   Requests are serviced by a small pool of worker threads issuing positional reads,
+ *   the submission / completion queues keep the interface compatible with io_uring or IOCP backends.
+ *
+ * @copyright Copyright (c) 2024 Shareef Abdoul-Raheem
+ */
+/******************************************************************************/
+#include "binaryio/binary_async_io.hpp"
+
+#include "binaryio/binary_assert.hpp"  // binaryIOAssert
+
+#include <algorithm>           // min, max
+#include <condition_variable>  // condition_variable
+#include <cstdint>             // uint8_t
+#include <cstring>             // memcpy
+#include <limits>              // numeric_limits
+#include <memory>              // align
+#include <mutex>               // mutex, unique_lock
+#include <new>                 // nothrow
+#include <system_error>        // system_error
+#include <thread>              // thread
+#include <vector>              // vector
+
+#if _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>  // CreateFileA, ReadFile, GetFileSizeEx, CloseHandle
+#else
+#include <cerrno>      // errno, EINTR
+#include <climits>     // SSIZE_MAX, INT_MAX
+#include <fcntl.h>     // open, posix_fadvise
+#include <sys/stat.h>  // fstat
+#include <unistd.h>    // pread, close
+#endif
+
+// AsyncFile
+//
+// Requests move from the submit queue to a worker, then to the done queue until they are polled.
+//
+
+namespace
+{
+#if _WIN32
+  using AsyncFileHandle = HANDLE;
+#else
+  using AsyncFileHandle = int;
+#endif
+
+  struct AsyncReadQueue
+  {
+    binaryIO::AsyncRead* head = nullptr;
+    binaryIO::AsyncRead* tail = nullptr;
+
+    void push(binaryIO::AsyncRead* const request)
+    {
+      request->next = nullptr;
+
+      if (tail)
+      {
+        tail->next = request;
+      }
+      else
+      {
+        head = request;
+      }
+
+      tail = request;
+    }
+
+    binaryIO::AsyncRead* pop()
+    {
+      binaryIO::AsyncRead* const request = head;
+
+      head = request->next;
+
+      if (!head)
+      {
+        tail = nullptr;
+      }
+
+      return request;
+    }
+  };
+
+  struct AsyncFileImpl
+  {
+    AsyncFileHandle          handle;
+    binaryIO::IOSize         file_size;
+    std::mutex               lock          = {};
+    std::condition_variable  work_signal   = {};
+    std::condition_variable  done_signal   = {};
+    AsyncReadQueue           submitted     = {};
+    AsyncReadQueue           done          = {};
+    binaryIO::IOSize         num_in_flight = 0u;  //!< Submitted and not yet polled.
+    bool                     is_closing    = false;
+    std::vector<std::thread> workers       = {};
+
+    AsyncFileImpl(const AsyncFileHandle handle, const binaryIO::IOSize file_size) :
+      handle{handle},
+      file_size{file_size}
+    {
+    }
+  };
+}  // namespace
+
+static void AsyncFile_CloseHandle(const AsyncFileHandle handle)
+{
+#if _WIN32
+  CloseHandle(handle);
+#else
+  close(handle);
+#endif
+}
+
+static binaryIO::IOResult AsyncFile_ReadAt(const AsyncFileHandle handle, void* const destination, const binaryIO::IOSize offset, const binaryIO::IOSize num_bytes)
+{
+  std::uint8_t* const out      = static_cast<std::uint8_t*>(destination);
+  binaryIO::IOSize    num_read = 0u;
+
+  while (num_read != num_bytes)
+  {
+    const binaryIO::IOSize position = offset + num_read;
+
+#if _WIN32
+    OVERLAPPED overlapped = {};
+    overlapped.Offset     = DWORD(position);
+    overlapped.OffsetHigh = DWORD(position >> 32);
+
+    DWORD num_bytes_read = 0;
+
+    if (!ReadFile(handle, out + num_read, DWORD(std::min<binaryIO::IOSize>(num_bytes - num_read, 0x80000000u)), &num_bytes_read, &overlapped))
+    {
+      return binaryIO::IOResult(num_read, GetLastError() == ERROR_HANDLE_EOF ? binaryIO::IOErrorCode::EndOfStream : binaryIO::IOErrorCode::ReadError);
+    }
+#else
+    const ssize_t num_bytes_read = pread(handle, out + num_read, std::size_t(std::min<binaryIO::IOSize>(num_bytes - num_read, SSIZE_MAX)), off_t(position));
+
+    if (num_bytes_read < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+
+      return binaryIO::IOResult(num_read, binaryIO::IOErrorCode::ReadError);
+    }
+#endif
+
+    if (num_bytes_read == 0)
+    {
+      return binaryIO::IOResult(num_read, binaryIO::IOErrorCode::EndOfStream);
+    }
+
+    num_read += binaryIO::IOSize(num_bytes_read);
+  }
+
+  return binaryIO::IOResult(num_read, binaryIO::IOErrorCode::Success);
+}
+
+static void AsyncFile_WorkerMain(AsyncFileImpl* const impl)
+{
+  std::unique_lock<std::mutex> guard{impl->lock};
+
+  for (;;)
+  {
+    impl->work_signal.wait(guard, [impl]() { return impl->submitted.head != nullptr || impl->is_closing; });
+
+    // Submitted requests are drained before shutting down.
+    if (!impl->submitted.head)
+    {
+      break;
+    }
+
+    binaryIO::AsyncRead* const request = impl->submitted.pop();
+
+    guard.unlock();
+    const binaryIO::IOResult result = AsyncFile_ReadAt(impl->handle, request->destination, request->offset, request->num_bytes);
+    guard.lock();
+
+    request->result = result;
+    impl->done.push(request);
+    impl->done_signal.notify_all();
+  }
+}
+
+binaryIO::IOErrorCode binaryIO::AsyncFile_Open(AsyncFile* const out_file, const char* const path, const IOSize num_workers)
+{
+  out_file->impl = nullptr;
+
+#if _WIN32
+  const HANDLE handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+  if (handle == INVALID_HANDLE_VALUE)
+  {
+    return binaryIO::IOErrorCode::ReadError;
+  }
+
+  LARGE_INTEGER file_size = {};
+
+  if (!GetFileSizeEx(handle, &file_size))
+  {
+    CloseHandle(handle);
+    return binaryIO::IOErrorCode::ReadError;
+  }
+
+  binaryIO::IOSize size = binaryIO::IOSize(file_size.QuadPart);
+#else
+  const int handle = open(path, O_RDONLY | O_CLOEXEC);
+
+  if (handle == -1)
+  {
+    return binaryIO::IOErrorCode::ReadError;
+  }
+
+  struct stat file_info = {};
+
+  if (fstat(handle, &file_info) != 0)
+  {
+    close(handle);
+    return binaryIO::IOErrorCode::ReadError;
+  }
+
+  binaryIO::IOSize size = binaryIO::IOSize(file_info.st_size);
+#endif
+
+  AsyncFileImpl* const impl = new (std::nothrow) AsyncFileImpl(handle, size);
+
+  if (!impl)
+  {
+    AsyncFile_CloseHandle(handle);
+    return binaryIO::IOErrorCode::AllocationFailure;
+  }
+
+  // Running with fewer workers than asked for is still correct so only failing to start any is an error.
+  try
+  {
+    impl->workers.reserve(std::max<IOSize>(num_workers, 1u));
+
+    for (IOSize i = 0u; i < std::max<IOSize>(num_workers, 1u); ++i)
+    {
+      impl->workers.emplace_back(&AsyncFile_WorkerMain, impl);
+    }
+  }
+  catch (const std::system_error&)
+  {
+  }
+  catch (const std::bad_alloc&)
+  {
+  }
+
+  if (impl->workers.empty())
+  {
+    AsyncFile_CloseHandle(handle);
+    delete impl;
+    return binaryIO::IOErrorCode::AllocationFailure;
+  }
+
+  out_file->impl = impl;
+
+  return binaryIO::IOErrorCode::Success;
+}
+
+binaryIO::IOResult binaryIO::AsyncFile_Size(const AsyncFile* const file)
+{
+  if (!file->impl)
+  {
+    return binaryIO::IOErrorCode::InvalidOperation;
+  }
+
+  return static_cast<const AsyncFileImpl*>(file->impl)->file_size;
+}
+
+binaryIO::IOErrorCode binaryIO::AsyncFile_Submit(AsyncFile* const file, AsyncRead* const request)
+{
+  AsyncFileImpl* const impl = static_cast<AsyncFileImpl*>(file->impl);
+
+  if (!impl)
+  {
+    return binaryIO::IOErrorCode::InvalidOperation;
+  }
+
+  binaryIOAssert(request->destination != nullptr || request->num_bytes == 0u, "A read request needs a destination.");
+
+  request->result      = binaryIO::IOErrorCode::Success;
+  request->is_complete = false;
+
+  {
+    const std::lock_guard<std::mutex> guard{impl->lock};
+
+    impl->submitted.push(request);
+    ++impl->num_in_flight;
+  }
+
+  impl->work_signal.notify_one();
+
+  return binaryIO::IOErrorCode::Success;
+}
+
+binaryIO::IOSize binaryIO::AsyncFile_Poll(AsyncFile* const file, const bool wait_for_one)
+{
+  AsyncFileImpl* const impl = static_cast<AsyncFileImpl*>(file->impl);
+
+  if (!impl)
+  {
+    return 0u;
+  }
+
+  AsyncRead* completed     = nullptr;
+  IOSize     num_completed = 0u;
+
+  {
+    std::unique_lock<std::mutex> guard{impl->lock};
+
+    if (wait_for_one)
+    {
+      impl->done_signal.wait(guard, [impl]() { return impl->done.head != nullptr || impl->num_in_flight == 0u; });
+    }
+
+    completed = impl->done.head;
+
+    for (const AsyncRead* request = completed; request; request = request->next)
+    {
+      ++num_completed;
+    }
+
+    impl->done          = {};
+    impl->num_in_flight -= num_completed;
+  }
+
+  // The callback may resubmit or free the request so the link is read first.
+  while (completed)
+  {
+    AsyncRead* const next = completed->next;
+
+    completed->next        = nullptr;
+    completed->is_complete = true;
+
+    if (completed->on_complete)
+    {
+      completed->on_complete(completed);
+    }
+
+    completed = next;
+  }
+
+  return num_completed;
+}
+
+binaryIO::IOErrorCode binaryIO::AsyncFile_Wait(AsyncFile* const file, AsyncRead* const request)
+{
+  while (!request->is_complete)
+  {
+    if (AsyncFile_Poll(file, true) == 0u)
+    {
+      // Nothing is in flight so the request was never submitted.
+      return binaryIO::IOErrorCode::InvalidOperation;
+    }
+  }
+
+  return request->result.ErrorCode();
+}
+
+void binaryIO::AsyncFile_Close(AsyncFile* const file)
+{
+  AsyncFileImpl* const impl = static_cast<AsyncFileImpl*>(file->impl);
+
+  if (!impl)
+  {
+    return;
+  }
+
+  {
+    const std::lock_guard<std::mutex> guard{impl->lock};
+    impl->is_closing = true;
+  }
+
+  impl->work_signal.notify_all();
+
+  for (std::thread& worker : impl->workers)
+  {
+    worker.join();
+  }
+
+  AsyncFile_CloseHandle(impl->handle);
+  delete impl;
+
+  file->impl = nullptr;
+}
+
+// Async Stream
+//
+// The window is one of the two blocks while the other is the target of the in flight prefetch.
+// After a failed refill the window is the zero buffer, `window_offset + window_size` is still the stream position.
+//
+// user_data.values[0] : AsyncStreamState* (placed at the start of the scratch buffer)
+//
+
+namespace
+{
+  struct AsyncStreamState
+  {
+    binaryIO::AsyncFile*  file;
+    std::uint8_t*         blocks[2];
+    binaryIO::IOSize      block_size;
+    binaryIO::IOSize      file_size;
+    binaryIO::IOSize      window_offset;  //!< File offset of the window's first byte.
+    binaryIO::IOSize      window_size;
+    binaryIO::AsyncRead   prefetch;
+    binaryIO::IOErrorCode deferred_error;  //!< Error of a short block, reported by the refill after its bytes.
+    int                   active_block;
+    bool                  is_prefetching;
+  };
+}  // namespace
+
+static AsyncStreamState* AsyncStream_State(const binaryIO::IOStream* const stream)
+{
+  return static_cast<AsyncStreamState*>(stream->user_data.values[0].as_handle);
+}
+
+static bool AsyncStream_HasFailed(const binaryIO::IOStream* const stream)
+{
+  const AsyncStreamState* const state = AsyncStream_State(stream);
+
+  return stream->buffered_io.buffer_start != state->blocks[state->active_block];
+}
+
+static binaryIO::IOErrorCode AsyncStream_Refill(binaryIO::IOStream* const stream);
+
+static void AsyncStream_SetWindow(binaryIO::IOStream* const stream, const binaryIO::IOSize window_offset, const binaryIO::IOSize window_size)
+{
+  AsyncStreamState* const   state = AsyncStream_State(stream);
+  const std::uint8_t* const block = state->blocks[state->active_block];
+
+  state->window_offset             = window_offset;
+  state->window_size               = window_size;
+  stream->buffered_io.buffer_start = block;
+  stream->buffered_io.cursor       = block;
+  stream->buffered_io.buffer_end   = block + window_size;
+  stream->buffered_io.Refill       = &AsyncStream_Refill;
+}
+
+static void AsyncStream_FinishPrefetch(AsyncStreamState* const state)
+{
+  if (state->is_prefetching)
+  {
+    AsyncFile_Wait(state->file, &state->prefetch);
+    state->is_prefetching = false;
+  }
+}
+
+static binaryIO::IOErrorCode AsyncStream_ReadBlock(AsyncStreamState* const state, const int block_index, const binaryIO::IOSize offset)
+{
+  binaryIO::AsyncRead* const request = &state->prefetch;
+
+  *request             = {};
+  request->destination = state->blocks[block_index];
+  request->offset      = offset;
+  request->num_bytes   = std::min(state->block_size, state->file_size - offset);
+
+  return AsyncFile_Submit(state->file, request);
+}
+
+static binaryIO::IOErrorCode AsyncStream_Refill(binaryIO::IOStream* const stream)
+{
+  AsyncStreamState* const state       = AsyncStream_State(stream);
+  const binaryIO::IOSize  next_offset = state->window_offset + state->window_size;
+  binaryIO::IOResult      result      = binaryIO::IOErrorCode::EndOfStream;
+
+  if (state->deferred_error != binaryIO::IOErrorCode::Success)
+  {
+    result = state->deferred_error;
+  }
+  else if (state->is_prefetching && state->prefetch.offset == next_offset)
+  {
+    AsyncStream_FinishPrefetch(state);
+
+    state->active_block = 1 - state->active_block;
+    result              = state->prefetch.result;
+  }
+  else
+  {
+    AsyncStream_FinishPrefetch(state);
+
+    // Nothing useful was prefetched (first refill after a seek), read the block and wait for it.
+    if (next_offset < state->file_size)
+    {
+      const binaryIO::IOErrorCode submit_error = AsyncStream_ReadBlock(state, state->active_block, next_offset);
+
+      if (submit_error == binaryIO::IOErrorCode::Success)
+      {
+        AsyncFile_Wait(state->file, &state->prefetch);
+        result = state->prefetch.result;
+      }
+      else
+      {
+        result = submit_error;
+      }
+    }
+  }
+
+  if (result.Value() == 0u)
+  {
+    state->window_offset = next_offset;
+    state->window_size   = 0u;
+
+    return BufferedIO_Failure(stream, result.ErrorCode() != binaryIO::IOErrorCode::Success ? result.ErrorCode() : binaryIO::IOErrorCode::EndOfStream);
+  }
+
+  AsyncStream_SetWindow(stream, next_offset, result.Value());
+
+  // A block cut short by an error is still handed out, the error is kept for the next refill.
+  state->deferred_error = result.ErrorCode();
+
+  // Read ahead into the other block while the caller consumes this one.
+  const binaryIO::IOSize prefetch_offset = next_offset + result.Value();
+
+  if (state->deferred_error == binaryIO::IOErrorCode::Success && prefetch_offset < state->file_size && AsyncStream_ReadBlock(state, 1 - state->active_block, prefetch_offset) == binaryIO::IOErrorCode::Success)
+  {
+    state->is_prefetching = true;
+  }
+
+  return binaryIO::IOErrorCode::Success;
+}
+
+static binaryIO::IOResult AsyncStream_Size(binaryIO::IOStream* const stream)
+{
+  return AsyncStream_State(stream)->file_size;
+}
+
+static binaryIO::IOResult AsyncStream_Read(binaryIO::IOStream* const stream, void* const destination, const binaryIO::IOSize num_destination_bytes)
+{
+  binaryIO::BufferedIO* const buffered_io = &stream->buffered_io;
+  std::uint8_t* const         out         = static_cast<std::uint8_t*>(destination);
+  binaryIO::IOSize            num_read    = 0u;
+  binaryIO::IOErrorCode       error_code  = binaryIO::IOErrorCode::Success;
+
+  while (num_read != num_destination_bytes)
+  {
+    if (AsyncStream_HasFailed(stream) || buffered_io->cursor == buffered_io->buffer_end)
+    {
+      // `ReadError` from the worker is passed on rather than reported as the end of the file.
+      error_code = AsyncStream_Refill(stream);
+
+      if (error_code != binaryIO::IOErrorCode::Success)
+      {
+        break;
+      }
+    }
+
+    const binaryIO::IOSize num_bytes_to_copy = std::min(num_destination_bytes - num_read, BufferedIO_NumBytesAvailable(stream));
+
+    std::memcpy(out + num_read, buffered_io->cursor, num_bytes_to_copy);
+    num_read += num_bytes_to_copy;
+    buffered_io->cursor += num_bytes_to_copy;
+  }
+
+  return binaryIO::IOResult(num_read, error_code);
+}
+
+static binaryIO::IOResult AsyncStream_Seek(binaryIO::IOStream* const stream, const binaryIO::IOOffset offset, const binaryIO::SeekOrigin seek_origin)
+{
+  AsyncStreamState* const state      = AsyncStream_State(stream);
+  const bool              has_failed = AsyncStream_HasFailed(stream);
+  const binaryIO::IOSize  position   = state->window_offset + (has_failed ? state->window_size : binaryIO::IOSize(stream->buffered_io.cursor - stream->buffered_io.buffer_start));
+
+  const binaryIO::IOOffset base_offset[] =
+   {
+    0,
+    binaryIO::IOOffset(position),
+    binaryIO::IOOffset(state->file_size),
+   };
+
+  const binaryIO::IOOffset absolute_location = base_offset[int(seek_origin)] + offset;
+
+  if (absolute_location < 0 || binaryIO::IOSize(absolute_location) > state->file_size)
+  {
+    return binaryIO::IOResult(position, binaryIO::IOErrorCode::SeekError);
+  }
+
+  const binaryIO::IOSize target = binaryIO::IOSize(absolute_location);
+
+  if (!has_failed && target >= state->window_offset && target - state->window_offset <= state->window_size)
+  {
+    stream->buffered_io.cursor = stream->buffered_io.buffer_start + (target - state->window_offset);
+  }
+  else
+  {
+    // An empty window at the target, the pending prefetch is reused by the next refill if it starts there.
+    AsyncStream_SetWindow(stream, target, 0u);
+    state->deferred_error = binaryIO::IOErrorCode::Success;
+  }
+
+  return binaryIO::IOResult(target, binaryIO::IOErrorCode::Success);
+}
+
+static binaryIO::IOErrorCode AsyncStream_AdviseWillNeed(binaryIO::IOStream* const stream, const binaryIO::IOSize offset, const binaryIO::IOSize num_bytes)
+{
+  const AsyncStreamState* const state = AsyncStream_State(stream);
+
+  if (offset >= state->file_size || num_bytes == 0u)
+  {
+    return binaryIO::IOErrorCode::Success;
+  }
+
+#if _WIN32
+  return binaryIO::IOErrorCode::InvalidOperation;
+#else
+  constexpr binaryIO::IOSize k_MaxOffset = binaryIO::IOSize(std::numeric_limits<off_t>::max());
+
+  if (offset > k_MaxOffset)
+  {
+    return binaryIO::IOErrorCode::InvalidOperation;
+  }
+
+  const AsyncFileImpl* const impl      = static_cast<const AsyncFileImpl*>(state->file->impl);
+  const binaryIO::IOSize     range_len = std::min({num_bytes, state->file_size - offset, k_MaxOffset - offset});
+
+#if defined(__APPLE__)
+  struct radvisory advisory = {};
+  advisory.ra_offset        = off_t(offset);
+  advisory.ra_count         = int(std::min<binaryIO::IOSize>(range_len, binaryIO::IOSize(INT_MAX)));
+
+  return fcntl(impl->handle, F_RDADVISE, &advisory) != -1 ? binaryIO::IOErrorCode::Success : binaryIO::IOErrorCode::UnknownError;
+#else
+  return posix_fadvise(impl->handle, off_t(offset), off_t(range_len), POSIX_FADV_WILLNEED) == 0 ? binaryIO::IOErrorCode::Success : binaryIO::IOErrorCode::UnknownError;
+#endif
+#endif
+}
+
+static binaryIO::IOErrorCode AsyncStream_Close(binaryIO::IOStream* const stream)
+{
+  AsyncStream_FinishPrefetch(AsyncStream_State(stream));
+
+  stream->buffered_io = {};
+
+  return binaryIO::IOErrorCode::Success;
+}
+
+binaryIO::IOStream binaryIO::IOStream_FromAsyncFile(AsyncFile* const file, void* const scratch, const IOSize scratch_size)
+{
+  void*       state_memory = scratch;
+  std::size_t space        = std::size_t(scratch_size);
+
+  const bool is_large_enough = std::align(alignof(AsyncStreamState), sizeof(AsyncStreamState), state_memory, space) && space >= sizeof(AsyncStreamState) + 2u;
+
+  binaryIOAssert(is_large_enough, "The scratch buffer must hold the stream state and two non empty blocks.");
+  (void)is_large_enough;
+
+  AsyncStreamState* const state = new (state_memory) AsyncStreamState{};
+  std::uint8_t* const     bytes = reinterpret_cast<std::uint8_t*>(state + 1);
+
+  state->file       = file;
+  state->block_size = (space - sizeof(AsyncStreamState)) / 2u;
+  state->blocks[0]  = bytes;
+  state->blocks[1]  = bytes + state->block_size;
+  state->file_size  = AsyncFile_Size(file).Value();
+
+  binaryIO::IOStream result            = {};
+  result.Size                          = &AsyncStream_Size;
+  result.Read                          = &AsyncStream_Read;
+  result.Seek                          = &AsyncStream_Seek;
+  result.Close                         = &AsyncStream_Close;
+  result.AdviseWillNeed                = &AsyncStream_AdviseWillNeed;
+  result.user_data.values[0].as_handle = state;
+
+  AsyncStream_SetWindow(&result, 0u, 0u);
+
+  // Start reading the first block right away, the first refill picks it up.
+  if (state->file_size != 0u && AsyncStream_ReadBlock(state, 1, 0u) == binaryIO::IOErrorCode::Success)
+  {
+    state->is_prefetching = true;
+  }
+
+  return result;
+}
+
+/******************************************************************************/
+/*
+  MIT License
+
+  Copyright (c) 2024 Shareef Abdoul-Raheem
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+/******************************************************************************/
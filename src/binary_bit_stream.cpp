@@ -0,0 +1,108 @@
+/******************************************************************************/
+/*!
+ * @file   binary_bit_stream.cpp
+ * @author Shareef Abdoul-Raheem (https://blufedora.github.io/)
+ * @date   2024-11-07
+ * @brief
+ *   Out of line slow paths of the bit level packing stream.
+ *
+ * @copyright Copyright (c) 2024 Shareef Abdoul-Raheem
+ */
+/******************************************************************************/
+#include "binaryio/binary_bit_stream.hpp"
+
+#include <cstdint>  // uint8_t, uint64_t
+
+// Bit Writer
+
+binaryIO::IOErrorCode binaryIO::BitWriter::flush()
+{
+  const unsigned num_bytes = (num_bits + 7u) / 8u;
+
+  std::uint8_t bytes[sizeof(bits)];
+  detail::encodeXEndian(bytes, bits, [](const std::size_t i) { return i; });
+
+  const IOErrorCode result = IOStream_Write(stream, bytes, num_bytes).ErrorCode();
+
+  if (error_state == IOErrorCode::Success)
+  {
+    error_state = result;
+  }
+
+  bits     = 0u;
+  num_bits = 0u;
+
+  return error_state;
+}
+
+// Bit Reader
+//
+// Bits in the accumulator above `num_bits` may hold the start of the next unread byte
+// after a fast refill, every later refill or's in those same bits so they never need clearing.
+//
+
+void binaryIO::BitReader::refillSlow(const unsigned num_needed_bits) noexcept
+{
+  // Only read the bytes needed so nothing past the last field is consumed from a stream that cannot give bytes back.
+  const IOSize num_bytes = (num_needed_bits - num_bits + 7u) / 8u;
+
+  std::uint8_t   bytes[sizeof(bits)] = {};
+  const IOResult result              = IOStream_Read(stream, bytes, num_bytes);
+
+  if (result.ErrorCode() != IOErrorCode::Success)
+  {
+    if (error_state == IOErrorCode::Success)
+    {
+      error_state = result.ErrorCode();
+    }
+
+    // Past the end reads as zeros, bytes after a short read are already zero.
+    bits &= num_bits != 0u ? detail::lowBitsMask(num_bits) : 0u;
+  }
+
+  for (IOSize i = 0u; i < num_bytes; ++i)
+  {
+    bits |= std::uint64_t(bytes[i]) << num_bits;
+    num_bits += 8u;
+  }
+}
+
+binaryIO::IOErrorCode binaryIO::BitReader::finish()
+{
+  // Whole bytes left over only ever come from a fast refill out of the current window.
+  if (error_state == IOErrorCode::Success)
+  {
+    stream->buffered_io.cursor -= num_bits / 8u;
+  }
+
+  bits     = 0u;
+  num_bits = 0u;
+
+  return error_state;
+}
+
+/******************************************************************************/
+/*
+  MIT License
+
+  Copyright (c) 2024 Shareef Abdoul-Raheem
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+/******************************************************************************/
@@ -0,0 +1,795 @@
+/******************************************************************************/
+/*!
+ * @file   binary_chunk_io.cpp
+ * @author Shareef Abdoul-Raheem (https://blufedora.github.io/)
+ * @date   2024-11-04
+ * @brief
+ *   Implementation of the stream based chunk file helpers.
+ *
+ * @copyright Copyright (c) 2024 Shareef Abdoul-Raheem
+ */
+/******************************************************************************/
+#include "binaryio/binary_chunk_io.hpp"
+
+#include "binaryio/binary_assert.hpp"  // binaryIOAssert
+
+#include <algorithm>  // copy, sort, lower_bound
+#include <cstddef>    // offsetof
+#include <cstring>    // memcpy
+#include <new>        // bad_alloc
+
+static std::uint32_t ChunkIO_Checksum(const void* const bytes, const binaryIO::IOSize num_bytes)
+{
+  std::uint32_t crc = crc32_begin();
+  crc32_addBytes(&crc, bytes, num_bytes);
+  crc32_end(&crc);
+
+  return crc;
+}
+
+static binaryIO::IOErrorCode ChunkIO_WriteChunk(binaryIO::IOStream* const stream, const binaryIO::BinaryChunkTypeID& type_id, const binaryIO::VersionType version, const void* const data, const binaryIO::IOSize data_size)
+{
+  const binaryIO::BinaryChunkHeader header{type_id, version, data_size};
+  const binaryIO::BinaryChunkFooter footer{ChunkIO_Checksum(data, data_size)};
+
+  const binaryIO::IOConstSegment segments[] =
+   {
+    {&header, sizeof(header)},
+    {data, data_size},
+    {&footer, sizeof(footer)},
+   };
+
+  return IOStream_WriteV(stream, segments, sizeof(segments) / sizeof(segments[0])).ErrorCode();
+}
+
+//
+// Reads a chunk header and skips any additional header bytes, leaving the stream at the chunk's data.
+//
+static binaryIO::IOErrorCode ChunkIO_ReadHeader(binaryIO::IOStream* const stream, binaryIO::BinaryChunkHeader* const out_header)
+{
+  const binaryIO::IOErrorCode read_error = IOStream_Read(stream, out_header, sizeof(*out_header)).ErrorCode();
+
+  if (read_error != binaryIO::IOErrorCode::Success)
+  {
+    return read_error;
+  }
+
+  if (out_header->header_size < sizeof(binaryIO::BinaryChunkHeader))
+  {
+    return binaryIO::IOErrorCode::InvalidData;
+  }
+
+  if (out_header->header_size != sizeof(binaryIO::BinaryChunkHeader))
+  {
+    return IOStream_Seek(stream, out_header->header_size - sizeof(binaryIO::BinaryChunkHeader), binaryIO::SeekOrigin::CURRENT).ErrorCode();
+  }
+
+  return binaryIO::IOErrorCode::Success;
+}
+
+static bool ChunkIO_TOCEntryLess(const binaryIO::BinaryChunkTOCEntry& lhs, const binaryIO::BinaryChunkTOCEntry& rhs)
+{
+  return lhs.type_id.type_id != rhs.type_id.type_id ? lhs.type_id.type_id < rhs.type_id.type_id : lhs.offset < rhs.offset;
+}
+
+// ChunkTOCWriter
+
+void binaryIO::ChunkTOCWriter::addChunk(const BinaryChunkHeader& header, const IOSize offset, const std::uint32_t crc32_checksum)
+{
+  BinaryChunkTOCEntry entry = {};
+  entry.type_id             = header.type_id;
+  entry.version             = header.version;
+  entry.crc32_checksum      = crc32_checksum;
+  entry.offset              = offset;
+  entry.size                = header.sizeInfo();
+
+  entries.push_back(entry);
+}
+
+binaryIO::IOResult binaryIO::ChunkTOCWriter::write(IOStream* const stream)
+{
+  const IOResult toc_position = IOStream_Seek(stream, 0, SeekOrigin::CURRENT);
+
+  if (toc_position.ErrorCode() != IOErrorCode::Success)
+  {
+    return toc_position;
+  }
+
+  std::sort(entries.begin(), entries.end(), &ChunkIO_TOCEntryLess);
+
+  const BinaryChunkTOCTrailer trailer{toc_position.Value()};
+
+  const IOErrorCode toc_error = ChunkIO_WriteChunk(stream, k_ChunkTOCTypeID, k_ChunkTOCVersion, entries.data(), entries.size() * sizeof(BinaryChunkTOCEntry));
+
+  if (toc_error != IOErrorCode::Success)
+  {
+    return IOResult(toc_position.Value(), toc_error);
+  }
+
+  return IOResult(toc_position.Value(), ChunkIO_WriteChunk(stream, k_ChunkTOCTrailerTypeID, k_ChunkTOCVersion, &trailer, sizeof(trailer)));
+}
+
+// ChunkWriter
+
+static binaryIO::IOResult ChunkWriter_WriteData(binaryIO::ChunkWriter* const writer, const void* const bytes, const binaryIO::IOSize num_bytes);
+
+static binaryIO::IOResult ChunkWriter_PayloadWrite(binaryIO::IOStream* const stream, const void* const source, const binaryIO::IOSize num_source_bytes)
+{
+  return ChunkWriter_WriteData(static_cast<binaryIO::ChunkWriter*>(stream->user_data.values[0].as_handle), source, num_source_bytes);
+}
+
+static binaryIO::IOErrorCode ChunkWriter_AppendBuffered(binaryIO::ChunkWriter* const writer, const void* const bytes, const binaryIO::IOSize num_bytes)
+{
+  if (num_bytes > writer->max_buffered_bytes - writer->buffered_bytes.size())
+  {
+    return binaryIO::IOErrorCode::AllocationFailure;
+  }
+
+  try
+  {
+    const std::uint8_t* const bytes_bgn = static_cast<const std::uint8_t*>(bytes);
+
+    writer->buffered_bytes.insert(writer->buffered_bytes.end(), bytes_bgn, bytes_bgn + num_bytes);
+  }
+  catch (const std::bad_alloc&)
+  {
+    return binaryIO::IOErrorCode::AllocationFailure;
+  }
+
+  return binaryIO::IOErrorCode::Success;
+}
+
+//
+// Keeps the first error of the chunk being written, the stream's own `error_state`
+// may hold an unrelated error from before the chunk began.
+//
+static void ChunkWriter_AccumulateError(binaryIO::IOErrorCode* const result, const binaryIO::IOErrorCode error_code)
+{
+  if (*result == binaryIO::IOErrorCode::Success)
+  {
+    *result = error_code;
+  }
+}
+
+static binaryIO::IOResult ChunkWriter_WriteData(binaryIO::ChunkWriter* const writer, const void* const bytes, const binaryIO::IOSize num_bytes)
+{
+  crc32_addBytes(&writer->crc, bytes, num_bytes);
+  writer->header.data_size += num_bytes;
+
+  const binaryIO::IOResult result = writer->is_seekable ? IOStream_Write(writer->stream, bytes, num_bytes) :
+                                                          binaryIO::IOResult(num_bytes, ChunkWriter_AppendBuffered(writer, bytes, num_bytes));
+
+  ChunkWriter_AccumulateError(&writer->data_error, result.ErrorCode());
+
+  return result;
+}
+
+static constexpr binaryIO::IOSize k_ChunkWriterMaxHeaderSegments = 3u;
+
+//
+// Writes the header followed by each of the additional header segments,
+// for non seekable streams the additional header is buffered until `end`.
+//
+static binaryIO::IOErrorCode ChunkWriter_Begin(binaryIO::ChunkWriter* const       writer,
+                                               binaryIO::IOStream* const          stream,
+                                               const binaryIO::BinaryChunkTypeID& type_id,
+                                               const binaryIO::VersionType        version,
+                                               const binaryIO::IOConstSegment*    additional_header,
+                                               const binaryIO::IOSize             num_additional_header_segments,
+                                               const binaryIO::IOSize             max_buffered_bytes)
+{
+  binaryIOAssert(num_additional_header_segments <= k_ChunkWriterMaxHeaderSegments, "Too many additional header segments.");
+
+  binaryIO::IOSize additional_header_size = 0u;
+
+  for (binaryIO::IOSize i = 0u; i < num_additional_header_segments; ++i)
+  {
+    additional_header_size += additional_header[i].num_bytes;
+  }
+
+  binaryIOAssert(additional_header_size <= 0xFFFFu - sizeof(binaryIO::BinaryChunkHeader), "Header size must fit in a uint16_t.");
+
+  writer->stream             = stream;
+  writer->header             = binaryIO::BinaryChunkHeader(type_id, version, 0u, std::uint16_t(sizeof(binaryIO::BinaryChunkHeader) + additional_header_size));
+  writer->crc                = crc32_begin();
+  writer->max_buffered_bytes = max_buffered_bytes;
+  writer->is_compressed      = false;
+  writer->data_error         = binaryIO::IOErrorCode::Success;
+  writer->buffered_bytes.clear();
+
+  writer->payload                               = {};
+  writer->payload.Write                         = &ChunkWriter_PayloadWrite;
+  writer->payload.user_data.values[0].as_handle = writer;
+
+  const binaryIO::IOErrorCode previous_error = stream->error_state;
+  const binaryIO::IOResult    position       = IOSteam_SupportsSeek(stream) ? IOStream_Seek(stream, 0, binaryIO::SeekOrigin::CURRENT) : binaryIO::IOResult(binaryIO::IOErrorCode::InvalidOperation);
+
+  writer->is_seekable = position.ErrorCode() == binaryIO::IOErrorCode::Success;
+
+  if (writer->is_seekable)
+  {
+    writer->header_offset = position.Value();
+
+    binaryIO::IOConstSegment segments[k_ChunkWriterMaxHeaderSegments + 1u];
+
+    segments[0] = {&writer->header, sizeof(writer->header)};
+    std::copy(additional_header, additional_header + num_additional_header_segments, segments + 1);
+
+    return IOStream_WriteV(stream, segments, num_additional_header_segments + 1u).ErrorCode();
+  }
+
+  stream->error_state = previous_error;  // The failed tell is expected for non seekable streams.
+
+  for (binaryIO::IOSize i = 0u; i < num_additional_header_segments; ++i)
+  {
+    const binaryIO::IOErrorCode append_error = ChunkWriter_AppendBuffered(writer, additional_header[i].bytes, additional_header[i].num_bytes);
+
+    if (append_error != binaryIO::IOErrorCode::Success)
+    {
+      return append_error;
+    }
+  }
+
+  return binaryIO::IOErrorCode::Success;
+}
+
+binaryIO::IOErrorCode binaryIO::ChunkWriter::begin(IOStream* const          stream,
+                                                   const BinaryChunkTypeID& type_id,
+                                                   const VersionType        version,
+                                                   const void* const        additional_header,
+                                                   const std::uint16_t      additional_header_size,
+                                                   const IOSize             max_buffered_bytes)
+{
+  const IOConstSegment additional_header_segment = {additional_header, additional_header_size};
+
+  return ChunkWriter_Begin(this, stream, type_id, version, &additional_header_segment, 1u, max_buffered_bytes);
+}
+
+//
+// Totals the uncompressed size and records where each block starts, the compressing stream writes
+// every block with a single `IOStream_WriteV` whose first segment is the block's `CompressedBlockHeader`.
+//
+static binaryIO::IOResult ChunkWriter_CompressedDataWriteV(binaryIO::IOStream* const stream, const binaryIO::IOConstSegment* const segments, const binaryIO::IOSize num_segments)
+{
+  binaryIO::ChunkWriter* const writer = static_cast<binaryIO::ChunkWriter*>(stream->user_data.values[0].as_handle);
+
+  if (num_segments != 0u && segments[0].num_bytes == sizeof(binaryIO::CompressedBlockHeader))
+  {
+    const std::uint8_t* const header_bytes      = static_cast<const std::uint8_t*>(segments[0].bytes);
+    const std::uint32_t       uncompressed_size = binaryIO::detail::decodeXEndian<std::uint32_t>(header_bytes + offsetof(binaryIO::CompressedBlockHeader, uncompressed_size), [](const std::size_t i) { return i; });
+
+    if (writer->has_block_index)
+    {
+      // Only the last block may be short, a short block followed by another one breaks the index.
+      if (!writer->block_offsets.empty() && writer->block_error == binaryIO::IOErrorCode::Success && writer->block_offsets.size() * writer->block_index.block_size != writer->compression.uncompressed_size)
+      {
+        writer->block_error = binaryIO::IOErrorCode::InvalidOperation;
+      }
+
+      try
+      {
+        writer->block_offsets.push_back(writer->header.data_size);
+      }
+      catch (const std::bad_alloc&)
+      {
+        writer->block_error = binaryIO::IOErrorCode::AllocationFailure;
+      }
+    }
+
+    writer->compression.uncompressed_size += uncompressed_size;
+  }
+
+  binaryIO::IOSize num_written = 0u;
+
+  for (binaryIO::IOSize i = 0u; i < num_segments; ++i)
+  {
+    const binaryIO::IOResult result = ChunkWriter_WriteData(writer, segments[i].bytes, segments[i].num_bytes);
+
+    num_written += result.Value();
+
+    if (result.ErrorCode() != binaryIO::IOErrorCode::Success)
+    {
+      return binaryIO::IOResult(num_written, result.ErrorCode());
+    }
+  }
+
+  return num_written;
+}
+
+static binaryIO::IOErrorCode ChunkWriter_BeginCompressed(binaryIO::ChunkWriter* const       writer,
+                                                         binaryIO::IOStream* const          stream,
+                                                         const binaryIO::BinaryChunkTypeID& type_id,
+                                                         const binaryIO::VersionType        version,
+                                                         const binaryIO::IOCodec&           codec,
+                                                         const binaryIO::IOAllocator&       allocator,
+                                                         const binaryIO::IOSize             block_size,
+                                                         const void* const                  additional_header,
+                                                         const std::uint16_t                additional_header_size,
+                                                         const binaryIO::IOSize             max_buffered_bytes,
+                                                         binaryIO::Executor* const          executor,
+                                                         const bool                         has_block_index)
+{
+  writer->compression                   = {};
+  writer->compression.tag               = binaryIO::k_ChunkCompressionTag;
+  writer->compression.codec             = std::uint32_t(codec.codec);
+  writer->compression.uncompressed_size = 0u;  // Patched by `end`.
+
+  writer->block_index              = {};
+  writer->block_index.tag          = binaryIO::k_ChunkBlockIndexTag;
+  writer->block_index.block_size   = std::uint32_t(block_size);
+  writer->block_index.num_blocks   = 0u;  // Patched by `end`.
+  writer->block_index.table_offset = 0u;  // Patched by `end`.
+  writer->block_error              = binaryIO::IOErrorCode::Success;
+  writer->block_offsets.clear();
+
+  const binaryIO::IOConstSegment additional_header_segments[] =
+   {
+    {&writer->compression, sizeof(writer->compression)},
+    {&writer->block_index, has_block_index ? sizeof(writer->block_index) : 0u},
+    {additional_header, additional_header_size},
+   };
+
+  const binaryIO::IOErrorCode begin_error = ChunkWriter_Begin(writer, stream, type_id, version, additional_header_segments, sizeof(additional_header_segments) / sizeof(additional_header_segments[0]), max_buffered_bytes);
+
+  if (begin_error != binaryIO::IOErrorCode::Success)
+  {
+    return begin_error;
+  }
+
+  writer->compressed_data        = writer->payload;
+  writer->compressed_data.WriteV = &ChunkWriter_CompressedDataWriteV;
+  writer->has_block_index        = has_block_index;
+  writer->payload                = executor ? IOStream_FromParallelCompressor(&writer->compressed_data, codec, allocator, *executor, block_size) :
+                                              IOStream_FromCompressor(&writer->compressed_data, codec, allocator, block_size);
+  writer->is_compressed          = true;
+
+  return writer->payload.error_state;
+}
+
+binaryIO::IOErrorCode binaryIO::ChunkWriter::beginCompressed(IOStream* const          stream,
+                                                             const BinaryChunkTypeID& type_id,
+                                                             const VersionType        version,
+                                                             const IOCodec&           codec,
+                                                             const IOAllocator&       allocator,
+                                                             const IOSize             block_size,
+                                                             const void* const        additional_header,
+                                                             const std::uint16_t      additional_header_size,
+                                                             const IOSize             max_buffered_bytes,
+                                                             Executor* const          executor)
+{
+  return ChunkWriter_BeginCompressed(this, stream, type_id, version, codec, allocator, block_size, additional_header, additional_header_size, max_buffered_bytes, executor, false);
+}
+
+binaryIO::IOErrorCode binaryIO::ChunkWriter::beginCompressedSeekable(IOStream* const          stream,
+                                                                     const BinaryChunkTypeID& type_id,
+                                                                     const VersionType        version,
+                                                                     const IOCodec&           codec,
+                                                                     const IOAllocator&       allocator,
+                                                                     const IOSize             block_size,
+                                                                     const void* const        additional_header,
+                                                                     const std::uint16_t      additional_header_size,
+                                                                     const IOSize             max_buffered_bytes,
+                                                                     Executor* const          executor)
+{
+  return ChunkWriter_BeginCompressed(this, stream, type_id, version, codec, allocator, block_size, additional_header, additional_header_size, max_buffered_bytes, executor, true);
+}
+
+//
+// Appends the block offset table, entries are staged in small batches to convert them to little endian.
+//
+static void ChunkWriter_WriteBlockTable(binaryIO::ChunkWriter* const writer)
+{
+  binaryIO::BinaryChunkBlockIndexInfo* const block_index = &writer->block_index;
+
+  block_index->num_blocks   = writer->block_offsets.size();
+  block_index->table_offset = writer->header.data_size;
+
+  std::uint8_t     batch[64u * sizeof(std::uint64_t)];
+  binaryIO::IOSize num_batched = 0u;
+
+  for (binaryIO::IOSize i = 0u; i <= block_index->num_blocks; ++i)
+  {
+    const std::uint64_t offset = i != block_index->num_blocks ? writer->block_offsets[i] : block_index->table_offset;
+
+    binaryIO::detail::encodeXEndian(batch + num_batched, offset, [](const std::size_t i) { return i; });
+    num_batched += sizeof(offset);
+
+    if (num_batched == sizeof(batch) || i == block_index->num_blocks)
+    {
+      ChunkWriter_WriteData(writer, batch, num_batched);
+      num_batched = 0u;
+    }
+  }
+
+  writer->block_offsets.clear();
+  writer->block_offsets.shrink_to_fit();
+}
+
+binaryIO::IOResult binaryIO::ChunkWriter::write(const void* const bytes, const IOSize num_bytes)
+{
+  if (is_compressed)
+  {
+    return IOStream_Write(&payload, bytes, num_bytes);
+  }
+
+  return ChunkWriter_WriteData(this, bytes, num_bytes);
+}
+
+binaryIO::IOResult binaryIO::ChunkWriter::end(ChunkTOCWriter* const toc)
+{
+  IOErrorCode result = data_error;
+
+  if (is_compressed)
+  {
+    // Writes the last block through `compressed_data` which also totals `compression.uncompressed_size`.
+    const IOErrorCode close_error = IOStream_Close(&payload);
+
+    if (has_block_index)
+    {
+      ChunkWriter_WriteBlockTable(this);
+    }
+
+    ChunkWriter_AccumulateError(&result, close_error != IOErrorCode::Success ? close_error : payload.error_state != IOErrorCode::Success ? payload.error_state : block_error);
+    ChunkWriter_AccumulateError(&result, data_error);
+
+    if (!is_seekable)
+    {
+      std::memcpy(buffered_bytes.data(), &compression, sizeof(compression));
+
+      if (has_block_index)
+      {
+        std::memcpy(buffered_bytes.data() + sizeof(compression), &block_index, sizeof(block_index));
+      }
+    }
+  }
+
+  std::uint32_t final_crc = crc;
+  crc32_end(&final_crc);
+
+  const BinaryChunkFooter footer{final_crc};
+
+  if (is_seekable)
+  {
+    ChunkWriter_AccumulateError(&result, IOStream_Write(stream, &footer, sizeof(footer)).ErrorCode());
+
+    const IOResult end_position = IOStream_Seek(stream, 0, SeekOrigin::CURRENT);
+
+    ChunkWriter_AccumulateError(&result, end_position.ErrorCode());
+    ChunkWriter_AccumulateError(&result, IOStream_Seek(stream, IOOffset(header_offset + offsetof(BinaryChunkHeader, data_size)), SeekOrigin::BEGIN).ErrorCode());
+    ChunkWriter_AccumulateError(&result, IOStream_Write(stream, &header.data_size, sizeof(header.data_size)).ErrorCode());
+
+    if (is_compressed)
+    {
+      const IOConstSegment segments[] =
+       {
+        {&compression, sizeof(compression)},
+        {&block_index, has_block_index ? sizeof(block_index) : 0u},
+       };
+
+      ChunkWriter_AccumulateError(&result, IOStream_Seek(stream, IOOffset(header_offset + sizeof(BinaryChunkHeader)), SeekOrigin::BEGIN).ErrorCode());
+      ChunkWriter_AccumulateError(&result, IOStream_WriteV(stream, segments, sizeof(segments) / sizeof(segments[0])).ErrorCode());
+    }
+
+    ChunkWriter_AccumulateError(&result, IOStream_Seek(stream, IOOffset(end_position.Value()), SeekOrigin::BEGIN).ErrorCode());
+
+    if (toc && result == IOErrorCode::Success)
+    {
+      toc->addChunk(header, header_offset, final_crc);
+    }
+  }
+  else
+  {
+    const IOConstSegment segments[] =
+     {
+      {&header, sizeof(header)},
+      {buffered_bytes.data(), buffered_bytes.size()},
+      {&footer, sizeof(footer)},
+     };
+
+    ChunkWriter_AccumulateError(&result, IOStream_WriteV(stream, segments, sizeof(segments) / sizeof(segments[0])).ErrorCode());
+
+    buffered_bytes.clear();
+    buffered_bytes.shrink_to_fit();
+
+    // The chunk is still written, only its toc entry is skipped since the offset is unknown.
+    if (toc)
+    {
+      ChunkWriter_AccumulateError(&result, IOErrorCode::InvalidOperation);
+    }
+  }
+
+  payload         = {};
+  compressed_data = {};
+  is_compressed   = false;
+  has_block_index = false;
+
+  return IOResult(header.sizeInfo(), result);
+}
+
+// ChunkReader
+
+bool binaryIO::ChunkView::verifyChecksum() const
+{
+  return footer.crc32_checksum == ChunkIO_Checksum(data, header->data_size);
+}
+
+bool binaryIO::ChunkView::compressionInfo(BinaryChunkCompressionInfo* const out_info) const
+{
+  if (header->header_size < sizeof(BinaryChunkHeader) + sizeof(BinaryChunkCompressionInfo))
+  {
+    return false;
+  }
+
+  std::memcpy(out_info, additionalHeader(), sizeof(*out_info));
+
+  return out_info->tag == k_ChunkCompressionTag;
+}
+
+static constexpr binaryIO::IOSize k_ChunkReaderMinReadStep = 64u << 10;  //!< First step of the copy when the stream cannot report its size.
+
+static bool ChunkReader_IsValidHeader(const binaryIO::BinaryChunkHeader& header)
+{
+  return header.header_size >= sizeof(binaryIO::BinaryChunkHeader) &&
+         header.data_size <= ~std::uint64_t(0u) - header.sizeInfo(binaryIO::BinaryChunkParts::HeaderFooter);
+}
+
+binaryIO::IOErrorCode binaryIO::ChunkReader::next(ChunkView* const out_chunk)
+{
+  BufferedIO* const buffered_io = &stream->buffered_io;
+
+  if (buffered_io->cursor == buffered_io->buffer_end && IOSteam_SupportsBufferedRead(stream))
+  {
+    const IOErrorCode refill_error = BufferedIO_Refill(stream);
+
+    if (refill_error != IOErrorCode::Success)
+    {
+      return refill_error;
+    }
+  }
+
+  BinaryChunkHeader header;
+
+  // Fast path: the whole chunk is within the window, after a failed refill the window is a zero buffer so the
+  // slow path reports `IOErrorCode::EndOfStream` once no bytes are left rather than parsing it as a header.
+  const IOSize num_window_bytes = detail::readWindowSize(stream);
+
+  if (num_window_bytes >= sizeof(header))
+  {
+    std::memcpy(&header, buffered_io->cursor, sizeof(header));
+
+    if (!ChunkReader_IsValidHeader(header))
+    {
+      return IOErrorCode::InvalidData;
+    }
+
+    const bool is_aligned = reinterpret_cast<std::uintptr_t>(buffered_io->cursor) % alignof(BinaryChunkHeader) == 0u;
+
+    if (is_aligned && num_window_bytes >= header.sizeInfo())
+    {
+      const std::uint8_t* const chunk_bytes = buffered_io->cursor;
+
+      out_chunk->header  = reinterpret_cast<const BinaryChunkHeader*>(chunk_bytes);
+      out_chunk->data    = chunk_bytes + header.header_size;
+      out_chunk->is_copy = false;
+      std::memcpy(&out_chunk->footer, out_chunk->data + header.data_size, sizeof(out_chunk->footer));
+
+      buffered_io->cursor += header.sizeInfo();
+
+      return IOErrorCode::Success;
+    }
+  }
+
+  // Slow path: copy the chunk out of the stream.
+  const IOResult header_result = IOStream_Read(stream, &header, sizeof(header));
+
+  if (header_result.ErrorCode() != IOErrorCode::Success)
+  {
+    return header_result.Value() == 0u ? header_result.ErrorCode() : IOErrorCode::InvalidData;
+  }
+
+  if (!ChunkReader_IsValidHeader(header))
+  {
+    return IOErrorCode::InvalidData;
+  }
+
+  // The header is not verified yet so its size is checked against what the stream has left when it can report that,
+  // otherwise the buffer only grows as the bytes actually arrive.
+  const IOSize      num_chunk_bytes = header.sizeInfo(BinaryChunkParts::HeaderData);
+  const IOErrorCode previous_error  = stream->error_state;
+  const IOResult    remaining       = stream->Size && IOSteam_SupportsSeek(stream) ? IOStream_Remaining(stream) : IOResult(IOErrorCode::InvalidOperation);
+  const bool        is_size_known   = remaining.ErrorCode() == IOErrorCode::Success;
+
+  stream->error_state = previous_error;  // A failed size query is expected for pipes.
+
+  if (is_size_known && remaining.Value() < num_chunk_bytes - sizeof(header) + sizeof(out_chunk->footer))
+  {
+    return IOErrorCode::InvalidData;
+  }
+
+  IOSize num_copied_bytes = sizeof(header);
+
+  for (;;)
+  {
+    const IOSize num_step_bytes = is_size_known ? num_chunk_bytes : std::min(num_chunk_bytes, std::max(num_copied_bytes * 2u, k_ChunkReaderMinReadStep));
+
+    try
+    {
+      copy_buffer.resize(num_step_bytes);
+    }
+    catch (const std::bad_alloc&)
+    {
+      return IOErrorCode::AllocationFailure;
+    }
+    catch (...)
+    {
+      return IOErrorCode::UnknownError;
+    }
+
+    const IOResult step_result = IOStream_Read(stream, copy_buffer.data() + num_copied_bytes, num_step_bytes - num_copied_bytes);
+
+    if (step_result.ErrorCode() != IOErrorCode::Success)
+    {
+      return step_result.ErrorCode() == IOErrorCode::EndOfStream ? IOErrorCode::InvalidData : step_result.ErrorCode();
+    }
+
+    num_copied_bytes = num_step_bytes;
+
+    if (num_copied_bytes == num_chunk_bytes)
+    {
+      break;
+    }
+  }
+
+  std::memcpy(copy_buffer.data(), &header, sizeof(header));
+
+  const IOResult footer_result = IOStream_Read(stream, &out_chunk->footer, sizeof(out_chunk->footer));
+
+  if (footer_result.ErrorCode() != IOErrorCode::Success)
+  {
+    return footer_result.ErrorCode() == IOErrorCode::EndOfStream ? IOErrorCode::InvalidData : footer_result.ErrorCode();
+  }
+
+  out_chunk->header  = reinterpret_cast<const BinaryChunkHeader*>(copy_buffer.data());
+  out_chunk->data    = copy_buffer.data() + header.header_size;
+  out_chunk->is_copy = true;
+
+  return IOErrorCode::Success;
+}
+
+// ChunkTOC
+
+binaryIO::IOErrorCode binaryIO::ChunkTOC::load(IOStream* const stream)
+{
+  entries.clear();
+
+  // Read 1: The trailer chunk.
+
+  const IOResult trailer_position = IOStream_Seek(stream, -IOOffset(k_ChunkTOCTrailerChunkSize), SeekOrigin::END);
+
+  if (trailer_position.ErrorCode() != IOErrorCode::Success)
+  {
+    return trailer_position.ErrorCode() == IOErrorCode::SeekError ? IOErrorCode::InvalidData : trailer_position.ErrorCode();
+  }
+
+  std::uint8_t trailer_chunk[k_ChunkTOCTrailerChunkSize];
+
+  const IOErrorCode trailer_error = IOStream_Read(stream, trailer_chunk, sizeof(trailer_chunk)).ErrorCode();
+
+  if (trailer_error != IOErrorCode::Success)
+  {
+    return trailer_error;
+  }
+
+  BinaryChunkHeader     trailer_header;
+  BinaryChunkTOCTrailer trailer;
+  BinaryChunkFooter     trailer_footer;
+
+  std::memcpy(&trailer_header, trailer_chunk, sizeof(trailer_header));
+  std::memcpy(&trailer, trailer_chunk + sizeof(trailer_header), sizeof(trailer));
+  std::memcpy(&trailer_footer, trailer_chunk + sizeof(trailer_header) + sizeof(trailer), sizeof(trailer_footer));
+
+  if (trailer_header.type_id != k_ChunkTOCTrailerTypeID ||
+      trailer_header.header_size != sizeof(BinaryChunkHeader) ||
+      trailer_header.data_size != sizeof(BinaryChunkTOCTrailer) ||
+      trailer_footer.crc32_checksum != ChunkIO_Checksum(&trailer, sizeof(trailer)) ||
+      trailer.toc_offset >= trailer_position.Value())
+  {
+    return IOErrorCode::InvalidData;
+  }
+
+  // Read 2: The toc chunk.
+
+  const IOErrorCode toc_seek_error = IOStream_Seek(stream, IOOffset(trailer.toc_offset), SeekOrigin::BEGIN).ErrorCode();
+
+  if (toc_seek_error != IOErrorCode::Success)
+  {
+    return toc_seek_error;
+  }
+
+  BinaryChunkHeader toc_header;
+
+  const IOErrorCode toc_header_error = ChunkIO_ReadHeader(stream, &toc_header);
+
+  if (toc_header_error != IOErrorCode::Success)
+  {
+    return toc_header_error;
+  }
+
+  const std::uint64_t num_toc_bytes = trailer_position.Value() - trailer.toc_offset;
+
+  // The data size is bounded on its own first so that a crafted size cannot wrap `sizeInfo` around.
+  if (toc_header.type_id != k_ChunkTOCTypeID ||
+      toc_header.data_size % sizeof(BinaryChunkTOCEntry) != 0u ||
+      toc_header.data_size > num_toc_bytes ||
+      toc_header.sizeInfo() > num_toc_bytes)
+  {
+    return IOErrorCode::InvalidData;
+  }
+
+  entries.resize(toc_header.data_size / sizeof(BinaryChunkTOCEntry));
+
+  BinaryChunkFooter toc_footer;
+
+  IOErrorCode read_error = IOStream_Read(stream, entries.data(), toc_header.data_size).ErrorCode();
+
+  if (read_error == IOErrorCode::Success)
+  {
+    read_error = IOStream_Read(stream, &toc_footer, sizeof(toc_footer)).ErrorCode();
+  }
+
+  if (read_error != IOErrorCode::Success)
+  {
+    entries.clear();
+    return read_error;
+  }
+
+  if (toc_footer.crc32_checksum != ChunkIO_Checksum(entries.data(), toc_header.data_size))
+  {
+    entries.clear();
+    return IOErrorCode::InvalidData;
+  }
+
+  return IOErrorCode::Success;
+}
+
+const binaryIO::BinaryChunkTOCEntry* binaryIO::ChunkTOC::find(const BinaryChunkTypeID& type_id) const
+{
+  BinaryChunkTOCEntry key = {};
+  key.type_id             = type_id;
+  key.offset              = 0u;
+
+  const auto it = std::lower_bound(entries.begin(), entries.end(), key, &ChunkIO_TOCEntryLess);
+
+  return (it != entries.end() && it->type_id == type_id) ? &*it : nullptr;
+}
+
+binaryIO::IOResult binaryIO::ChunkTOC::seekToChunk(IOStream* const stream, const BinaryChunkTOCEntry& entry)
+{
+  return IOStream_Seek(stream, IOOffset(entry.offset), SeekOrigin::BEGIN);
+}
+
+/******************************************************************************/
+/*
+  MIT License
+
+  Copyright (c) 2024 Shareef Abdoul-Raheem
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+/******************************************************************************/
@@ -0,0 +1,740 @@
+/******************************************************************************/
+/*!
+ * @file   binary_chunk_patch.cpp
+ * @author Shareef Abdoul-Raheem (https://blufedora.github.io/)
+ * @date   2024-11-13
+ * @brief
+ *   Creation and application of chunk file patches.
+ *
+ * @copyright Copyright (c) 2024 Shareef Abdoul-Raheem
+ */
+/******************************************************************************/
+#include "binaryio/binary_chunk_patch.hpp"
+
+#include "binaryio/binary_span_stream.hpp"  // SpanReader, readLE, readVarUInt
+
+#include <algorithm>      // sort, lower_bound, min
+#include <cstring>        // memcmp, memcpy
+#include <new>            // bad_alloc
+#include <unordered_map>  // unordered_map
+#include <vector>         // vector
+
+static constexpr binaryIO::IOSize k_ChunkPatchCopySize  = 16u << 10;  //!< Bytes read at once while comparing, copying or storing literal data.
+static constexpr binaryIO::IOSize k_ChunkPatchBlockSize = 64u;        //!< Size of the blocks the rolling hash matches, a match costs about 8 bytes of ops.
+static constexpr binaryIO::IOSize k_ChunkPatchMergeGap  = 16u;        //!< Unchanged runs shorter than this stay inside of a `Data` op rather than starting another op.
+
+static binaryIO::IOErrorCode ChunkPatch_ReadAt(binaryIO::IOStream* const stream, const std::uint64_t offset, void* const destination, const binaryIO::IOSize num_bytes)
+{
+  if (binaryIO::IOSteam_SupportsReadAt(stream))
+  {
+    return binaryIO::IOStream_ReadAt(stream, binaryIO::IOSize(offset), destination, num_bytes).ErrorCode();
+  }
+
+  const binaryIO::IOResult seek_result = binaryIO::IOStream_Seek(stream, binaryIO::IOOffset(offset), binaryIO::SeekOrigin::BEGIN);
+
+  if (seek_result.ErrorCode() != binaryIO::IOErrorCode::Success)
+  {
+    return seek_result.ErrorCode();
+  }
+
+  return binaryIO::IOStream_Read(stream, destination, num_bytes).ErrorCode();
+}
+
+// Streams without `Size` are measured by seeking to the end.
+static binaryIO::IOResult ChunkPatch_StreamSize(binaryIO::IOStream* const stream)
+{
+  return stream->Size ? binaryIO::IOStream_Size(stream) : binaryIO::IOStream_Seek(stream, 0, binaryIO::SeekOrigin::END);
+}
+
+static std::uint32_t ChunkPatch_TOCChecksum(const binaryIO::ChunkTOC& toc)
+{
+  std::uint32_t crc = crc32_begin();
+  crc32_addBytes(&crc, toc.entries.data(), toc.entries.size() * sizeof(binaryIO::BinaryChunkTOCEntry));
+  crc32_end(&crc);
+
+  return crc;
+}
+
+static bool ChunkPatch_IsUnchanged(const binaryIO::BinaryChunkTOCEntry& source, const binaryIO::BinaryChunkTOCEntry& target)
+{
+  return source.type_id == target.type_id &&
+         source.version == target.version &&
+         source.size == target.size &&
+         source.crc32_checksum == target.crc32_checksum;
+}
+
+namespace
+{
+  // Buffers the op being built so that adjacent copies and literal runs become a single op.
+  struct ChunkPatchEmitter
+  {
+    binaryIO::IOStream*       out              = nullptr;
+    std::uint64_t             copy_destination = 0u;
+    std::uint64_t             copy_source      = 0u;
+    std::uint64_t             copy_size        = 0u;
+    std::uint64_t             data_destination = 0u;
+    std::vector<std::uint8_t> data             = {};
+    binaryIO::IOErrorCode     error            = binaryIO::IOErrorCode::Success;  //!< First failed write to `out`.
+
+    void accumulateError(const binaryIO::IOResult& result)
+    {
+      if (error == binaryIO::IOErrorCode::Success)
+      {
+        error = result.ErrorCode();
+      }
+    }
+
+    void writeOpHeader(const binaryIO::ChunkPatchOp kind, const std::uint64_t destination, const std::uint64_t size)
+    {
+      accumulateError(binaryIO::writeLE(out, std::uint8_t(kind)));
+      accumulateError(binaryIO::writeVarUInt(out, destination));
+      accumulateError(binaryIO::writeVarUInt(out, size));
+    }
+
+    void flushCopy()
+    {
+      if (copy_size != 0u)
+      {
+        writeOpHeader(binaryIO::ChunkPatchOp::Copy, copy_destination, copy_size);
+        accumulateError(binaryIO::writeVarUInt(out, copy_source));
+        copy_size = 0u;
+      }
+    }
+
+    void flushData()
+    {
+      if (!data.empty())
+      {
+        writeOpHeader(binaryIO::ChunkPatchOp::Data, data_destination, data.size());
+        accumulateError(binaryIO::IOStream_Write(out, data.data(), data.size()));
+        data.clear();
+      }
+    }
+
+    void flush()
+    {
+      flushCopy();
+      flushData();
+    }
+
+    void copy(const std::uint64_t destination, const std::uint64_t source, const std::uint64_t size)
+    {
+      if (size == 0u)
+      {
+        return;
+      }
+
+      flushData();
+
+      if (copy_size != 0u && copy_destination + copy_size == destination && copy_source + copy_size == source)
+      {
+        copy_size += size;
+        return;
+      }
+
+      flushCopy();
+
+      copy_destination = destination;
+      copy_source      = source;
+      copy_size        = size;
+    }
+
+    void literal(const std::uint64_t destination, const std::uint8_t* const bytes, const binaryIO::IOSize size)
+    {
+      if (size == 0u)
+      {
+        return;
+      }
+
+      flushCopy();
+
+      if (!data.empty() && data_destination + data.size() != destination)
+      {
+        flushData();
+      }
+
+      if (data.empty())
+      {
+        data_destination = destination;
+      }
+
+      data.insert(data.end(), bytes, bytes + size);
+    }
+  };
+
+  // Adler-32 style weak hash, both sums wrap so a rolled hash always equals the hash computed from scratch.
+  struct ChunkPatchRollingHash
+  {
+    std::uint32_t a = 0u;
+    std::uint32_t b = 0u;
+
+    void reset(const std::uint8_t* const bytes)
+    {
+      a = 0u;
+      b = 0u;
+
+      for (binaryIO::IOSize i = 0u; i < k_ChunkPatchBlockSize; ++i)
+      {
+        a += bytes[i];
+        b += std::uint32_t(k_ChunkPatchBlockSize - i) * bytes[i];
+      }
+    }
+
+    void roll(const std::uint8_t removed, const std::uint8_t added)
+    {
+      a += std::uint32_t(added) - removed;
+      b += a - std::uint32_t(k_ChunkPatchBlockSize) * removed;
+    }
+
+    std::uint32_t value() const { return (a & 0xFFFFu) | (b << 16u); }
+  };
+}  // namespace
+
+static binaryIO::IOErrorCode ChunkPatch_EmitLiteral(binaryIO::IOStream* const target, const std::uint64_t offset, const std::uint64_t size, ChunkPatchEmitter* const emitter)
+{
+  std::uint8_t target_block[k_ChunkPatchCopySize];
+
+  for (std::uint64_t num_done = 0u; num_done < size;)
+  {
+    const binaryIO::IOSize      num_bytes  = binaryIO::IOSize(std::min<std::uint64_t>(size - num_done, sizeof(target_block)));
+    const binaryIO::IOErrorCode read_error = ChunkPatch_ReadAt(target, offset + num_done, target_block, num_bytes);
+
+    if (read_error != binaryIO::IOErrorCode::Success)
+    {
+      return read_error;
+    }
+
+    emitter->literal(offset + num_done, target_block, num_bytes);
+    num_done += num_bytes;
+  }
+
+  return binaryIO::IOErrorCode::Success;
+}
+
+// Compares against the source at the same offsets, bytes past the end of the source always differ.
+static binaryIO::IOErrorCode ChunkPatch_EmitInPlaceDiff(binaryIO::IOStream* const source,
+                                                        const std::uint64_t       source_size,
+                                                        binaryIO::IOStream* const target,
+                                                        const std::uint64_t       offset,
+                                                        const std::uint64_t       size,
+                                                        ChunkPatchEmitter* const  emitter)
+{
+  std::uint8_t source_block[k_ChunkPatchCopySize];
+  std::uint8_t target_block[k_ChunkPatchCopySize];
+
+  for (std::uint64_t num_done = 0u; num_done < size;)
+  {
+    const std::uint64_t    position   = offset + num_done;
+    const binaryIO::IOSize num_bytes  = binaryIO::IOSize(std::min<std::uint64_t>(size - num_done, sizeof(target_block)));
+    const binaryIO::IOSize num_source = position < source_size ? binaryIO::IOSize(std::min<std::uint64_t>(num_bytes, source_size - position)) : 0u;
+
+    binaryIO::IOErrorCode read_error = ChunkPatch_ReadAt(target, position, target_block, num_bytes);
+
+    if (read_error == binaryIO::IOErrorCode::Success && num_source != 0u)
+    {
+      read_error = ChunkPatch_ReadAt(source, position, source_block, num_source);
+    }
+
+    if (read_error != binaryIO::IOErrorCode::Success)
+    {
+      return read_error;
+    }
+
+    binaryIO::IOSize i = 0u;
+
+    while (i < num_bytes)
+    {
+      while (i + 8u <= num_source && std::memcmp(source_block + i, target_block + i, 8u) == 0)
+      {
+        i += 8u;
+      }
+
+      while (i < num_source && source_block[i] == target_block[i])
+      {
+        ++i;
+      }
+
+      if (i == num_bytes)
+      {
+        break;
+      }
+
+      const binaryIO::IOSize change_start = i;
+      binaryIO::IOSize       change_end   = i + 1u;
+
+      for (binaryIO::IOSize j = change_end; j < num_bytes && j - change_end < k_ChunkPatchMergeGap; ++j)
+      {
+        if (j >= num_source || source_block[j] != target_block[j])
+        {
+          change_end = j + 1u;
+        }
+      }
+
+      emitter->literal(position + change_start, target_block + change_start, change_end - change_start);
+      i = change_end;
+    }
+
+    num_done += num_bytes;
+  }
+
+  return binaryIO::IOErrorCode::Success;
+}
+
+// Delta encodes a changed chunk against its previous version, copying every block of the source found in the target.
+static void ChunkPatch_EmitRollingDiff(const std::vector<std::uint8_t>& source,
+                                       const std::uint64_t              source_offset,
+                                       const std::vector<std::uint8_t>& target,
+                                       const std::uint64_t              target_offset,
+                                       ChunkPatchEmitter* const         emitter)
+{
+  constexpr binaryIO::IOSize k_BlockSize = k_ChunkPatchBlockSize;
+
+  if (source.size() < k_BlockSize || target.size() < k_BlockSize)
+  {
+    emitter->literal(target_offset, target.data(), target.size());
+    return;
+  }
+
+  std::unordered_map<std::uint32_t, binaryIO::IOSize> source_blocks;
+  source_blocks.reserve(source.size() / k_BlockSize);
+
+  ChunkPatchRollingHash hash;
+
+  for (binaryIO::IOSize offset = 0u; offset + k_BlockSize <= source.size(); offset += k_BlockSize)
+  {
+    hash.reset(source.data() + offset);
+    source_blocks.emplace(hash.value(), offset);
+  }
+
+  binaryIO::IOSize i             = 0u;
+  binaryIO::IOSize literal_start = 0u;
+
+  hash.reset(target.data());
+
+  while (i + k_BlockSize <= target.size())
+  {
+    const auto match = source_blocks.find(hash.value());
+
+    if (match != source_blocks.end() && std::memcmp(source.data() + match->second, target.data() + i, k_BlockSize) == 0)
+    {
+      const binaryIO::IOSize match_source = match->second;
+      binaryIO::IOSize       match_size   = k_BlockSize;
+
+      while (i + match_size < target.size() && match_source + match_size < source.size() && target[i + match_size] == source[match_source + match_size])
+      {
+        ++match_size;
+      }
+
+      emitter->literal(target_offset + literal_start, target.data() + literal_start, i - literal_start);
+      emitter->copy(target_offset + i, source_offset + match_source, match_size);
+
+      i += match_size;
+      literal_start = i;
+
+      if (i + k_BlockSize <= target.size())
+      {
+        hash.reset(target.data() + i);
+      }
+
+      continue;
+    }
+
+    if (i + k_BlockSize < target.size())
+    {
+      hash.roll(target[i], target[i + k_BlockSize]);
+    }
+
+    ++i;
+  }
+
+  emitter->literal(target_offset + literal_start, target.data() + literal_start, target.size() - literal_start);
+}
+
+static binaryIO::IOErrorCode ChunkPatch_ReadEntry(binaryIO::IOStream* const stream, const binaryIO::BinaryChunkTOCEntry& entry, std::vector<std::uint8_t>* const out_bytes)
+{
+  out_bytes->resize(std::size_t(entry.size));
+
+  return ChunkPatch_ReadAt(stream, entry.offset, out_bytes->data(), out_bytes->size());
+}
+
+// Pairs each target chunk with the source chunk it replaces.
+//   Rebuild : the source chunk of the same type that appears in the same order within that type.
+//   InPlace : the source chunk at the same offset.
+static std::vector<const binaryIO::BinaryChunkTOCEntry*> ChunkPatch_MatchChunks(const binaryIO::ChunkTOC& source_toc, const binaryIO::ChunkTOC& target_toc, const binaryIO::ChunkPatchMode mode)
+{
+  const std::vector<binaryIO::BinaryChunkTOCEntry>& sources = source_toc.entries;
+  const std::vector<binaryIO::BinaryChunkTOCEntry>& targets = target_toc.entries;
+
+  std::vector<const binaryIO::BinaryChunkTOCEntry*> result(targets.size(), nullptr);
+
+  if (mode == binaryIO::ChunkPatchMode::InPlace)
+  {
+    std::vector<const binaryIO::BinaryChunkTOCEntry*> sources_by_offset(sources.size());
+
+    for (std::size_t i = 0u; i < sources.size(); ++i)
+    {
+      sources_by_offset[i] = &sources[i];
+    }
+
+    std::sort(sources_by_offset.begin(), sources_by_offset.end(), [](const binaryIO::BinaryChunkTOCEntry* const lhs, const binaryIO::BinaryChunkTOCEntry* const rhs) {
+      return lhs->offset < rhs->offset;
+    });
+
+    for (std::size_t i = 0u; i < targets.size(); ++i)
+    {
+      const auto it = std::lower_bound(sources_by_offset.begin(), sources_by_offset.end(), targets[i].offset, [](const binaryIO::BinaryChunkTOCEntry* const lhs, const std::uint64_t offset) {
+        return lhs->offset < offset;
+      });
+
+      if (it != sources_by_offset.end() && (*it)->offset == targets[i].offset)
+      {
+        result[i] = *it;
+      }
+    }
+
+    return result;
+  }
+
+  // Both tocs are sorted by (type, offset) so each type is a run in both.
+  std::size_t source_index = 0u;
+
+  for (std::size_t target_index = 0u; target_index < targets.size();)
+  {
+    const binaryIO::ChunkTypeID type_id = targets[target_index].type_id.type_id;
+
+    while (source_index < sources.size() && sources[source_index].type_id.type_id < type_id)
+    {
+      ++source_index;
+    }
+
+    for (; target_index < targets.size() && targets[target_index].type_id.type_id == type_id; ++target_index)
+    {
+      if (source_index < sources.size() && sources[source_index].type_id.type_id == type_id)
+      {
+        result[target_index] = &sources[source_index++];
+      }
+    }
+  }
+
+  return result;
+}
+
+static binaryIO::IOErrorCode ChunkPatch_EmitOps(binaryIO::IOStream* const      source,
+                                                const binaryIO::ChunkTOC&      source_toc,
+                                                const std::uint64_t            source_size,
+                                                binaryIO::IOStream* const      target,
+                                                const binaryIO::ChunkTOC&      target_toc,
+                                                const std::uint64_t            target_size,
+                                                const binaryIO::ChunkPatchMode mode,
+                                                ChunkPatchEmitter* const       emitter)
+{
+  const bool is_in_place = mode == binaryIO::ChunkPatchMode::InPlace;
+
+  const std::vector<const binaryIO::BinaryChunkTOCEntry*> matches = ChunkPatch_MatchChunks(source_toc, target_toc, mode);
+
+  std::vector<std::size_t> target_order(target_toc.entries.size());
+
+  for (std::size_t i = 0u; i < target_order.size(); ++i)
+  {
+    target_order[i] = i;
+  }
+
+  std::sort(target_order.begin(), target_order.end(), [&target_toc](const std::size_t lhs, const std::size_t rhs) {
+    return target_toc.entries[lhs].offset < target_toc.entries[rhs].offset;
+  });
+
+  // Everything that is not a listed chunk, such as the toc itself.
+  const auto emit_gap = [&](const std::uint64_t offset, const std::uint64_t size) {
+    return is_in_place ? ChunkPatch_EmitInPlaceDiff(source, source_size, target, offset, size, emitter) : ChunkPatch_EmitLiteral(target, offset, size, emitter);
+  };
+
+  std::vector<std::uint8_t> source_bytes = {};
+  std::vector<std::uint8_t> target_bytes = {};
+  std::uint64_t             position     = 0u;
+
+  for (const std::size_t index : target_order)
+  {
+    const binaryIO::BinaryChunkTOCEntry&       entry = target_toc.entries[index];
+    const binaryIO::BinaryChunkTOCEntry* const match = matches[index];
+
+    if (entry.offset < position || entry.size > target_size - entry.offset)
+    {
+      return binaryIO::IOErrorCode::InvalidData;
+    }
+
+    binaryIO::IOErrorCode error = emit_gap(position, entry.offset - position);
+
+    if (error == binaryIO::IOErrorCode::Success)
+    {
+      if (match && ChunkPatch_IsUnchanged(*match, entry))
+      {
+        if (!is_in_place)
+        {
+          emitter->copy(entry.offset, match->offset, entry.size);
+        }
+      }
+      else if (is_in_place)
+      {
+        error = ChunkPatch_EmitInPlaceDiff(source, source_size, target, entry.offset, entry.size, emitter);
+      }
+      else if (match)
+      {
+        error = ChunkPatch_ReadEntry(source, *match, &source_bytes);
+
+        if (error == binaryIO::IOErrorCode::Success)
+        {
+          error = ChunkPatch_ReadEntry(target, entry, &target_bytes);
+        }
+
+        if (error == binaryIO::IOErrorCode::Success)
+        {
+          ChunkPatch_EmitRollingDiff(source_bytes, match->offset, target_bytes, entry.offset, emitter);
+        }
+      }
+      else
+      {
+        error = ChunkPatch_EmitLiteral(target, entry.offset, entry.size, emitter);
+      }
+    }
+
+    if (error != binaryIO::IOErrorCode::Success)
+    {
+      return error;
+    }
+
+    position = entry.offset + entry.size;
+  }
+
+  return emit_gap(position, target_size - position);
+}
+
+binaryIO::IOResult binaryIO::ChunkPatch_Create(IOStream* const       source,
+                                               IOStream* const       target,
+                                               IOStream* const       patch,
+                                               const ChunkPatchMode  mode,
+                                               ChunkTOCWriter* const toc)
+{
+  ChunkTOC          source_toc;
+  ChunkTOC          target_toc;
+  const IOErrorCode source_toc_error = source_toc.load(source);
+
+  if (source_toc_error != IOErrorCode::Success)
+  {
+    return source_toc_error;
+  }
+
+  const IOErrorCode target_toc_error = target_toc.load(target);
+
+  if (target_toc_error != IOErrorCode::Success)
+  {
+    return target_toc_error;
+  }
+
+  const IOResult source_size = ChunkPatch_StreamSize(source);
+  const IOResult target_size = ChunkPatch_StreamSize(target);
+
+  if (source_size.ErrorCode() != IOErrorCode::Success || target_size.ErrorCode() != IOErrorCode::Success)
+  {
+    return source_size.ErrorCode() != IOErrorCode::Success ? source_size.ErrorCode() : target_size.ErrorCode();
+  }
+
+  const BinaryChunkPatchInfo info = {source_size.Value(), target_size.Value(), ChunkPatch_TOCChecksum(source_toc), mode};
+
+  ChunkWriter       writer;
+  const IOErrorCode begin_error = writer.begin(patch, k_ChunkPatchTypeID, k_ChunkPatchVersion, &info, sizeof(info));
+
+  if (begin_error != IOErrorCode::Success)
+  {
+    return begin_error;
+  }
+
+  ChunkPatchEmitter emitter = {};
+  emitter.out               = &writer.payload;
+
+  IOErrorCode ops_error;
+
+  try
+  {
+    ops_error = ChunkPatch_EmitOps(source, source_toc, info.source_size, target, target_toc, info.target_size, mode, &emitter);
+    emitter.flush();
+
+    if (ops_error == IOErrorCode::Success)
+    {
+      ops_error = emitter.error;
+    }
+  }
+  catch (const std::bad_alloc&)
+  {
+    ops_error = IOErrorCode::AllocationFailure;
+  }
+
+  const IOResult end_result = writer.end(toc);
+
+  return ops_error != IOErrorCode::Success ? IOResult(ops_error) : end_result;
+}
+
+binaryIO::IOResult binaryIO::ChunkPatch_Apply(IOStream* const source, const ChunkView& patch, IOStream* const destination)
+{
+  BinaryChunkPatchInfo info;
+
+  if (patch.header->type_id != k_ChunkPatchTypeID || patch.header->header_size < sizeof(BinaryChunkHeader) + sizeof(info) || !patch.verifyChecksum())
+  {
+    return IOErrorCode::InvalidData;
+  }
+
+  std::memcpy(&info, patch.additionalHeader(), sizeof(info));
+
+  // Only the same stream object counts as in place, an `InPlace` patch skips the unchanged bytes so a separate destination would be left incomplete.
+  const bool is_in_place = source == destination;
+
+  if (is_in_place != (info.mode == ChunkPatchMode::InPlace))
+  {
+    return IOErrorCode::InvalidOperation;
+  }
+
+  // Verifies the source before anything is written.
+  ChunkTOC          source_toc;
+  const IOErrorCode source_toc_error = source_toc.load(source);
+
+  if (source_toc_error != IOErrorCode::Success)
+  {
+    return source_toc_error;
+  }
+
+  const IOResult source_size = ChunkPatch_StreamSize(source);
+
+  if (source_size.ErrorCode() != IOErrorCode::Success)
+  {
+    return source_size.ErrorCode();
+  }
+
+  if (source_size.Value() != info.source_size || ChunkPatch_TOCChecksum(source_toc) != info.source_toc_crc32)
+  {
+    return IOErrorCode::InvalidData;
+  }
+
+  // Offsets are from the start of `destination`, non seekable destinations only work with the front to back `Rebuild` ops.
+  std::uint64_t destination_position = 0u;
+
+  if (IOSteam_SupportsSeek(destination))
+  {
+    const IOResult seek_result = IOStream_Seek(destination, 0, SeekOrigin::BEGIN);
+
+    if (seek_result.ErrorCode() != IOErrorCode::Success)
+    {
+      return seek_result.ErrorCode();
+    }
+  }
+
+  SpanReader   ops = {patch.data, IOSize(patch.header->data_size)};
+  std::uint8_t copy_block[k_ChunkPatchCopySize];
+
+  while (ops.bytesLeft() != 0u)
+  {
+    std::uint8_t  kind           = 0u;
+    std::uint64_t op_destination = 0u;
+    std::uint64_t op_size        = 0u;
+
+    readLE(&ops, &kind);
+    readVarUInt(&ops, &op_destination);
+    readVarUInt(&ops, &op_size);
+
+    if (ops.error_state != IOErrorCode::Success || op_destination > info.target_size || op_size > info.target_size - op_destination)
+    {
+      return IOErrorCode::InvalidData;
+    }
+
+    if (op_destination != destination_position)
+    {
+      const IOResult seek_result = IOStream_Seek(destination, IOOffset(op_destination), SeekOrigin::BEGIN);
+
+      if (seek_result.ErrorCode() != IOErrorCode::Success)
+      {
+        return seek_result.ErrorCode();
+      }
+
+      destination_position = op_destination;
+    }
+
+    if (kind == std::uint8_t(ChunkPatchOp::Data))
+    {
+      const std::uint8_t* const bytes = ops.consume(IOSize(op_size));
+
+      if (!bytes)
+      {
+        return IOErrorCode::InvalidData;
+      }
+
+      const IOErrorCode write_error = IOStream_Write(destination, bytes, IOSize(op_size)).ErrorCode();
+
+      if (write_error != IOErrorCode::Success)
+      {
+        return write_error;
+      }
+    }
+    else if (kind == std::uint8_t(ChunkPatchOp::Copy) && !is_in_place)
+    {
+      std::uint64_t op_source = 0u;
+      readVarUInt(&ops, &op_source);
+
+      if (ops.error_state != IOErrorCode::Success || op_source > info.source_size || op_size > info.source_size - op_source)
+      {
+        return IOErrorCode::InvalidData;
+      }
+
+      for (std::uint64_t num_copied = 0u; num_copied < op_size;)
+      {
+        const IOSize      num_bytes  = IOSize(std::min<std::uint64_t>(op_size - num_copied, sizeof(copy_block)));
+        const IOErrorCode read_error = ChunkPatch_ReadAt(source, op_source + num_copied, copy_block, num_bytes);
+
+        if (read_error != IOErrorCode::Success)
+        {
+          return read_error;
+        }
+
+        const IOErrorCode write_error = IOStream_Write(destination, copy_block, num_bytes).ErrorCode();
+
+        if (write_error != IOErrorCode::Success)
+        {
+          return write_error;
+        }
+
+        num_copied += num_bytes;
+      }
+    }
+    else
+    {
+      return IOErrorCode::InvalidData;
+    }
+
+    destination_position += op_size;
+  }
+
+  return IOResult(IOSize(info.target_size), IOErrorCode::Success);
+}
+
+/******************************************************************************/
+/*
+  MIT License
+
+  Copyright (c) 2024 Shareef Abdoul-Raheem
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+/******************************************************************************/
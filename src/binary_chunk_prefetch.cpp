@@ -0,0 +1,394 @@
+/******************************************************************************/
+/*!
+ * @file   binary_chunk_prefetch.cpp
+ * @author Shareef Abdoul-Raheem (https://blufedora.github.io/)
+ * @date   2024-11-12
+ * @brief
+ *   Access tracing, prefetch plans and the chunk reordering tool for chunk files.
+ *
+ * @copyright Copyright (c) 2024 Shareef Abdoul-Raheem
+ */
+/******************************************************************************/
+#include "binaryio/binary_chunk_prefetch.hpp"
+
+#include "binaryio/binary_stream_ext.hpp"  // IOStream_AdviseWillNeed
+
+#include <algorithm>  // sort, stable_sort, lower_bound, min, max
+#include <new>        // bad_alloc
+
+// ChunkAccessTrace
+
+binaryIO::IOResult binaryIO::ChunkAccessTrace::seekToChunk(IOStream* const stream, const BinaryChunkTOCEntry& entry)
+{
+  record(entry);
+
+  return ChunkTOC::seekToChunk(stream, entry);
+}
+
+// ChunkPrefetchPlan
+
+static bool ChunkPrefetch_EntryOffsetLess(const binaryIO::BinaryChunkTOCEntry& lhs, const binaryIO::BinaryChunkTOCEntry& rhs)
+{
+  return lhs.offset < rhs.offset;
+}
+
+static bool ChunkPrefetch_EntryOffsetLessValue(const binaryIO::BinaryChunkTOCEntry& lhs, const std::uint64_t offset)
+{
+  return lhs.offset < offset;
+}
+
+// Returns the entries of `trace` with revisits removed, keeping the first access of each chunk.
+static std::vector<binaryIO::BinaryChunkTOCEntry> ChunkPrefetch_FirstAccesses(const binaryIO::ChunkAccessTrace& trace)
+{
+  std::vector<binaryIO::BinaryChunkTOCEntry> visited = trace.accesses;
+  std::vector<binaryIO::BinaryChunkTOCEntry> result  = {};
+
+  std::stable_sort(visited.begin(), visited.end(), &ChunkPrefetch_EntryOffsetLess);
+
+  std::vector<bool> is_emitted(visited.size(), false);
+
+  for (const binaryIO::BinaryChunkTOCEntry& access : trace.accesses)
+  {
+    const std::size_t index = std::size_t(std::lower_bound(visited.begin(), visited.end(), access.offset, &ChunkPrefetch_EntryOffsetLessValue) - visited.begin());
+
+    if (!is_emitted[index])
+    {
+      is_emitted[index] = true;
+      result.push_back(access);
+    }
+  }
+
+  return result;
+}
+
+void binaryIO::ChunkPrefetchPlan::build(const ChunkAccessTrace& trace, const IOSize max_gap_bytes)
+{
+  ranges.clear();
+
+  for (const BinaryChunkTOCEntry& access : ChunkPrefetch_FirstAccesses(trace))
+  {
+    if (!ranges.empty())
+    {
+      ChunkPrefetchRange& previous     = ranges.back();
+      const std::uint64_t previous_end = previous.offset + previous.size;
+
+      if (access.offset >= previous_end && access.offset - previous_end <= max_gap_bytes)
+      {
+        previous.size = access.offset + access.size - previous.offset;
+        continue;
+      }
+    }
+
+    ranges.push_back(ChunkPrefetchRange{access.offset, access.size});
+  }
+}
+
+binaryIO::IOSize binaryIO::ChunkPrefetchPlan::totalBytes() const
+{
+  IOSize result = 0u;
+
+  for (const ChunkPrefetchRange& range : ranges)
+  {
+    result += range.size;
+  }
+
+  return result;
+}
+
+binaryIO::IOResult binaryIO::ChunkPrefetchPlan::write(IOStream* const stream, ChunkTOCWriter* const toc) const
+{
+  ChunkWriter       writer;
+  const IOErrorCode begin_error = writer.begin(stream, k_ChunkPrefetchPlanTypeID, k_ChunkPrefetchPlanVersion);
+
+  if (begin_error != IOErrorCode::Success)
+  {
+    return begin_error;
+  }
+
+  for (const ChunkPrefetchRange& range : ranges)
+  {
+    writeLE(&writer.payload, range.offset);
+    writeLE(&writer.payload, range.size);
+  }
+
+  return writer.end(toc);
+}
+
+binaryIO::IOErrorCode binaryIO::ChunkPrefetchPlan::load(const ChunkView& chunk)
+{
+  ranges.clear();
+
+  if (chunk.header->type_id != k_ChunkPrefetchPlanTypeID || chunk.header->data_size % sizeof(ChunkPrefetchRange) != 0u)
+  {
+    return IOErrorCode::InvalidData;
+  }
+
+  IOStream plan_data = IOStream_FromROMemory(chunk.data, IOSize(chunk.header->data_size));
+
+  try
+  {
+    ranges.resize(std::size_t(chunk.header->data_size / sizeof(ChunkPrefetchRange)));
+  }
+  catch (const std::bad_alloc&)
+  {
+    return IOErrorCode::AllocationFailure;
+  }
+
+  for (ChunkPrefetchRange& range : ranges)
+  {
+    readLE(&plan_data, &range.offset);
+    readLE(&plan_data, &range.size);
+  }
+
+  return plan_data.error_state;
+}
+
+// ChunkPrefetcher
+
+binaryIO::IOErrorCode binaryIO::ChunkPrefetcher::advance(const std::uint64_t offset)
+{
+  const std::vector<ChunkPrefetchRange>& ranges = plan->ranges;
+
+  // The load normally moves forward through the plan so the search starts from the current range.
+  std::size_t reached_range = current_range;
+
+  while (reached_range < ranges.size() && !(offset >= ranges[reached_range].offset && offset - ranges[reached_range].offset < ranges[reached_range].size))
+  {
+    ++reached_range;
+  }
+
+  if (reached_range == ranges.size())
+  {
+    return IOErrorCode::Success;
+  }
+
+  for (; current_range < reached_range; ++current_range)
+  {
+    if (current_range < next_range)
+    {
+      hinted_bytes -= ranges[current_range].size;
+    }
+  }
+
+  next_range = std::max(next_range, current_range);
+
+  IOErrorCode result = IOErrorCode::Success;
+
+  while (next_range < ranges.size() && hinted_bytes < lookahead_bytes)
+  {
+    const ChunkPrefetchRange& range        = ranges[next_range];
+    const IOErrorCode         advise_error = IOStream_AdviseWillNeed(stream, IOSize(range.offset), IOSize(range.size));
+
+    if (result == IOErrorCode::Success)
+    {
+      result = advise_error;
+    }
+
+    hinted_bytes += range.size;
+    ++next_range;
+  }
+
+  return result;
+}
+
+binaryIO::IOResult binaryIO::ChunkPrefetcher::seekToChunk(const BinaryChunkTOCEntry& entry)
+{
+  advance(entry.offset);
+
+  return ChunkTOC::seekToChunk(stream, entry);
+}
+
+// ChunkFile_Reorder
+
+static constexpr binaryIO::IOSize k_ChunkReorderCopySize      = 16u << 10;
+static constexpr binaryIO::IOSize k_ChunkPaddingChunkOverhead = sizeof(binaryIO::BinaryChunkHeader) + sizeof(binaryIO::BinaryChunkFooter);
+
+static binaryIO::IOErrorCode ChunkReorder_WritePadding(binaryIO::IOStream* const destination, const std::uint64_t position, const std::uint64_t original_offset, std::uint64_t* const out_num_bytes)
+{
+  static constexpr std::uint8_t s_Zeros[binaryIO::k_ChunkReorderAlignment] = {};
+
+  constexpr std::uint64_t k_Alignment = binaryIO::k_ChunkReorderAlignment;
+
+  *out_num_bytes = 0u;
+
+  if (position % k_Alignment == original_offset % k_Alignment)
+  {
+    return binaryIO::IOErrorCode::Success;
+  }
+
+  // The smallest chunk is a header and a footer so the padding is at least that plus the bytes needed to line up.
+  const std::uint64_t num_data_bytes = (original_offset + 2u * k_Alignment - position % k_Alignment - k_ChunkPaddingChunkOverhead % k_Alignment) % k_Alignment;
+
+  binaryIO::ChunkWriter       writer;
+  const binaryIO::IOErrorCode begin_error = writer.begin(destination, binaryIO::k_ChunkPaddingTypeID, binaryIO::k_ChunkPaddingVersion);
+
+  if (begin_error != binaryIO::IOErrorCode::Success)
+  {
+    return begin_error;
+  }
+
+  writer.write(s_Zeros, binaryIO::IOSize(num_data_bytes));
+
+  const binaryIO::IOResult end_result = writer.end();
+
+  *out_num_bytes = end_result.Value();
+
+  return end_result.ErrorCode();
+}
+
+static binaryIO::IOErrorCode ChunkReorder_CopyChunk(binaryIO::IOStream* const source, binaryIO::IOStream* const destination, const binaryIO::BinaryChunkTOCEntry& entry)
+{
+  const bool has_read_at = binaryIO::IOSteam_SupportsReadAt(source);
+
+  if (!has_read_at)
+  {
+    const binaryIO::IOResult seek_result = binaryIO::ChunkTOC::seekToChunk(source, entry);
+
+    if (seek_result.ErrorCode() != binaryIO::IOErrorCode::Success)
+    {
+      return seek_result.ErrorCode();
+    }
+  }
+
+  std::uint8_t copy_buffer[k_ChunkReorderCopySize];
+
+  for (std::uint64_t num_copied = 0u; num_copied < entry.size;)
+  {
+    const binaryIO::IOSize   num_bytes   = binaryIO::IOSize(std::min<std::uint64_t>(entry.size - num_copied, sizeof(copy_buffer)));
+    const binaryIO::IOResult read_result = has_read_at ? binaryIO::IOStream_ReadAt(source, binaryIO::IOSize(entry.offset + num_copied), copy_buffer, num_bytes) :
+                                                         binaryIO::IOStream_Read(source, copy_buffer, num_bytes);
+
+    if (read_result.ErrorCode() != binaryIO::IOErrorCode::Success)
+    {
+      return read_result.ErrorCode() == binaryIO::IOErrorCode::EndOfStream ? binaryIO::IOErrorCode::InvalidData : read_result.ErrorCode();
+    }
+
+    const binaryIO::IOResult write_result = binaryIO::IOStream_Write(destination, copy_buffer, num_bytes);
+
+    if (write_result.ErrorCode() != binaryIO::IOErrorCode::Success)
+    {
+      return write_result.ErrorCode();
+    }
+
+    num_copied += num_bytes;
+  }
+
+  return binaryIO::IOErrorCode::Success;
+}
+
+binaryIO::IOErrorCode binaryIO::ChunkFile_Reorder(IOStream* const          source,
+                                                  const ChunkTOC&          toc,
+                                                  const ChunkAccessTrace&  trace,
+                                                  IOStream* const          destination,
+                                                  ChunkPrefetchPlan* const out_plan)
+{
+  // The toc is sorted by type, the untouched chunks are written in file order.
+  std::vector<BinaryChunkTOCEntry> remaining = toc.entries;
+  std::vector<BinaryChunkTOCEntry> order     = {};
+
+  std::sort(remaining.begin(), remaining.end(), &ChunkPrefetch_EntryOffsetLess);
+
+  std::vector<bool> is_touched(remaining.size(), false);
+
+  for (const BinaryChunkTOCEntry& access : ChunkPrefetch_FirstAccesses(trace))
+  {
+    const auto it = std::lower_bound(remaining.begin(), remaining.end(), access.offset, &ChunkPrefetch_EntryOffsetLessValue);
+
+    if (it != remaining.end() && it->offset == access.offset)
+    {
+      is_touched[std::size_t(it - remaining.begin())] = true;
+      order.push_back(*it);
+    }
+  }
+
+  const std::size_t num_touched = order.size();
+
+  for (std::size_t i = 0u; i < remaining.size(); ++i)
+  {
+    if (!is_touched[i])
+    {
+      order.push_back(remaining[i]);
+    }
+  }
+
+  const IOResult start_position = IOStream_Seek(destination, 0, SeekOrigin::CURRENT);
+
+  if (start_position.ErrorCode() != IOErrorCode::Success)
+  {
+    return start_position.ErrorCode();
+  }
+
+  ChunkTOCWriter   new_toc  = {};
+  ChunkAccessTrace new_run  = {};
+  std::uint64_t    position = start_position.Value();
+
+  for (std::size_t i = 0u; i < order.size(); ++i)
+  {
+    const BinaryChunkTOCEntry& entry = order[i];
+
+    std::uint64_t     num_padding_bytes;
+    const IOErrorCode padding_error = ChunkReorder_WritePadding(destination, position, entry.offset, &num_padding_bytes);
+
+    if (padding_error != IOErrorCode::Success)
+    {
+      return padding_error;
+    }
+
+    position += num_padding_bytes;
+
+    const IOErrorCode copy_error = ChunkReorder_CopyChunk(source, destination, entry);
+
+    if (copy_error != IOErrorCode::Success)
+    {
+      return copy_error;
+    }
+
+    BinaryChunkTOCEntry moved_entry = entry;
+    moved_entry.offset              = position;
+
+    new_toc.entries.push_back(moved_entry);
+
+    if (i < num_touched)
+    {
+      new_run.record(moved_entry);
+    }
+
+    position += entry.size;
+  }
+
+  const IOErrorCode toc_error = new_toc.write(destination).ErrorCode();
+
+  if (out_plan && toc_error == IOErrorCode::Success)
+  {
+    // Padding chunks are the only gaps in the run.
+    out_plan->build(new_run, k_ChunkReorderAlignment + k_ChunkPaddingChunkOverhead);
+  }
+
+  return toc_error;
+}
+
+/******************************************************************************/
+/*
+  MIT License
+
+  Copyright (c) 2024 Shareef Abdoul-Raheem
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+/******************************************************************************/
@@ -0,0 +1,1274 @@
+/******************************************************************************/
+/*!
+ * @file   binary_compression.cpp
+ * @author Shareef Abdoul-Raheem (https://blufedora.github.io/)
+ * @date   2024-11-08
+ * @brief
+ *   Implementation of the built in codecs and the compressing / decompressing streams.
+ *
+ * @copyright Copyright (c) 2024 Shareef Abdoul-Raheem
+ */
+/******************************************************************************/
+#include "binaryio/binary_compression.hpp"
+
+#include "binaryio/binary_assert.hpp"    // binaryIOAssert
+#include "binaryio/binary_chunk_io.hpp"  // ChunkView
+#include "binaryio/binary_executor.hpp"  // Executor
+
+#include <algorithm>  // min
+#include <cstddef>    // ptrdiff_t
+#include <cstdint>    // uint8_t, uint32_t
+#include <cstring>    // memcpy
+#include <new>        // placement new
+
+// LZ4 Block Codec
+//
+// Greedy parse with a single entry hash table of 4 byte sequences, the table lives on the stack so
+// the codec is stateless and can be used by any number of threads.
+// The decompressor validates every length and offset so malformed input is rejected instead of over reading.
+//
+
+static constexpr binaryIO::IOSize k_LZ4MinMatch       = 4u;
+static constexpr binaryIO::IOSize k_LZ4LastLiterals   = 5u;   //!< The last 5 bytes of a block are always literals.
+static constexpr binaryIO::IOSize k_LZ4MatchFindLimit = 12u;  //!< The last match must start at least 12 bytes before the end.
+static constexpr binaryIO::IOSize k_LZ4MaxOffset      = 65535u;
+static constexpr binaryIO::IOSize k_LZ4CopySize       = 16u;  //!< Size of the over copies the decompressor uses away from the end of the buffers.
+static constexpr unsigned         k_LZ4HashBits       = 12u;
+
+static std::uint32_t LZ4_Load32(const std::uint8_t* const bytes)
+{
+  std::uint32_t value;
+  std::memcpy(&value, bytes, sizeof(value));
+
+  return value;
+}
+
+static std::uint32_t LZ4_Hash(const std::uint32_t sequence)
+{
+  return (sequence * 2654435761u) >> (32u - k_LZ4HashBits);
+}
+
+// Writes the 255 run extension of a length that did not fit in its token nibble, returns nullptr if out of space.
+static std::uint8_t* LZ4_WriteLength(std::uint8_t* out, std::uint8_t* const out_end, binaryIO::IOSize length)
+{
+  while (length >= 255u)
+  {
+    if (out == out_end)
+    {
+      return nullptr;
+    }
+
+    *out++ = 255u;
+    length -= 255u;
+  }
+
+  if (out == out_end)
+  {
+    return nullptr;
+  }
+
+  *out++ = std::uint8_t(length);
+
+  return out;
+}
+
+static std::uint8_t* LZ4_WriteSequence(std::uint8_t* out, std::uint8_t* const out_end, const std::uint8_t* const literals, const binaryIO::IOSize num_literals, const binaryIO::IOSize offset, const binaryIO::IOSize match_length)
+{
+  const bool         has_match      = match_length != 0u;
+  const std::uint8_t literal_nibble = std::uint8_t(std::min<binaryIO::IOSize>(num_literals, 15u));
+  const std::uint8_t match_nibble   = has_match ? std::uint8_t(std::min<binaryIO::IOSize>(match_length - k_LZ4MinMatch, 15u)) : 0u;
+
+  if (out == out_end)
+  {
+    return nullptr;
+  }
+
+  *out++ = std::uint8_t((literal_nibble << 4u) | match_nibble);
+
+  if (literal_nibble == 15u && !(out = LZ4_WriteLength(out, out_end, num_literals - 15u)))
+  {
+    return nullptr;
+  }
+
+  if (binaryIO::IOSize(out_end - out) < num_literals + (has_match ? 2u : 0u))
+  {
+    return nullptr;
+  }
+
+  if (num_literals != 0u)
+  {
+    std::memcpy(out, literals, num_literals);
+    out += num_literals;
+  }
+
+  if (has_match)
+  {
+    *out++ = std::uint8_t(offset);
+    *out++ = std::uint8_t(offset >> 8u);
+
+    if (match_nibble == 15u && !(out = LZ4_WriteLength(out, out_end, match_length - k_LZ4MinMatch - 15u)))
+    {
+      return nullptr;
+    }
+  }
+
+  return out;
+}
+
+static binaryIO::IOResult LZ4_Compress(void* const user_data, const void* const source, const binaryIO::IOSize source_size, void* const destination, const binaryIO::IOSize destination_capacity)
+{
+  (void)user_data;
+
+  const std::uint8_t* const src_bgn = static_cast<const std::uint8_t*>(source);
+  const std::uint8_t* const src_end = src_bgn + source_size;
+  std::uint8_t* const       out_bgn = static_cast<std::uint8_t*>(destination);
+  std::uint8_t* const       out_end = out_bgn + destination_capacity;
+  std::uint8_t*             out     = out_bgn;
+  const std::uint8_t*       anchor  = src_bgn;
+
+  if (source_size > k_LZ4MatchFindLimit)
+  {
+    std::uint32_t table[1u << k_LZ4HashBits] = {};
+
+    const std::uint8_t* const match_find_limit = src_end - k_LZ4MatchFindLimit;
+    const std::uint8_t* const match_limit      = src_end - k_LZ4LastLiterals;
+    const std::uint8_t*       src              = src_bgn;
+
+    while (src < match_find_limit)
+    {
+      const std::uint32_t    sequence  = LZ4_Load32(src);
+      std::uint32_t* const   slot      = &table[LZ4_Hash(sequence)];
+      const std::uint8_t*    reference = src_bgn + *slot;
+      const binaryIO::IOSize offset    = binaryIO::IOSize(src - reference);
+
+      *slot = std::uint32_t(src - src_bgn);
+
+      if (offset == 0u || offset > k_LZ4MaxOffset || LZ4_Load32(reference) != sequence)
+      {
+        // Step faster through data that does not match.
+        src += 1u + (binaryIO::IOSize(src - anchor) >> 6u);
+        continue;
+      }
+
+      while (src > anchor && reference > src_bgn && src[-1] == reference[-1])
+      {
+        --src;
+        --reference;
+      }
+
+      const std::uint8_t* match_end = src + k_LZ4MinMatch;
+
+      while (match_end < match_limit && *match_end == reference[match_end - src])
+      {
+        ++match_end;
+      }
+
+      out = LZ4_WriteSequence(out, out_end, anchor, binaryIO::IOSize(src - anchor), offset, binaryIO::IOSize(match_end - src));
+
+      if (!out)
+      {
+        return 0u;
+      }
+
+      src    = match_end;
+      anchor = match_end;
+    }
+  }
+
+  out = LZ4_WriteSequence(out, out_end, anchor, binaryIO::IOSize(src_end - anchor), 0u, 0u);
+
+  return out ? binaryIO::IOSize(out - out_bgn) : 0u;
+}
+
+// Reads the 255 run extension of a length, returns false when the input ends first.
+static bool LZ4_ReadLength(const std::uint8_t** const in_out, const std::uint8_t* const in_end, binaryIO::IOSize* const in_out_length)
+{
+  const std::uint8_t* in = *in_out;
+  std::uint8_t        byte;
+
+  do
+  {
+    if (in == in_end)
+    {
+      return false;
+    }
+
+    byte = *in++;
+    *in_out_length += byte;
+  } while (byte == 255u);
+
+  *in_out = in;
+
+  return true;
+}
+
+static binaryIO::IOErrorCode LZ4_Decompress(void* const user_data, const void* const source, const binaryIO::IOSize source_size, void* const destination, const binaryIO::IOSize destination_size)
+{
+  (void)user_data;
+
+  const std::uint8_t*       in      = static_cast<const std::uint8_t*>(source);
+  const std::uint8_t* const in_end  = in + source_size;
+  std::uint8_t* const       out_bgn = static_cast<std::uint8_t*>(destination);
+  std::uint8_t* const       out_end = out_bgn + destination_size;
+  std::uint8_t*             out     = out_bgn;
+
+  while (in != in_end)
+  {
+    const std::uint8_t token        = *in++;
+    binaryIO::IOSize   num_literals = token >> 4u;
+
+    if (num_literals == 15u && !LZ4_ReadLength(&in, in_end, &num_literals))
+    {
+      return binaryIO::IOErrorCode::InvalidData;
+    }
+
+    if (num_literals > binaryIO::IOSize(in_end - in) || num_literals > binaryIO::IOSize(out_end - out))
+    {
+      return binaryIO::IOErrorCode::InvalidData;
+    }
+
+    // Short runs are over copied with a fixed size while far from the ends, later output overwrites the extra bytes.
+    if (num_literals <= k_LZ4CopySize && in_end - in >= std::ptrdiff_t(k_LZ4CopySize) && out_end - out >= std::ptrdiff_t(k_LZ4CopySize))
+    {
+      std::memcpy(out, in, k_LZ4CopySize);
+    }
+    else if (num_literals != 0u)
+    {
+      std::memcpy(out, in, num_literals);
+    }
+
+    in += num_literals;
+    out += num_literals;
+
+    // The last sequence has no match.
+    if (in == in_end)
+    {
+      break;
+    }
+
+    if (in_end - in < 2)
+    {
+      return binaryIO::IOErrorCode::InvalidData;
+    }
+
+    const binaryIO::IOSize offset       = binaryIO::IOSize(in[0]) | (binaryIO::IOSize(in[1]) << 8u);
+    binaryIO::IOSize       match_length = token & 0xFu;
+
+    in += 2u;
+
+    if (match_length == 15u && !LZ4_ReadLength(&in, in_end, &match_length))
+    {
+      return binaryIO::IOErrorCode::InvalidData;
+    }
+
+    match_length += k_LZ4MinMatch;
+
+    if (offset == 0u || offset > binaryIO::IOSize(out - out_bgn) || match_length > binaryIO::IOSize(out_end - out))
+    {
+      return binaryIO::IOErrorCode::InvalidData;
+    }
+
+    const std::uint8_t* match = out - offset;
+
+    if (offset >= k_LZ4CopySize && binaryIO::IOSize(out_end - out) >= match_length + k_LZ4CopySize)
+    {
+      // Every fixed size copy reads bytes that are already decoded since the copies never overlap.
+      for (binaryIO::IOSize i = 0u; i < match_length; i += k_LZ4CopySize)
+      {
+        std::memcpy(out + i, match + i, k_LZ4CopySize);
+      }
+
+      out += match_length;
+    }
+    else if (offset >= match_length)
+    {
+      std::memcpy(out, match, match_length);
+      out += match_length;
+    }
+    else
+    {
+      // Overlapping matches repeat the last `offset` bytes.
+      for (binaryIO::IOSize i = 0u; i < match_length; ++i)
+      {
+        *out++ = *match++;
+      }
+    }
+  }
+
+  return out == out_end ? binaryIO::IOErrorCode::Success : binaryIO::IOErrorCode::InvalidData;
+}
+
+binaryIO::IOCodec binaryIO::IOCodec_Store()
+{
+  return IOCodec{};
+}
+
+binaryIO::IOCodec binaryIO::IOCodec_LZ4()
+{
+  binaryIO::IOCodec result;
+  result.Compress   = &LZ4_Compress;
+  result.Decompress = &LZ4_Decompress;
+  result.user_data  = nullptr;
+  result.codec      = CompressionCodec::LZ4;
+
+  return result;
+}
+
+// Block Framing
+
+static void CompressedBlock_EncodeHeader(std::uint8_t (&bytes)[sizeof(binaryIO::CompressedBlockHeader)], const binaryIO::IOSize compressed_size, const binaryIO::IOSize uncompressed_size)
+{
+  const auto little_endian = [](const std::size_t i) { return i; };
+
+  binaryIO::detail::encodeXEndian(bytes + 0u, std::uint32_t(compressed_size), little_endian);
+  binaryIO::detail::encodeXEndian(bytes + 4u, std::uint32_t(uncompressed_size), little_endian);
+}
+
+static binaryIO::CompressedBlockHeader CompressedBlock_DecodeHeader(const std::uint8_t (&bytes)[sizeof(binaryIO::CompressedBlockHeader)])
+{
+  const auto little_endian = [](const std::size_t i) { return i; };
+
+  binaryIO::CompressedBlockHeader result;
+  result.compressed_size   = binaryIO::detail::decodeXEndian<std::uint32_t>(bytes + 0u, little_endian);
+  result.uncompressed_size = binaryIO::detail::decodeXEndian<std::uint32_t>(bytes + 4u, little_endian);
+
+  return result;
+}
+
+static bool CompressedBlock_IsValidHeader(const binaryIO::CompressedBlockHeader& header)
+{
+  return header.uncompressed_size != 0u &&
+         header.uncompressed_size <= binaryIO::k_CompressionMaxBlockSize &&
+         header.compressed_size != 0u &&
+         header.compressed_size <= header.uncompressed_size;
+}
+
+// Compress Stream
+//
+// The write window holds a batch of `num_batch_blocks` uncompressed blocks, flushing compresses the
+// whole batch, in parallel when there is an executor, then writes the blocks out in order.
+// Writes of at least a whole batch while the window is empty are compressed straight from the caller's memory.
+//
+// user_data.values[0] : CompressStreamState*
+//
+
+namespace
+{
+  struct CompressStreamState
+  {
+    binaryIO::IOAllocator allocator;
+    binaryIO::IOCodec     codec;
+    binaryIO::IOStream*   destination;
+    binaryIO::Executor*   executor;             //!< Null compresses on the calling thread.
+    binaryIO::IOSize      block_size;
+    binaryIO::IOSize      num_batch_blocks;
+    binaryIO::IOSize      num_committed_bytes;  //!< Uncompressed bytes of all the blocks written.
+    binaryIO::IOResult*   results;              //!< Compressed size of each block of the batch.
+    std::uint8_t*         block;
+    std::uint8_t*         compressed;
+
+    // Batch being compressed, only valid during `CompressStream_WriteBlocks`.
+    const std::uint8_t* batch_bytes;
+    binaryIO::IOSize    batch_size;
+
+    binaryIO::IOSize batchSize() const { return block_size * num_batch_blocks; }
+    binaryIO::IOSize allocationSize() const { return sizeof(CompressStreamState) + sizeof(binaryIO::IOResult) * num_batch_blocks + batchSize() * 2u; }
+  };
+}  // namespace
+
+static CompressStreamState* CompressStream_State(const binaryIO::IOStream* const stream)
+{
+  return static_cast<CompressStreamState*>(stream->user_data.values[0].as_handle);
+}
+
+static void CompressStream_CompressBlock(void* const task_data, const binaryIO::IOSize block_index)
+{
+  CompressStreamState* const state     = static_cast<CompressStreamState*>(task_data);
+  const binaryIO::IOSize     offset    = block_index * state->block_size;
+  const binaryIO::IOSize     num_bytes = std::min(state->block_size, state->batch_size - offset);
+
+  // Anything that does not shrink is stored, so the compressed output is given one byte less than the input.
+  state->results[block_index] = state->codec.Compress ?
+                                 state->codec.Compress(state->codec.user_data, state->batch_bytes + offset, num_bytes, state->compressed + offset, num_bytes - 1u) :
+                                 binaryIO::IOResult(0u);
+}
+
+static binaryIO::IOErrorCode CompressStream_WriteBlocks(CompressStreamState* const state, const std::uint8_t* const bytes, const binaryIO::IOSize num_bytes)
+{
+  const binaryIO::IOSize num_blocks = (num_bytes + state->block_size - 1u) / state->block_size;
+
+  state->batch_bytes = bytes;
+  state->batch_size  = num_bytes;
+
+  if (state->executor && num_blocks > 1u)
+  {
+    state->executor->ParallelFor(state->executor, num_blocks, &CompressStream_CompressBlock, state);
+  }
+  else
+  {
+    for (binaryIO::IOSize i = 0u; i < num_blocks; ++i)
+    {
+      CompressStream_CompressBlock(state, i);
+    }
+  }
+
+  // Blocks are written in order so the output does not depend on the executor.
+  for (binaryIO::IOSize i = 0u; i < num_blocks; ++i)
+  {
+    const binaryIO::IOResult compress_result = state->results[i];
+
+    if (compress_result.ErrorCode() != binaryIO::IOErrorCode::Success)
+    {
+      return compress_result.ErrorCode();
+    }
+
+    const binaryIO::IOSize offset            = i * state->block_size;
+    const binaryIO::IOSize uncompressed_size = std::min(state->block_size, num_bytes - offset);
+    const bool             is_stored         = compress_result.Value() == 0u;
+    const binaryIO::IOSize compressed_size   = is_stored ? uncompressed_size : compress_result.Value();
+
+    // A codec reporting more than the capacity it was given would write a block the reader rejects.
+    if (!is_stored && compressed_size >= uncompressed_size)
+    {
+      return binaryIO::IOErrorCode::InvalidData;
+    }
+
+    std::uint8_t header[sizeof(binaryIO::CompressedBlockHeader)];
+    CompressedBlock_EncodeHeader(header, compressed_size, uncompressed_size);
+
+    const binaryIO::IOConstSegment segments[] =
+     {
+      {header, sizeof(header)},
+      {is_stored ? bytes + offset : state->compressed + offset, compressed_size},
+     };
+
+    const binaryIO::IOErrorCode write_error = IOStream_WriteV(state->destination, segments, sizeof(segments) / sizeof(segments[0])).ErrorCode();
+
+    if (write_error != binaryIO::IOErrorCode::Success)
+    {
+      return write_error;
+    }
+
+    state->num_committed_bytes += uncompressed_size;
+  }
+
+  return binaryIO::IOErrorCode::Success;
+}
+
+static binaryIO::IOErrorCode CompressStream_Flush(binaryIO::IOStream* const stream)
+{
+  CompressStreamState* const       state          = CompressStream_State(stream);
+  binaryIO::BufferedWriteIO* const buffered_write = &stream->buffered_write;
+  const binaryIO::IOSize           num_bytes      = buffered_write->cursor - buffered_write->buffer_start;
+
+  buffered_write->cursor = buffered_write->buffer_start;
+
+  return num_bytes != 0u ? CompressStream_WriteBlocks(state, state->block, num_bytes) : binaryIO::IOErrorCode::Success;
+}
+
+static binaryIO::IOResult CompressStream_Size(binaryIO::IOStream* const stream)
+{
+  return CompressStream_State(stream)->num_committed_bytes + binaryIO::IOSize(stream->buffered_write.cursor - stream->buffered_write.buffer_start);
+}
+
+static binaryIO::IOResult CompressStream_Write(binaryIO::IOStream* const stream, const void* const source, const binaryIO::IOSize num_source_bytes)
+{
+  CompressStreamState* const       state          = CompressStream_State(stream);
+  binaryIO::BufferedWriteIO* const buffered_write = &stream->buffered_write;
+  const std::uint8_t*              bytes          = static_cast<const std::uint8_t*>(source);
+  const binaryIO::IOSize           batch_size     = state->batchSize();
+  binaryIO::IOSize                 num_written    = 0u;
+
+  while (num_written != num_source_bytes)
+  {
+    const binaryIO::IOSize num_bytes_left = num_source_bytes - num_written;
+
+    if (buffered_write->cursor == buffered_write->buffer_start && num_bytes_left >= batch_size)
+    {
+      const binaryIO::IOErrorCode block_error = CompressStream_WriteBlocks(state, bytes + num_written, batch_size);
+
+      if (block_error != binaryIO::IOErrorCode::Success)
+      {
+        return binaryIO::IOResult(num_written, block_error);
+      }
+
+      num_written += batch_size;
+      continue;
+    }
+
+    const binaryIO::IOSize num_bytes_to_copy = std::min(num_bytes_left, BufferedWrite_NumBytesAvailable(stream));
+
+    std::memcpy(buffered_write->cursor, bytes + num_written, num_bytes_to_copy);
+    buffered_write->cursor += num_bytes_to_copy;
+    num_written += num_bytes_to_copy;
+
+    if (buffered_write->cursor == buffered_write->buffer_end)
+    {
+      const binaryIO::IOErrorCode flush_error = CompressStream_Flush(stream);
+
+      if (flush_error != binaryIO::IOErrorCode::Success)
+      {
+        return binaryIO::IOResult(num_written, flush_error);
+      }
+    }
+  }
+
+  return binaryIO::IOResult(num_written, binaryIO::IOErrorCode::Success);
+}
+
+static binaryIO::IOErrorCode CompressStream_Close(binaryIO::IOStream* const stream)
+{
+  CompressStreamState* const  state     = CompressStream_State(stream);
+  const binaryIO::IOErrorCode result    = CompressStream_Flush(stream);
+  const binaryIO::IOAllocator allocator = state->allocator;
+
+  if (allocator.Free)
+  {
+    allocator.Free(allocator.user_data, state, state->allocationSize());
+  }
+
+  stream->buffered_write = {};
+
+  return result;
+}
+
+static binaryIO::IOStream CompressStream_Create(binaryIO::IOStream* const    destination,
+                                                const binaryIO::IOCodec&     codec,
+                                                const binaryIO::IOAllocator& allocator,
+                                                binaryIO::Executor* const    executor,
+                                                const binaryIO::IOSize       block_size,
+                                                const binaryIO::IOSize       num_batch_blocks)
+{
+  binaryIOAssert(allocator.Alloc != nullptr, "A compressing stream requires an allocator.");
+  binaryIOAssert(block_size >= 2u && block_size <= binaryIO::k_CompressionMaxBlockSize, "Block size must be in [2, k_CompressionMaxBlockSize].");
+
+  binaryIO::IOStream        result = {};
+  const CompressStreamState layout = {allocator, codec, destination, executor, block_size, num_batch_blocks, 0u, nullptr, nullptr, nullptr, nullptr, 0u};
+  void* const               memory = allocator.Alloc(allocator.user_data, layout.allocationSize(), alignof(CompressStreamState));
+
+  if (!memory)
+  {
+    result.error_state = binaryIO::IOErrorCode::AllocationFailure;
+    return result;
+  }
+
+  CompressStreamState* const state = new (memory) CompressStreamState(layout);
+
+  state->results    = reinterpret_cast<binaryIO::IOResult*>(state + 1);
+  state->block      = reinterpret_cast<std::uint8_t*>(state->results + num_batch_blocks);
+  state->compressed = state->block + state->batchSize();
+
+  result.Size                          = &CompressStream_Size;
+  result.Write                         = &CompressStream_Write;
+  result.Close                         = &CompressStream_Close;
+  result.user_data.values[0].as_handle = state;
+  result.buffered_write.buffer_start   = state->block;
+  result.buffered_write.cursor         = state->block;
+  result.buffered_write.buffer_end     = state->block + state->batchSize();
+  result.buffered_write.Flush          = &CompressStream_Flush;
+
+  return result;
+}
+
+// Two blocks per worker keeps every worker busy while the slowest block is finishing.
+static binaryIO::IOSize Compression_NumBlocksInFlight(const binaryIO::Executor& executor, const binaryIO::IOSize num_blocks_in_flight)
+{
+  return num_blocks_in_flight != 0u ? num_blocks_in_flight : executor.num_workers * 2u;
+}
+
+binaryIO::IOStream binaryIO::IOStream_FromCompressor(IOStream* const destination, const IOCodec& codec, const IOAllocator& allocator, const IOSize block_size)
+{
+  return CompressStream_Create(destination, codec, allocator, nullptr, block_size, 1u);
+}
+
+binaryIO::IOStream binaryIO::IOStream_FromParallelCompressor(IOStream* const destination, const IOCodec& codec, const IOAllocator& allocator, Executor& executor, const IOSize block_size, const IOSize num_blocks_in_flight)
+{
+  return CompressStream_Create(destination, codec, allocator, &executor, block_size, Compression_NumBlocksInFlight(executor, num_blocks_in_flight));
+}
+
+// Decompress Stream
+//
+// Blocks are read from the source in batches of up to `num_slots` and decompressed together, in parallel
+// when there is an executor, then the read window steps through the decompressed blocks in order.
+// With a single slot the block is decompressed straight out of the source's window when it holds the
+// whole block and stored blocks are handed out without a copy. Staging buffers grow to the largest block seen.
+//
+// Streams over a seekable compressed chunk keep its block offset table so that a seek decompresses
+// only the blocks from the new position on, the source is only seeked when blocks are not read in order.
+//
+// user_data.values[0] : DecompressStreamState*
+//
+
+namespace
+{
+  struct DecompressStreamBuffer
+  {
+    std::uint8_t*    bytes;
+    binaryIO::IOSize capacity;
+  };
+
+  struct DecompressStreamSlot
+  {
+    DecompressStreamBuffer          block;
+    DecompressStreamBuffer          compressed;
+    const std::uint8_t*             input;   //!< The block's compressed bytes.
+    const std::uint8_t*             output;  //!< The block's uncompressed bytes once decoded.
+    binaryIO::CompressedBlockHeader header;
+    binaryIO::IOSize                offset;  //!< Uncompressed offset of the block.
+    binaryIO::IOErrorCode           error;
+  };
+
+  struct DecompressStreamState
+  {
+    binaryIO::IOAllocator  allocator;
+    binaryIO::IOCodec      codec;
+    binaryIO::IOStream*    source;
+    binaryIO::IOStream     memory_source;      //!< Used as the source when decompressing from memory.
+    binaryIO::Executor*    executor;           //!< Null decompresses on the calling thread.
+    binaryIO::IOSize       total_size;         //!< Uncompressed size, `k_DecompressStreamUnknownSize` unless read from a chunk.
+    binaryIO::IOSize       window_offset;      //!< Uncompressed offset of `buffered_io.buffer_start`.
+    binaryIO::IOSize       read_offset;        //!< Uncompressed offset of the next block read from `source`.
+    std::uint64_t*         block_offsets;      //!< `num_blocks + 1` offsets relative to `data_offset`, null when the stream is not seekable.
+    binaryIO::IOSize       num_blocks;
+    binaryIO::IOSize       block_size;
+    binaryIO::IOSize       data_offset;        //!< Position of the chunk's data in `source`.
+    binaryIO::IOSize       source_offset;      //!< Position of `source` relative to `data_offset`.
+    binaryIO::IOSize       read_block;         //!< Index of the next block read from `source`.
+    DecompressStreamSlot*  slots;
+    binaryIO::IOSize       num_slots;
+    binaryIO::IOSize       num_batched_slots;  //!< Slots holding blocks of the current batch.
+    binaryIO::IOSize       next_slot;          //!< Slot the next refill hands out.
+
+    binaryIO::IOSize allocationSize() const { return sizeof(DecompressStreamState) + sizeof(DecompressStreamSlot) * num_slots; }
+  };
+
+  constexpr binaryIO::IOSize k_DecompressStreamUnknownSize = ~binaryIO::IOSize(0u);
+}  // namespace
+
+static DecompressStreamState* DecompressStream_State(const binaryIO::IOStream* const stream)
+{
+  return static_cast<DecompressStreamState*>(stream->user_data.values[0].as_handle);
+}
+
+static std::uint8_t* DecompressStream_Reserve(DecompressStreamState* const state, DecompressStreamBuffer* const buffer, const binaryIO::IOSize num_bytes)
+{
+  if (buffer->capacity < num_bytes)
+  {
+    const binaryIO::IOAllocator& allocator = state->allocator;
+    void* const                  bytes     = allocator.Alloc(allocator.user_data, num_bytes, 1u);
+
+    if (!bytes)
+    {
+      return nullptr;
+    }
+
+    if (buffer->bytes && allocator.Free)
+    {
+      allocator.Free(allocator.user_data, buffer->bytes, buffer->capacity);
+    }
+
+    buffer->bytes    = static_cast<std::uint8_t*>(bytes);
+    buffer->capacity = num_bytes;
+  }
+
+  return buffer->bytes;
+}
+
+// Reads the next block from the source into `slot`, all allocation happens here so decoding can run on any thread.
+static binaryIO::IOErrorCode DecompressStream_ReadBlock(DecompressStreamState* const state, DecompressStreamSlot* const slot)
+{
+  binaryIO::IOStream* const   source    = state->source;
+  binaryIO::BufferedIO* const source_io = &source->buffered_io;
+
+  if (state->block_offsets && state->source_offset != state->block_offsets[state->read_block])
+  {
+    state->source_offset = state->block_offsets[state->read_block];
+
+    if (IOStream_Seek(source, binaryIO::IOOffset(state->data_offset + state->source_offset), binaryIO::SeekOrigin::BEGIN).ErrorCode() != binaryIO::IOErrorCode::Success)
+    {
+      return binaryIO::IOErrorCode::SeekError;
+    }
+  }
+
+  std::uint8_t             header_bytes[sizeof(binaryIO::CompressedBlockHeader)];
+  const binaryIO::IOResult header_result = IOStream_Read(source, header_bytes, sizeof(header_bytes));
+
+  if (header_result.ErrorCode() != binaryIO::IOErrorCode::Success)
+  {
+    const bool is_end_of_blocks = header_result.ErrorCode() == binaryIO::IOErrorCode::EndOfStream && header_result.Value() == 0u && state->total_size == k_DecompressStreamUnknownSize;
+
+    return is_end_of_blocks ? binaryIO::IOErrorCode::EndOfStream : binaryIO::IOErrorCode::InvalidData;
+  }
+
+  const binaryIO::CompressedBlockHeader header = CompressedBlock_DecodeHeader(header_bytes);
+
+  if (!CompressedBlock_IsValidHeader(header) || header.uncompressed_size > state->total_size - state->read_offset)
+  {
+    return binaryIO::IOErrorCode::InvalidData;
+  }
+
+  // The index fixes the size of every block, checked so that a seek always lands on the right bytes.
+  if (state->block_offsets)
+  {
+    const std::uint64_t* const block_offsets = state->block_offsets + state->read_block;
+
+    if (block_offsets[1] - block_offsets[0] != sizeof(header_bytes) + header.compressed_size ||
+        header.uncompressed_size != std::min(state->block_size, state->total_size - state->read_offset))
+    {
+      return binaryIO::IOErrorCode::InvalidData;
+    }
+
+    state->source_offset = block_offsets[1];
+  }
+
+  const bool is_stored = header.compressed_size == header.uncompressed_size;
+
+  // The source's window may be refilled by the next block's read so it is only used while a single block is in flight.
+  if (state->num_slots == 1u && BufferedIO_NumBytesAvailable(source) >= header.compressed_size)
+  {
+    slot->input = source_io->cursor;
+    source_io->cursor += header.compressed_size;
+  }
+  else
+  {
+    std::uint8_t* const staging = DecompressStream_Reserve(state, is_stored ? &slot->block : &slot->compressed, header.compressed_size);
+
+    if (!staging)
+    {
+      return binaryIO::IOErrorCode::AllocationFailure;
+    }
+
+    if (IOStream_Read(source, staging, header.compressed_size).ErrorCode() != binaryIO::IOErrorCode::Success)
+    {
+      return binaryIO::IOErrorCode::InvalidData;
+    }
+
+    slot->input = staging;
+  }
+
+  if (!is_stored && !DecompressStream_Reserve(state, &slot->block, header.uncompressed_size))
+  {
+    return binaryIO::IOErrorCode::AllocationFailure;
+  }
+
+  slot->output = is_stored ? slot->input : slot->block.bytes;
+  slot->header = header;
+  slot->offset = state->read_offset;
+  slot->error  = binaryIO::IOErrorCode::Success;
+
+  state->read_offset += header.uncompressed_size;
+  state->read_block += 1u;
+
+  return binaryIO::IOErrorCode::Success;
+}
+
+static void DecompressStream_DecodeBlock(void* const task_data, const binaryIO::IOSize slot_index)
+{
+  DecompressStreamState* const state = static_cast<DecompressStreamState*>(task_data);
+  DecompressStreamSlot* const  slot  = state->slots + slot_index;
+
+  if (slot->error == binaryIO::IOErrorCode::Success && slot->header.compressed_size != slot->header.uncompressed_size)
+  {
+    slot->error = state->codec.Decompress ?
+                   state->codec.Decompress(state->codec.user_data, slot->input, slot->header.compressed_size, slot->block.bytes, slot->header.uncompressed_size) :
+                   binaryIO::IOErrorCode::InvalidData;
+  }
+}
+
+static binaryIO::IOErrorCode DecompressStream_FillBatch(DecompressStreamState* const state)
+{
+  state->num_batched_slots = 0u;
+  state->next_slot         = 0u;
+
+  while (state->num_batched_slots < state->num_slots && state->read_offset < state->total_size)
+  {
+    DecompressStreamSlot* const slot       = state->slots + state->num_batched_slots;
+    const binaryIO::IOErrorCode read_error = DecompressStream_ReadBlock(state, slot);
+
+    if (read_error != binaryIO::IOErrorCode::Success)
+    {
+      // The blocks read before a failure are still handed out, the failure is reported once reached.
+      if (read_error != binaryIO::IOErrorCode::EndOfStream)
+      {
+        slot->error = read_error;
+        state->num_batched_slots += 1u;
+      }
+
+      break;
+    }
+
+    state->num_batched_slots += 1u;
+  }
+
+  if (state->num_batched_slots == 0u)
+  {
+    return binaryIO::IOErrorCode::EndOfStream;
+  }
+
+  if (state->executor && state->num_batched_slots > 1u)
+  {
+    state->executor->ParallelFor(state->executor, state->num_batched_slots, &DecompressStream_DecodeBlock, state);
+  }
+  else
+  {
+    for (binaryIO::IOSize i = 0u; i < state->num_batched_slots; ++i)
+    {
+      DecompressStream_DecodeBlock(state, i);
+    }
+  }
+
+  return binaryIO::IOErrorCode::Success;
+}
+
+static binaryIO::IOErrorCode DecompressStream_Refill(binaryIO::IOStream* const stream)
+{
+  DecompressStreamState* const state       = DecompressStream_State(stream);
+  binaryIO::BufferedIO* const  buffered_io = &stream->buffered_io;
+
+  if (state->next_slot == state->num_batched_slots)
+  {
+    const binaryIO::IOErrorCode batch_error = DecompressStream_FillBatch(state);
+
+    if (batch_error != binaryIO::IOErrorCode::Success)
+    {
+      state->window_offset = state->read_offset;
+      return BufferedIO_Failure(stream, batch_error);
+    }
+  }
+
+  const DecompressStreamSlot* const slot = state->slots + state->next_slot;
+
+  state->next_slot += 1u;
+
+  if (slot->error != binaryIO::IOErrorCode::Success)
+  {
+    state->window_offset = slot->offset;
+    return BufferedIO_Failure(stream, slot->error);
+  }
+
+  state->window_offset = slot->offset;
+
+  buffered_io->buffer_start = slot->output;
+  buffered_io->cursor       = slot->output;
+  buffered_io->buffer_end   = slot->output + slot->header.uncompressed_size;
+
+  return binaryIO::IOErrorCode::Success;
+}
+
+static bool DecompressStream_HasFailed(const binaryIO::IOStream* const stream)
+{
+  return stream->buffered_io.Refill != &DecompressStream_Refill;
+}
+
+static binaryIO::IOResult DecompressStream_Size(binaryIO::IOStream* const stream)
+{
+  return DecompressStream_State(stream)->total_size;
+}
+
+static binaryIO::IOResult DecompressStream_Read(binaryIO::IOStream* const stream, void* const destination, const binaryIO::IOSize num_destination_bytes)
+{
+  binaryIO::BufferedIO* const buffered_io = &stream->buffered_io;
+  std::uint8_t* const         out         = static_cast<std::uint8_t*>(destination);
+  binaryIO::IOSize            num_read    = 0u;
+
+  while (num_read != num_destination_bytes && !DecompressStream_HasFailed(stream))
+  {
+    if (buffered_io->cursor == buffered_io->buffer_end && DecompressStream_Refill(stream) != binaryIO::IOErrorCode::Success)
+    {
+      break;
+    }
+
+    const binaryIO::IOSize num_bytes_to_copy = std::min(num_destination_bytes - num_read, BufferedIO_NumBytesAvailable(stream));
+
+    std::memcpy(out + num_read, buffered_io->cursor, num_bytes_to_copy);
+    num_read += num_bytes_to_copy;
+    buffered_io->cursor += num_bytes_to_copy;
+  }
+
+  if (num_read == num_destination_bytes)
+  {
+    return binaryIO::IOResult(num_read, binaryIO::IOErrorCode::Success);
+  }
+
+  return binaryIO::IOResult(num_read, stream->error_state != binaryIO::IOErrorCode::Success ? stream->error_state : binaryIO::IOErrorCode::EndOfStream);
+}
+
+// Only installed for streams with a block index.
+static binaryIO::IOResult DecompressStream_Seek(binaryIO::IOStream* const stream, const binaryIO::IOOffset offset, const binaryIO::SeekOrigin seek_origin)
+{
+  DecompressStreamState* const state       = DecompressStream_State(stream);
+  binaryIO::BufferedIO* const  buffered_io = &stream->buffered_io;
+  const bool                   has_window  = !DecompressStream_HasFailed(stream);
+  const binaryIO::IOSize       position    = state->window_offset + (has_window ? buffered_io->cursor - buffered_io->buffer_start : 0u);
+
+  const binaryIO::IOOffset base_offset[] =
+   {
+    0,
+    binaryIO::IOOffset(position),
+    binaryIO::IOOffset(state->total_size),
+   };
+
+  const binaryIO::IOOffset absolute_location = base_offset[int(seek_origin)] + offset;
+
+  if (absolute_location < 0 || binaryIO::IOSize(absolute_location) > state->total_size)
+  {
+    return binaryIO::IOResult(position, binaryIO::IOErrorCode::SeekError);
+  }
+
+  const binaryIO::IOSize target = binaryIO::IOSize(absolute_location);
+
+  if (has_window)
+  {
+    if (target >= state->window_offset && target - state->window_offset <= binaryIO::IOSize(buffered_io->buffer_end - buffered_io->buffer_start))
+    {
+      buffered_io->cursor = buffered_io->buffer_start + (target - state->window_offset);
+      return binaryIO::IOResult(target, binaryIO::IOErrorCode::Success);
+    }
+
+    // Forward seeks into a block of the current batch skip ahead without decompressing again.
+    for (binaryIO::IOSize i = state->next_slot; i < state->num_batched_slots; ++i)
+    {
+      const DecompressStreamSlot& slot = state->slots[i];
+
+      if (target >= slot.offset && target - slot.offset < slot.header.uncompressed_size)
+      {
+        state->next_slot = i;
+
+        const binaryIO::IOErrorCode refill_error = DecompressStream_Refill(stream);
+
+        // A failed refill leaves the zero window, moving the cursor would run it past `buffer_end`.
+        if (refill_error != binaryIO::IOErrorCode::Success)
+        {
+          return binaryIO::IOResult(position, slot.error != binaryIO::IOErrorCode::Success ? slot.error : refill_error);
+        }
+
+        buffered_io->cursor += target - state->window_offset;
+        return binaryIO::IOResult(target, binaryIO::IOErrorCode::Success);
+      }
+    }
+  }
+
+  // Any other seek drops the batch, this also restarts decompression for a stream that previously failed a refill.
+  state->read_block         = target / state->block_size;
+  state->read_offset        = state->read_block * state->block_size;
+  state->window_offset      = state->read_offset;
+  state->num_batched_slots  = 0u;
+  state->next_slot          = 0u;
+  buffered_io->cursor       = buffered_io->buffer_start;
+  buffered_io->buffer_end   = buffered_io->buffer_start;
+  buffered_io->Refill       = &DecompressStream_Refill;
+
+  // The end of the stream is left as an empty window.
+  if (target == state->total_size)
+  {
+    state->read_offset   = target;
+    state->window_offset = target;
+    return binaryIO::IOResult(target, binaryIO::IOErrorCode::Success);
+  }
+
+  const binaryIO::IOErrorCode refill_error = DecompressStream_Refill(stream);
+
+  if (refill_error != binaryIO::IOErrorCode::Success)
+  {
+    return binaryIO::IOResult(state->window_offset, refill_error);
+  }
+
+  buffered_io->cursor += target - state->window_offset;
+
+  return binaryIO::IOResult(target, binaryIO::IOErrorCode::Success);
+}
+
+static binaryIO::IOErrorCode DecompressStream_Close(binaryIO::IOStream* const stream)
+{
+  DecompressStreamState* const state     = DecompressStream_State(stream);
+  const binaryIO::IOAllocator  allocator = state->allocator;
+
+  if (allocator.Free)
+  {
+    for (binaryIO::IOSize i = 0u; i < state->num_slots; ++i)
+    {
+      const DecompressStreamSlot& slot = state->slots[i];
+
+      if (slot.block.bytes)
+      {
+        allocator.Free(allocator.user_data, slot.block.bytes, slot.block.capacity);
+      }
+
+      if (slot.compressed.bytes)
+      {
+        allocator.Free(allocator.user_data, slot.compressed.bytes, slot.compressed.capacity);
+      }
+    }
+
+    if (state->block_offsets)
+    {
+      allocator.Free(allocator.user_data, state->block_offsets, (state->num_blocks + 1u) * sizeof(std::uint64_t));
+    }
+
+    allocator.Free(allocator.user_data, state, state->allocationSize());
+  }
+
+  stream->buffered_io = {};
+
+  return binaryIO::IOErrorCode::Success;
+}
+
+// A null `source` decompresses from `memory_source`, which the caller sets up after creation.
+static binaryIO::IOStream DecompressStream_Create(binaryIO::IOStream* const    source,
+                                                  const binaryIO::IOCodec&     codec,
+                                                  const binaryIO::IOAllocator& allocator,
+                                                  binaryIO::Executor* const    executor,
+                                                  const binaryIO::IOSize       num_slots)
+{
+  binaryIOAssert(allocator.Alloc != nullptr, "A decompressing stream requires an allocator.");
+  binaryIOAssert(num_slots != 0u, "A decompressing stream needs at least one block in flight.");
+
+  binaryIO::IOStream          result = {};
+  const DecompressStreamState layout = {allocator, codec, source, {}, executor, k_DecompressStreamUnknownSize, 0u, 0u, nullptr, 0u, 0u, 0u, 0u, 0u, nullptr, num_slots, 0u, 0u};
+  void* const                 memory = allocator.Alloc(allocator.user_data, layout.allocationSize(), alignof(DecompressStreamState));
+
+  if (!memory)
+  {
+    result.error_state = binaryIO::IOErrorCode::AllocationFailure;
+    return result;
+  }
+
+  DecompressStreamState* const state = new (memory) DecompressStreamState(layout);
+
+  state->slots = reinterpret_cast<DecompressStreamSlot*>(state + 1);
+
+  for (binaryIO::IOSize i = 0u; i < num_slots; ++i)
+  {
+    new (state->slots + i) DecompressStreamSlot{{nullptr, 0u}, {nullptr, 0u}, nullptr, nullptr, {0u, 0u}, 0u, binaryIO::IOErrorCode::Success};
+  }
+
+  if (!source)
+  {
+    state->source = &state->memory_source;
+  }
+
+  result.Read                          = &DecompressStream_Read;
+  result.Close                         = &DecompressStream_Close;
+  result.user_data.values[0].as_handle = state;
+  result.buffered_io.Refill            = &DecompressStream_Refill;
+
+  return result;
+}
+
+// Discards `num_bytes` from a source that may not be able to seek.
+static binaryIO::IOErrorCode DecompressStream_Skip(binaryIO::IOStream* const source, binaryIO::IOSize num_bytes)
+{
+  std::uint8_t scratch[64];
+
+  while (num_bytes != 0u)
+  {
+    const binaryIO::IOSize num_bytes_to_read = std::min(num_bytes, binaryIO::IOSize(sizeof(scratch)));
+
+    if (IOStream_Read(source, scratch, num_bytes_to_read).ErrorCode() != binaryIO::IOErrorCode::Success)
+    {
+      return binaryIO::IOErrorCode::InvalidData;
+    }
+
+    num_bytes -= num_bytes_to_read;
+  }
+
+  return binaryIO::IOErrorCode::Success;
+}
+
+static binaryIO::IOErrorCode DecompressStream_LoadBlockIndex(DecompressStreamState* const state, const binaryIO::BinaryChunkBlockIndexInfo& index, const binaryIO::IOSize data_size)
+{
+  const binaryIO::IOSize expected_num_blocks = index.block_size != 0u ? (state->total_size + index.block_size - 1u) / index.block_size : 0u;
+
+  if (index.block_size == 0u || index.block_size > binaryIO::k_CompressionMaxBlockSize || index.num_blocks != expected_num_blocks ||
+      index.table_offset > data_size || (data_size - index.table_offset) / sizeof(std::uint64_t) <= index.num_blocks)
+  {
+    return binaryIO::IOErrorCode::InvalidData;
+  }
+
+  const binaryIO::IOResult data_offset = IOStream_Seek(state->source, 0, binaryIO::SeekOrigin::CURRENT);
+
+  if (data_offset.ErrorCode() != binaryIO::IOErrorCode::Success)
+  {
+    return binaryIO::IOErrorCode::InvalidOperation;
+  }
+
+  const binaryIO::IOSize num_table_bytes = (index.num_blocks + 1u) * sizeof(std::uint64_t);
+  void* const            table           = state->allocator.Alloc(state->allocator.user_data, num_table_bytes, alignof(std::uint64_t));
+
+  if (!table)
+  {
+    return binaryIO::IOErrorCode::AllocationFailure;
+  }
+
+  state->block_offsets = static_cast<std::uint64_t*>(table);
+  state->num_blocks    = index.num_blocks;
+  state->block_size    = index.block_size;
+  state->data_offset   = data_offset.Value();
+
+  if (IOStream_Seek(state->source, binaryIO::IOOffset(state->data_offset + index.table_offset), binaryIO::SeekOrigin::BEGIN).ErrorCode() != binaryIO::IOErrorCode::Success ||
+      IOStream_Read(state->source, table, num_table_bytes).ErrorCode() != binaryIO::IOErrorCode::Success ||
+      IOStream_Seek(state->source, binaryIO::IOOffset(state->data_offset), binaryIO::SeekOrigin::BEGIN).ErrorCode() != binaryIO::IOErrorCode::Success)
+  {
+    return binaryIO::IOErrorCode::InvalidData;
+  }
+
+  std::uint64_t* const block_offsets = state->block_offsets;
+
+  for (binaryIO::IOSize i = 0u; i <= index.num_blocks; ++i)
+  {
+    block_offsets[i] = binaryIO::detail::decodeXEndian<std::uint64_t>(reinterpret_cast<const std::uint8_t*>(block_offsets + i), [](const std::size_t i) { return i; });
+
+    // Every block holds at least a header and a byte.
+    if (i == 0u ? block_offsets[i] != 0u : block_offsets[i] - block_offsets[i - 1u] <= sizeof(binaryIO::CompressedBlockHeader) || block_offsets[i] < block_offsets[i - 1u])
+    {
+      return binaryIO::IOErrorCode::InvalidData;
+    }
+  }
+
+  return block_offsets[index.num_blocks] == index.table_offset ? binaryIO::IOErrorCode::Success : binaryIO::IOErrorCode::InvalidData;
+}
+
+// Reads the chunk header and additional header data from `state->source`, leaving it at the start of the chunk's data.
+static binaryIO::IOErrorCode DecompressStream_OpenChunk(binaryIO::IOStream* const stream, const binaryIO::IOCodec& codec)
+{
+  DecompressStreamState* const state  = DecompressStream_State(stream);
+  binaryIO::IOStream* const    source = state->source;
+
+  binaryIO::BinaryChunkHeader          header;
+  binaryIO::BinaryChunkCompressionInfo info;
+  binaryIO::BinaryChunkBlockIndexInfo  index;
+
+  const binaryIO::IOSize min_header_size = sizeof(header) + sizeof(info);
+
+  if (IOStream_Read(source, &header, sizeof(header)).ErrorCode() != binaryIO::IOErrorCode::Success || header.header_size < min_header_size ||
+      IOStream_Read(source, &info, sizeof(info)).ErrorCode() != binaryIO::IOErrorCode::Success || info.tag != binaryIO::k_ChunkCompressionTag)
+  {
+    return binaryIO::IOErrorCode::InvalidData;
+  }
+
+  if (binaryIO::CompressionCodec(info.codec) != codec.codec)
+  {
+    return binaryIO::IOErrorCode::InvalidOperation;
+  }
+
+  binaryIO::IOSize num_header_bytes_left = header.header_size - min_header_size;
+  bool             has_block_index       = false;
+
+  if (num_header_bytes_left >= sizeof(index))
+  {
+    if (IOStream_Read(source, &index, sizeof(index)).ErrorCode() != binaryIO::IOErrorCode::Success)
+    {
+      return binaryIO::IOErrorCode::InvalidData;
+    }
+
+    num_header_bytes_left -= sizeof(index);
+    has_block_index = index.tag == binaryIO::k_ChunkBlockIndexTag;
+  }
+
+  const binaryIO::IOErrorCode skip_error = DecompressStream_Skip(source, num_header_bytes_left);
+
+  if (skip_error != binaryIO::IOErrorCode::Success)
+  {
+    return skip_error;
+  }
+
+  state->total_size = info.uncompressed_size;
+  stream->Size      = &DecompressStream_Size;
+
+  if (has_block_index)
+  {
+    const binaryIO::IOErrorCode index_error = DecompressStream_LoadBlockIndex(state, index, header.data_size);
+
+    if (index_error != binaryIO::IOErrorCode::Success)
+    {
+      return index_error;
+    }
+
+    stream->Seek = &DecompressStream_Seek;
+  }
+
+  return binaryIO::IOErrorCode::Success;
+}
+
+static binaryIO::IOStream DecompressStream_CreateFromChunk(binaryIO::IOStream* const    source,
+                                                           const binaryIO::ChunkView*   chunk,
+                                                           const binaryIO::IOCodec&     codec,
+                                                           const binaryIO::IOAllocator& allocator,
+                                                           binaryIO::Executor* const    executor,
+                                                           const binaryIO::IOSize       num_blocks_in_flight)
+{
+  const binaryIO::IOSize num_slots = executor ? Compression_NumBlocksInFlight(*executor, num_blocks_in_flight) : 1u;
+  binaryIO::IOStream     result    = DecompressStream_Create(source, codec, allocator, executor, num_slots);
+
+  if (result.error_state == binaryIO::IOErrorCode::Success)
+  {
+    if (chunk)
+    {
+      DecompressStream_State(&result)->memory_source = IOStream_FromROMemory(chunk->header, chunk->header->header_size + chunk->header->data_size);
+    }
+
+    const binaryIO::IOErrorCode open_error = DecompressStream_OpenChunk(&result, codec);
+
+    if (open_error != binaryIO::IOErrorCode::Success)
+    {
+      DecompressStream_Close(&result);
+
+      result             = {};
+      result.error_state = open_error;
+    }
+  }
+
+  return result;
+}
+
+binaryIO::IOStream binaryIO::IOStream_FromDecompressor(IOStream* const source, const IOCodec& codec, const IOAllocator& allocator)
+{
+  binaryIOAssert(source != nullptr, "A decompressing stream requires a source.");
+
+  return DecompressStream_Create(source, codec, allocator, nullptr, 1u);
+}
+
+binaryIO::IOStream binaryIO::IOStream_FromParallelDecompressor(IOStream* const source, const IOCodec& codec, const IOAllocator& allocator, Executor& executor, const IOSize num_blocks_in_flight)
+{
+  binaryIOAssert(source != nullptr, "A decompressing stream requires a source.");
+
+  return DecompressStream_Create(source, codec, allocator, &executor, Compression_NumBlocksInFlight(executor, num_blocks_in_flight));
+}
+
+binaryIO::IOStream binaryIO::IOStream_FromCompressedChunk(const ChunkView& chunk, const IOCodec& codec, const IOAllocator& allocator, Executor* const executor, const IOSize num_blocks_in_flight)
+{
+  return DecompressStream_CreateFromChunk(nullptr, &chunk, codec, allocator, executor, num_blocks_in_flight);
+}
+
+binaryIO::IOStream binaryIO::IOStream_FromCompressedChunk(IOStream* const source, const IOCodec& codec, const IOAllocator& allocator, Executor* const executor, const IOSize num_blocks_in_flight)
+{
+  binaryIOAssert(source != nullptr, "A decompressing stream requires a source.");
+
+  return DecompressStream_CreateFromChunk(source, nullptr, codec, allocator, executor, num_blocks_in_flight);
+}
+
+/******************************************************************************/
+/*
+  MIT License
+
+  Copyright (c) 2024 Shareef Abdoul-Raheem
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+/******************************************************************************/
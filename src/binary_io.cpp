@@ -11,15 +11,68 @@
 /******************************************************************************/
 #include "binaryio/binary_assert.hpp"
 #include "binaryio/binary_chunk.hpp"
+#include "binaryio/binary_executor.hpp"
+#include "binaryio/binary_span_stream.hpp"
 #include "binaryio/binary_stream.hpp"
 #include "binaryio/binary_stream_ext.hpp"
 #include "binaryio/binary_types.hpp"
 
-#include <algorithm>  // rotate
-#include <cstdio>     // fprintf, stderr
-#include <cstdlib>    // abort
-#include <cstring>    // memcpy
-#include <utility>    // exchange
+#include <algorithm>           // min
+#include <atomic>              // atomic
+#include <chrono>              // steady_clock
+#include <cerrno>              // errno, EINTR
+#include <climits>             // INT_MAX
+#include <condition_variable>  // condition_variable
+#include <cstddef>             // max_align_t
+#include <cstdio>              // fprintf, stderr
+#include <cstdlib>             // abort, malloc, free
+#include <cstring>             // memcpy
+#include <limits>              // numeric_limits
+#include <mutex>               // mutex, lock_guard, unique_lock
+#include <new>                 // placement new, nothrow
+#include <system_error>        // system_error
+#include <thread>              // thread
+#include <utility>             // exchange
+#include <vector>              // vector
+
+#if defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>  // vrev16q_u8, vrev32q_u8, vrev64q_u8
+#define BINARY_IO_BYTE_SWAP_NEON 1
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>  // _mm_clmulepi64_si128, _mm_extract_epi32, _mm_shuffle_epi8
+#define BINARY_IO_CRC32_PCLMUL    1
+#define BINARY_IO_BYTE_SWAP_SSSE3 1
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>  // __cpuid
+#define BINARY_IO_TARGET_PCLMUL
+#define BINARY_IO_TARGET_SSSE3
+#else
+#define BINARY_IO_TARGET_PCLMUL __attribute__((target("pclmul,sse4.1")))
+#define BINARY_IO_TARGET_SSSE3  __attribute__((target("ssse3")))
+#endif
+#elif defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>  // __crc32d, __crc32b
+#define BINARY_IO_CRC32_ARM 1
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>  // _BitScanForward64
+#endif
+
+#if _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>  // CreateFileA, CreateFileMappingA, MapViewOfFile, UnmapViewOfFile, ReadFile, WriteFile, PrefetchVirtualMemory, GetFileSizeEx
+#include <io.h>       // _get_osfhandle, _fileno
+#else
+#include <fcntl.h>     // open, posix_fadvise
+#include <sys/mman.h>  // mmap, munmap, madvise
+#include <sys/stat.h>  // fstat
+#include <sys/uio.h>   // readv, writev
+#include <unistd.h>    // close, lseek, pread, pwrite, sysconf
+#endif
 
 // binary_assert.hpp
 
@@ -71,55 +124,177 @@ binaryIO::IOResult binaryIO::MemoryStream_CopyBytes(
   return IOResult(num_bytes_to_copy, num_bytes_to_copy == desired_number_of_bytes ? IOErrorCode::Success : IOErrorCode::EndOfStream);
 }
 
-static binaryIO::IOResult MemoryStream_Read(binaryIO::IOStream* const stream, void* const destination, const binaryIO::IOSize num_destination_bytes)
+//
+// The windows are the authoritative position of a memory stream so that users of
+// the windows and `IOStream_Read` / `IOStream_Write` observe the same cursor.
+//
+// Both windows would cover the same bytes so only one is open at a time,
+// reads open the `BufferedIO` window and writes open the `BufferedWriteIO` window over [cursor, buffer_size).
+// While writing the read window is empty and its refill switches back to reading from the write cursor.
+//
+
+static binaryIO::IOErrorCode MemoryStream_RefillAfterWrite(binaryIO::IOStream* const stream);
+
+static bool MemoryStream_IsWriting(const binaryIO::IOStream* const stream)
 {
-  binaryIO::MemoryStreamData& memory_stream = stream->user_data.memory_stream;
+  return stream->buffered_io.Refill == &MemoryStream_RefillAfterWrite;
+}
 
-  return binaryIO::MemoryStream_CopyBytes(
-   destination,
-   num_destination_bytes,
-   memory_stream.CursorBytes(),
-   memory_stream.BytesLeft(),
-   num_destination_bytes,
-   &memory_stream.cursor);
+static binaryIO::MemoryStreamData& MemoryStream_SyncFromWindow(binaryIO::IOStream* const stream)
+{
+  binaryIO::MemoryStreamData&       memory_stream = stream->user_data.memory_stream;
+  const binaryIO::BufferedIO* const buffered_io   = &stream->buffered_io;
+
+  if (MemoryStream_IsWriting(stream))
+  {
+    memory_stream.cursor = stream->buffered_write.cursor - static_cast<std::uint8_t*>(memory_stream.buffer_start);
+  }
+  // After a failed refill the window no longer refers to the memory buffer.
+  else if (buffered_io->buffer_start == memory_stream.buffer_start)
+  {
+    memory_stream.cursor = buffered_io->cursor - buffered_io->buffer_start;
+  }
+
+  return memory_stream;
 }
 
-static binaryIO::IOResult MemoryStream_Write(binaryIO::IOStream* const stream, const void* const source, const binaryIO::IOSize num_source_bytes)
+static binaryIO::IOResult MemoryStream_SyncToWindow(binaryIO::IOStream* const stream, const binaryIO::IOResult result, const bool is_writing = false)
 {
-  binaryIO::MemoryStreamData& memory_stream = stream->user_data.memory_stream;
+  const binaryIO::MemoryStreamData& memory_stream = stream->user_data.memory_stream;
+  std::uint8_t* const               cursor_bytes  = static_cast<std::uint8_t*>(memory_stream.buffer_start) + memory_stream.cursor;
 
-  return binaryIO::MemoryStream_CopyBytes(
-   memory_stream.CursorBytes(),
-   memory_stream.BytesLeft(),
-   source,
-   num_source_bytes,
-   num_source_bytes,
-   &memory_stream.cursor);
+  if (is_writing)
+  {
+    stream->buffered_io                 = binaryIO::BufferedIO{cursor_bytes, cursor_bytes, cursor_bytes, &MemoryStream_RefillAfterWrite};
+    stream->buffered_write.buffer_start = cursor_bytes;
+    stream->buffered_write.cursor       = cursor_bytes;
+    stream->buffered_write.buffer_end   = static_cast<std::uint8_t*>(memory_stream.buffer_start) + memory_stream.buffer_size;
+  }
+  else
+  {
+    stream->buffered_io                 = SetupMemoryBufferedIO(memory_stream.buffer_start, memory_stream.buffer_size);
+    stream->buffered_io.cursor          = cursor_bytes;
+    stream->buffered_write.buffer_start = nullptr;
+    stream->buffered_write.cursor       = nullptr;
+    stream->buffered_write.buffer_end   = nullptr;
+  }
+
+  return result;
+}
+
+static binaryIO::IOErrorCode MemoryStream_RefillAfterWrite(binaryIO::IOStream* const stream)
+{
+  MemoryStream_SyncToWindow(stream, binaryIO::IOResult(MemoryStream_SyncFromWindow(stream).cursor, binaryIO::IOErrorCode::Success));
+
+  // At the end of the buffer the read window's refill reports `EndOfStream`.
+  return stream->buffered_io.cursor != stream->buffered_io.buffer_end ? stream->error_state : stream->buffered_io.Refill(stream);
+}
+
+static binaryIO::IOErrorCode MemoryStream_Flush(binaryIO::IOStream* const stream)
+{
+  // The staged bytes are already in memory.
+  stream->buffered_write.buffer_start = stream->buffered_write.cursor;
+
+  return stream->error_state;
+}
+
+static binaryIO::IOResult MemoryStream_Read(binaryIO::IOStream* const stream, void* const destination, const binaryIO::IOSize num_destination_bytes)
+{
+  binaryIO::MemoryStreamData& memory_stream = MemoryStream_SyncFromWindow(stream);
+
+  return MemoryStream_SyncToWindow(
+   stream,
+   binaryIO::MemoryStream_CopyBytes(
+    destination,
+    num_destination_bytes,
+    memory_stream.CursorBytes(),
+    memory_stream.BytesLeft(),
+    num_destination_bytes,
+    &memory_stream.cursor));
+}
+
+static binaryIO::IOResult MemoryStream_Write(binaryIO::IOStream* const stream, const void* const source, const binaryIO::IOSize num_source_bytes)
+{
+  binaryIO::MemoryStreamData& memory_stream = MemoryStream_SyncFromWindow(stream);
+
+  return MemoryStream_SyncToWindow(
+   stream,
+   binaryIO::MemoryStream_CopyBytes(
+    memory_stream.CursorBytes(),
+    memory_stream.BytesLeft(),
+    source,
+    num_source_bytes,
+    num_source_bytes,
+    &memory_stream.cursor),
+   true);
 }
 
 static binaryIO::IOResult MemoryStream_Seek(binaryIO::IOStream* const stream, const binaryIO::IOOffset offset, const binaryIO::SeekOrigin seek_origin)
 {
+  binaryIO::MemoryStreamData& memory_stream = MemoryStream_SyncFromWindow(stream);
+
   const binaryIO::IOOffset base_offset[] =
    {
     0,
-    binaryIO::IOOffset(stream->user_data.memory_stream.cursor),
-    binaryIO::IOOffset(stream->user_data.memory_stream.buffer_size),
+    binaryIO::IOOffset(memory_stream.cursor),
+    binaryIO::IOOffset(memory_stream.buffer_size),
    };
 
   const binaryIO::IOOffset absolute_location = base_offset[int(seek_origin)] + offset;
 
   binaryIO::IOErrorCode err_code;
-  if (absolute_location >= 0 && binaryIO::IOSize(absolute_location) < stream->user_data.memory_stream.buffer_size)
+  // The end of the buffer is a valid position for appending or measuring what is left, reads from there hit `EndOfStream`.
+  if (absolute_location >= 0 && binaryIO::IOSize(absolute_location) <= memory_stream.buffer_size)
   {
-    stream->user_data.memory_stream.cursor = absolute_location;
-    err_code                               = binaryIO::IOErrorCode::Success;
+    memory_stream.cursor = absolute_location;
+    err_code             = binaryIO::IOErrorCode::Success;
   }
   else
   {
     err_code = binaryIO::IOErrorCode::SeekError;
   }
 
-  return binaryIO::IOResult(stream->user_data.memory_stream.cursor, err_code);
+  return MemoryStream_SyncToWindow(stream, binaryIO::IOResult(memory_stream.cursor, err_code));
+}
+
+static binaryIO::IOResult MemoryStream_ReadAt(binaryIO::IOStream* const stream, const binaryIO::IOSize offset, void* const destination, const binaryIO::IOSize num_destination_bytes)
+{
+  const binaryIO::MemoryStreamData& memory_stream = stream->user_data.memory_stream;
+
+  if (offset >= memory_stream.buffer_size)
+  {
+    return binaryIO::IOErrorCode::EndOfStream;
+  }
+
+  binaryIO::IOSize position = offset;
+
+  return binaryIO::MemoryStream_CopyBytes(
+   destination,
+   num_destination_bytes,
+   static_cast<const unsigned char*>(memory_stream.buffer_start) + offset,
+   memory_stream.buffer_size - offset,
+   num_destination_bytes,
+   &position);
+}
+
+static binaryIO::IOResult MemoryStream_WriteAt(binaryIO::IOStream* const stream, const binaryIO::IOSize offset, const void* const source, const binaryIO::IOSize num_source_bytes)
+{
+  const binaryIO::MemoryStreamData& memory_stream = stream->user_data.memory_stream;
+
+  if (offset >= memory_stream.buffer_size)
+  {
+    return binaryIO::IOErrorCode::EndOfStream;
+  }
+
+  binaryIO::IOSize position = offset;
+
+  return binaryIO::MemoryStream_CopyBytes(
+   static_cast<unsigned char*>(memory_stream.buffer_start) + offset,
+   memory_stream.buffer_size - offset,
+   source,
+   num_source_bytes,
+   num_source_bytes,
+   &position);
 }
 
 static binaryIO::IOErrorCode MemoryStream_Close(binaryIO::IOStream* const stream)
@@ -128,6 +303,16 @@ static binaryIO::IOErrorCode MemoryStream_Close(binaryIO::IOStream* const stream
   return binaryIO::IOErrorCode::Success;
 }
 
+static binaryIO::IOErrorCode MemoryStream_AdviseWillNeed(binaryIO::IOStream* const stream, const binaryIO::IOSize offset, const binaryIO::IOSize num_bytes)
+{
+  (void)stream;
+  (void)offset;
+  (void)num_bytes;
+
+  // The bytes are already resident.
+  return binaryIO::IOErrorCode::Success;
+}
+
 bool binaryIO::IOSteam_SupportsRead(const IOStream* const stream)
 {
   return stream->Read != nullptr;
@@ -143,11 +328,26 @@ bool binaryIO::IOSteam_SupportsBufferedRead(const IOStream* const stream)
   return stream->buffered_io.Refill != nullptr;
 }
 
+bool binaryIO::IOSteam_SupportsBufferedWrite(const IOStream* const stream)
+{
+  return stream->buffered_write.Flush != nullptr;
+}
+
 bool binaryIO::IOSteam_SupportsSeek(const IOStream* const stream)
 {
   return stream->Seek != nullptr;
 }
 
+bool binaryIO::IOSteam_SupportsReadAt(const IOStream* const stream)
+{
+  return stream->ReadAt != nullptr;
+}
+
+bool binaryIO::IOSteam_SupportsWriteAt(const IOStream* const stream)
+{
+  return stream->WriteAt != nullptr;
+}
+
 binaryIO::IOStream binaryIO::IOStream_FromRWMemory(void* const bytes, const IOSize num_bytes)
 {
   binaryIO::IOStream result      = {};
@@ -156,8 +356,12 @@ binaryIO::IOStream binaryIO::IOStream_FromRWMemory(void* const bytes, const IOSi
   result.Write                   = &MemoryStream_Write;
   result.Seek                    = &MemoryStream_Seek;
   result.Close                   = &MemoryStream_Close;
+  result.ReadAt                  = &MemoryStream_ReadAt;
+  result.WriteAt                 = &MemoryStream_WriteAt;
+  result.AdviseWillNeed          = &MemoryStream_AdviseWillNeed;
   result.user_data.memory_stream = MemoryStreamData{bytes, 0, num_bytes};
   result.buffered_io             = SetupMemoryBufferedIO(bytes, num_bytes);
+  result.buffered_write.Flush    = &MemoryStream_Flush;
 
   return result;
 }
@@ -170,6 +374,9 @@ binaryIO::IOStream binaryIO::IOStream_FromROMemory(const void* const bytes, cons
   result.Write                   = nullptr;
   result.Seek                    = &MemoryStream_Seek;
   result.Close                   = &MemoryStream_Close;
+  result.ReadAt                  = &MemoryStream_ReadAt;
+  result.WriteAt                 = nullptr;
+  result.AdviseWillNeed          = &MemoryStream_AdviseWillNeed;
   result.user_data.memory_stream = MemoryStreamData{const_cast<void*>(bytes), 0, num_bytes};
   result.buffered_io             = SetupMemoryBufferedIO(bytes, num_bytes);
 
@@ -184,6 +391,84 @@ static void AccumulateError(binaryIO::IOStream* const stream, const binaryIO::IO
   }
 }
 
+#if BINARY_IO_STATS
+// Statistics
+//
+//   `IOStats_Begin` returns the start time of the event that `IOStats_End` adds the duration of to the counters.
+//   The `IOResult` given to the hook's `End` is the result of the operation, for refills its value is the window size.
+//
+
+static binaryIO::IOTraceHook s_TraceHook = {};
+
+void binaryIO::IOTrace_SetHook(const IOTraceHook& hook)
+{
+  s_TraceHook = hook;
+}
+
+static std::uint64_t IOStats_Now()
+{
+  return std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+static std::uint64_t IOStats_Begin(const binaryIO::IOStream* const stream, const binaryIO::IOTraceEvent event)
+{
+  if (s_TraceHook.Begin)
+  {
+    s_TraceHook.Begin(s_TraceHook.user_data, stream, event);
+  }
+
+  return IOStats_Now();
+}
+
+static void IOStats_End(binaryIO::IOStream* const stream, const binaryIO::IOTraceEvent event, const std::uint64_t start_ns, const binaryIO::IOResult result)
+{
+  const std::uint64_t            elapsed_ns = IOStats_Now() - start_ns;
+  binaryIO::IOStreamStats* const stats      = &stream->stats;
+
+  switch (event)
+  {
+    case binaryIO::IOTraceEvent::Read:
+    {
+      stats->num_reads += 1u;
+      stats->num_bytes_read += result.Value();
+      stats->read_ns += elapsed_ns;
+      break;
+    }
+    case binaryIO::IOTraceEvent::Write:
+    {
+      stats->num_writes += 1u;
+      stats->num_bytes_written += result.Value();
+      stats->write_ns += elapsed_ns;
+      break;
+    }
+    case binaryIO::IOTraceEvent::Seek:
+    {
+      stats->num_seeks += 1u;
+      stats->seek_ns += elapsed_ns;
+      break;
+    }
+    case binaryIO::IOTraceEvent::Refill:
+    {
+      stats->num_refills += 1u;
+      stats->num_bytes_refilled += result.Value();
+      stats->refill_ns += elapsed_ns;
+      break;
+    }
+    case binaryIO::IOTraceEvent::Flush:
+    {
+      stats->num_flushes += 1u;
+      stats->flush_ns += elapsed_ns;
+      break;
+    }
+  }
+
+  if (s_TraceHook.End)
+  {
+    s_TraceHook.End(s_TraceHook.user_data, stream, event, result);
+  }
+}
+#endif
+
 binaryIO::IOErrorCode binaryIO::IOStream_ResetErrorState(IOStream* const stream)
 {
   return std::exchange(stream->error_state, IOErrorCode::Success);
@@ -200,6 +485,25 @@ binaryIO::IOResult binaryIO::IOStream_Size(IOStream* const stream)
   return binaryIO::IOErrorCode::InvalidOperation;
 }
 
+binaryIO::IOResult binaryIO::IOStream_Remaining(IOStream* const stream)
+{
+  const binaryIO::IOResult size = IOStream_Size(stream);
+
+  if (size.ErrorCode() != binaryIO::IOErrorCode::Success)
+  {
+    return size;
+  }
+
+  const binaryIO::IOResult position = IOStream_Seek(stream, 0, binaryIO::SeekOrigin::CURRENT);
+
+  if (position.ErrorCode() != binaryIO::IOErrorCode::Success)
+  {
+    return position.ErrorCode();
+  }
+
+  return size.Value() > position.Value() ? size.Value() - position.Value() : 0u;
+}
+
 binaryIO::IOResult binaryIO::IOStream_Read(IOStream* const stream, void* const destination, const IOSize num_destination_bytes)
 {
   if (num_destination_bytes == 0)
@@ -209,7 +513,13 @@ binaryIO::IOResult binaryIO::IOStream_Read(IOStream* const stream, void* const d
 
   if (stream->Read)
   {
+#if BINARY_IO_STATS
+    const std::uint64_t stats_start_ns = IOStats_Begin(stream, binaryIO::IOTraceEvent::Read);
+#endif
     const binaryIO::IOResult result = stream->Read(stream, destination, num_destination_bytes);
+#if BINARY_IO_STATS
+    IOStats_End(stream, binaryIO::IOTraceEvent::Read, stats_start_ns, result);
+#endif
 
     AccumulateError(stream, result.ErrorCode());
     return result;
@@ -228,7 +538,13 @@ binaryIO::IOResult binaryIO::IOStream_Write(IOStream* const stream, const void*
 
   if (stream->Write)
   {
+#if BINARY_IO_STATS
+    const std::uint64_t stats_start_ns = IOStats_Begin(stream, binaryIO::IOTraceEvent::Write);
+#endif
     const binaryIO::IOResult result = stream->Write(stream, source, num_source_bytes);
+#if BINARY_IO_STATS
+    IOStats_End(stream, binaryIO::IOTraceEvent::Write, stats_start_ns, result);
+#endif
 
     AccumulateError(stream, result.ErrorCode());
     return result;
@@ -242,7 +558,13 @@ binaryIO::IOResult binaryIO::IOStream_Seek(IOStream* const stream, const IOOffse
 {
   if (stream->Seek)
   {
+#if BINARY_IO_STATS
+    const std::uint64_t stats_start_ns = IOStats_Begin(stream, binaryIO::IOTraceEvent::Seek);
+#endif
     const binaryIO::IOResult result = stream->Seek(stream, offset, seek_origin);
+#if BINARY_IO_STATS
+    IOStats_End(stream, binaryIO::IOTraceEvent::Seek, stats_start_ns, result);
+#endif
 
     AccumulateError(stream, result.ErrorCode());
     return result;
@@ -252,6 +574,102 @@ binaryIO::IOResult binaryIO::IOStream_Seek(IOStream* const stream, const IOOffse
   return binaryIO::IOErrorCode::InvalidOperation;
 }
 
+binaryIO::IOResult binaryIO::IOStream_ReadV(IOStream* const stream, const IOSegment* const segments, const IOSize num_segments)
+{
+  if (stream->ReadV)
+  {
+#if BINARY_IO_STATS
+    const std::uint64_t stats_start_ns = IOStats_Begin(stream, binaryIO::IOTraceEvent::Read);
+#endif
+    const binaryIO::IOResult result = stream->ReadV(stream, segments, num_segments);
+#if BINARY_IO_STATS
+    IOStats_End(stream, binaryIO::IOTraceEvent::Read, stats_start_ns, result);
+#endif
+
+    AccumulateError(stream, result.ErrorCode());
+    return result;
+  }
+
+  binaryIO::IOSize num_bytes_read = 0u;
+
+  for (binaryIO::IOSize i = 0u; i < num_segments; ++i)
+  {
+    const binaryIO::IOResult result = IOStream_Read(stream, segments[i].bytes, segments[i].num_bytes);
+
+    num_bytes_read += result.Value();
+
+    if (result.ErrorCode() != binaryIO::IOErrorCode::Success)
+    {
+      return binaryIO::IOResult(num_bytes_read, result.ErrorCode());
+    }
+  }
+
+  return binaryIO::IOResult(num_bytes_read, binaryIO::IOErrorCode::Success);
+}
+
+binaryIO::IOResult binaryIO::IOStream_WriteV(IOStream* const stream, const IOConstSegment* const segments, const IOSize num_segments)
+{
+  if (stream->WriteV)
+  {
+#if BINARY_IO_STATS
+    const std::uint64_t stats_start_ns = IOStats_Begin(stream, binaryIO::IOTraceEvent::Write);
+#endif
+    const binaryIO::IOResult result = stream->WriteV(stream, segments, num_segments);
+#if BINARY_IO_STATS
+    IOStats_End(stream, binaryIO::IOTraceEvent::Write, stats_start_ns, result);
+#endif
+
+    AccumulateError(stream, result.ErrorCode());
+    return result;
+  }
+
+  binaryIO::IOSize num_bytes_written = 0u;
+
+  for (binaryIO::IOSize i = 0u; i < num_segments; ++i)
+  {
+    const binaryIO::IOResult result = IOStream_Write(stream, segments[i].bytes, segments[i].num_bytes);
+
+    num_bytes_written += result.Value();
+
+    if (result.ErrorCode() != binaryIO::IOErrorCode::Success)
+    {
+      return binaryIO::IOResult(num_bytes_written, result.ErrorCode());
+    }
+  }
+
+  return binaryIO::IOResult(num_bytes_written, binaryIO::IOErrorCode::Success);
+}
+
+binaryIO::IOResult binaryIO::IOStream_ReadAt(IOStream* const stream, const IOSize offset, void* const destination, const IOSize num_destination_bytes)
+{
+  if (!stream->ReadAt)
+  {
+    return binaryIO::IOErrorCode::InvalidOperation;
+  }
+
+  if (num_destination_bytes == 0)
+  {
+    return binaryIO::IOErrorCode::Success;
+  }
+
+  return stream->ReadAt(stream, offset, destination, num_destination_bytes);
+}
+
+binaryIO::IOResult binaryIO::IOStream_WriteAt(IOStream* const stream, const IOSize offset, const void* const source, const IOSize num_source_bytes)
+{
+  if (!stream->WriteAt)
+  {
+    return binaryIO::IOErrorCode::InvalidOperation;
+  }
+
+  if (num_source_bytes == 0)
+  {
+    return binaryIO::IOErrorCode::Success;
+  }
+
+  return stream->WriteAt(stream, offset, source, num_source_bytes);
+}
+
 binaryIO::IOErrorCode binaryIO::IOStream_Close(IOStream* const stream)
 {
   if (stream->Close)
@@ -278,7 +696,13 @@ binaryIO::IOErrorCode binaryIO::BufferedIO_Refill(IOStream* const stream)
   {
     binaryIOAssert(buffered_io->cursor == buffered_io->buffer_end, "Expected to have read all of the buffered data.");
 
+#if BINARY_IO_STATS
+    const std::uint64_t stats_start_ns = IOStats_Begin(stream, binaryIO::IOTraceEvent::Refill);
+#endif
     const binaryIO::IOErrorCode result = buffered_io->Refill(stream);
+#if BINARY_IO_STATS
+    IOStats_End(stream, binaryIO::IOTraceEvent::Refill, stats_start_ns, binaryIO::IOResult(result == binaryIO::IOErrorCode::Success ? IOSize(buffered_io->buffer_end - buffered_io->buffer_start) : 0u, result));
+#endif
 
     binaryIOAssert(buffered_io->cursor == buffered_io->buffer_start && buffered_io->cursor < buffered_io->buffer_end,
                    "Invalid refill function, cursor must be in buffer range.");
@@ -341,130 +765,2413 @@ binaryIO::IOErrorCode binaryIO::BufferedIO_Failure(IOStream* const stream, const
     return stream->error_state;
   };
 
-  return error_code;
+  // Failure is usually reported from within a refill so the window must satisfy the refill post-condition.
+  return stream->buffered_io.Refill(stream);
 }
 
-// binary_api_ext.hpp
+binaryIO::IOSize binaryIO::BufferedWrite_NumBytesAvailable(const IOStream* const stream)
+{
+  return stream->buffered_write.buffer_end - stream->buffered_write.cursor;
+}
 
-static binaryIO::IOResult CFile_Read(binaryIO::IOStream* const stream, void* const destination, const binaryIO::IOSize num_destination_bytes)
+binaryIO::IOErrorCode binaryIO::BufferedWrite_Flush(IOStream* const stream)
 {
-  std::FILE* const file_handle = static_cast<std::FILE*>(stream->user_data.values[0].as_handle);
+  const binaryIO::BufferedWriteIO* const buffered_write = &stream->buffered_write;
 
-  if (std::feof(file_handle))
+  if (buffered_write->Flush)
   {
-    return BufferedIO_Failure(stream, binaryIO::IOErrorCode::EndOfStream);
+#if BINARY_IO_STATS
+    const std::uint64_t stats_start_ns = IOStats_Begin(stream, binaryIO::IOTraceEvent::Flush);
+#endif
+    const binaryIO::IOErrorCode result = buffered_write->Flush(stream);
+#if BINARY_IO_STATS
+    IOStats_End(stream, binaryIO::IOTraceEvent::Flush, stats_start_ns, result);
+#endif
+
+    binaryIOAssert(buffered_write->cursor == buffered_write->buffer_start, "Invalid flush function, cursor must be reset to the start of the buffer.");
+
+    AccumulateError(stream, result);
+    return result;
   }
 
-  const std::size_t           num_bytes_read = std::fread(destination, sizeof(unsigned char), num_destination_bytes, file_handle);
-  const binaryIO::IOErrorCode error_code     = (num_bytes_read == num_destination_bytes) ? binaryIO::IOErrorCode::Success : binaryIO::IOErrorCode::ReadError;
+  return binaryIO::IOErrorCode::Success;
+}
 
-  return binaryIO::IOResult(num_bytes_read, error_code);
+// Endianess Handling
+
+template<typename UInt>
+static UInt ByteSwapScalar(const UInt value)
+{
+  if constexpr (sizeof(UInt) == 2)
+  {
+    return UInt((value >> 8) | (value << 8));
+  }
+  else if constexpr (sizeof(UInt) == 4)
+  {
+#if defined(_MSC_VER) && !defined(__clang__)
+    return _byteswap_ulong(value);
+#else
+    return __builtin_bswap32(value);
+#endif
+  }
+  else
+  {
+#if defined(_MSC_VER) && !defined(__clang__)
+    return _byteswap_uint64(value);
+#else
+    return __builtin_bswap64(value);
+#endif
+  }
 }
 
-static binaryIO::IOResult CFile_Write(binaryIO::IOStream* const stream, const void* const source, const binaryIO::IOSize num_source_bytes)
+#if BINARY_IO_BYTE_SWAP_SSSE3
+static bool ByteSwap_CPUSupportsSSSE3()
 {
-  std::FILE* const            file_handle       = static_cast<std::FILE*>(stream->user_data.values[0].as_handle);
-  const std::size_t           num_bytes_written = std::fwrite(source, sizeof(unsigned char), num_source_bytes, file_handle);
-  const binaryIO::IOErrorCode error_code        = (num_bytes_written == num_source_bytes) ? binaryIO::IOErrorCode::Success : binaryIO::IOErrorCode::UnknownError;
+#if defined(__SSSE3__) || defined(__AVX__)
+  return true;
+#elif defined(_MSC_VER) && !defined(__clang__)
+  int cpu_info[4];
+  __cpuid(cpu_info, 1);
 
-  return binaryIO::IOResult(num_bytes_written, error_code);
+  return (cpu_info[2] & (1 << 9)) != 0;
+#else
+  return __builtin_cpu_supports("ssse3");
+#endif
 }
 
-static binaryIO::IOResult CFile_Seek(binaryIO::IOStream* const stream, const binaryIO::IOOffset offset, const binaryIO::SeekOrigin seek_origin)
+// Swaps whole vectors only, returns the number of elements swapped.
+template<typename UInt>
+BINARY_IO_TARGET_SSSE3 static binaryIO::IOSize ByteSwapArraySSSE3(std::uint8_t* destination, const std::uint8_t* source, const binaryIO::IOSize num_elements)
 {
-  std::FILE* const file_handle = static_cast<std::FILE*>(stream->user_data.values[0].as_handle);
+  static constexpr std::size_t k_VectorSize        = 16u;
+  static constexpr std::size_t k_ElementsPerVector = k_VectorSize / sizeof(UInt);
 
-  const int file_origin = [](const binaryIO::SeekOrigin seek_origin) -> int {
-    switch (seek_origin)
-    {
-      case binaryIO::SeekOrigin::BEGIN: return SEEK_SET;
-      case binaryIO::SeekOrigin::CURRENT: return SEEK_CUR;
-      case binaryIO::SeekOrigin::END: return SEEK_END;
+  __m128i shuffle_mask;
+
+  if constexpr (sizeof(UInt) == 2) { shuffle_mask = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14); }
+  else if constexpr (sizeof(UInt) == 4) { shuffle_mask = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12); }
+  else { shuffle_mask = _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8); }
+
+  const binaryIO::IOSize num_vectors = num_elements / k_ElementsPerVector;
+
+  for (binaryIO::IOSize i = 0u; i < num_vectors; ++i)
+  {
+    const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), _mm_shuffle_epi8(bytes, shuffle_mask));
+
+    source += k_VectorSize;
+    destination += k_VectorSize;
+  }
+
+  return num_vectors * k_ElementsPerVector;
+}
+#endif
+
+template<typename UInt>
+static void ByteSwapArrayImpl(std::uint8_t* destination, const std::uint8_t* source, binaryIO::IOSize num_elements)
+{
+#if BINARY_IO_BYTE_SWAP_SSSE3
+  // Chosen at runtime so that default x86-64 builds still get the shuffle.
+  static const bool s_HasSSSE3 = ByteSwap_CPUSupportsSSSE3();
+
+  if (s_HasSSSE3)
+  {
+    const binaryIO::IOSize num_swapped = ByteSwapArraySSSE3<UInt>(destination, source, num_elements);
+
+    source += num_swapped * sizeof(UInt);
+    destination += num_swapped * sizeof(UInt);
+    num_elements -= num_swapped;
+  }
+#elif BINARY_IO_BYTE_SWAP_NEON
+  static constexpr std::size_t k_VectorSize        = 16u;
+  static constexpr std::size_t k_ElementsPerVector = k_VectorSize / sizeof(UInt);
+
+  for (; num_elements >= k_ElementsPerVector; num_elements -= k_ElementsPerVector)
+  {
+    const uint8x16_t bytes = vld1q_u8(source);
+
+    if constexpr (sizeof(UInt) == 2) { vst1q_u8(destination, vrev16q_u8(bytes)); }
+    else if constexpr (sizeof(UInt) == 4) { vst1q_u8(destination, vrev32q_u8(bytes)); }
+    else { vst1q_u8(destination, vrev64q_u8(bytes)); }
+
+    source += k_VectorSize;
+    destination += k_VectorSize;
+  }
+#endif
+
+  for (; num_elements != 0u; --num_elements)
+  {
+    UInt value;
+    std::memcpy(&value, source, sizeof(value));
+    value = ByteSwapScalar(value);
+    std::memcpy(destination, &value, sizeof(value));
+
+    source += sizeof(UInt);
+    destination += sizeof(UInt);
+  }
+}
+
+void binaryIO::detail::byteSwapArray(void* const destination, const void* const source, const IOSize num_elements, const IOSize element_size)
+{
+  std::uint8_t* const       dst = static_cast<std::uint8_t*>(destination);
+  const std::uint8_t* const src = static_cast<const std::uint8_t*>(source);
+
+  switch (element_size)
+  {
+    case 1:
+    {
+      if (dst != src)
+      {
+        std::memmove(dst, src, num_elements);
+      }
+      break;
+    }
+    case 2: ByteSwapArrayImpl<std::uint16_t>(dst, src, num_elements); break;
+    case 4: ByteSwapArrayImpl<std::uint32_t>(dst, src, num_elements); break;
+    case 8: ByteSwapArrayImpl<std::uint64_t>(dst, src, num_elements); break;
+    default:
+    {
+      binaryIOAssert(false, "Unsupported element size for byte swapping.");
+      break;
+    }
+  }
+}
+
+binaryIO::IOResult binaryIO::detail::writeArrayXEndian(IOStream* const stream, const void* const values, const IOSize num_elements, const IOSize element_size, const bool needs_byte_swap)
+{
+  if (!needs_byte_swap || element_size == 1u)
+  {
+    return IOStream_Write(stream, values, num_elements * element_size);
+  }
+
+  static constexpr IOSize k_StagingBufferSize = 4096u;
+
+  alignas(16) std::uint8_t staging_buffer[k_StagingBufferSize];
+  const std::uint8_t*      source                 = static_cast<const std::uint8_t*>(values);
+  const IOSize             num_elements_per_stage = k_StagingBufferSize / element_size;
+  IOSize                   num_elements_left      = num_elements;
+  IOSize                   num_bytes_written      = 0u;
+
+  while (num_elements_left != 0u)
+  {
+    const IOSize num_stage_elements = std::min(num_elements_left, num_elements_per_stage);
+    const IOSize num_stage_bytes    = num_stage_elements * element_size;
+
+    byteSwapArray(staging_buffer, source, num_stage_elements, element_size);
+
+    const IOResult write_result = IOStream_Write(stream, staging_buffer, num_stage_bytes);
+
+    num_bytes_written += write_result.Value();
+
+    if (write_result.ErrorCode() != IOErrorCode::Success)
+    {
+      return IOResult(num_bytes_written, write_result.ErrorCode());
+    }
+
+    source += num_stage_bytes;
+    num_elements_left -= num_stage_elements;
+  }
+
+  return IOResult(num_bytes_written, IOErrorCode::Success);
+}
+
+binaryIO::IOResult binaryIO::detail::readArrayXEndian(IOStream* const stream, void* const values, const IOSize num_elements, const IOSize element_size, const bool needs_byte_swap)
+{
+  const IOResult read_result = IOStream_Read(stream, values, num_elements * element_size);
+
+  if (needs_byte_swap && element_size != 1u)
+  {
+    // Only whole elements are converted on a short read.
+    byteSwapArray(values, values, read_result.Value() / element_size, element_size);
+  }
+
+  return read_result;
+}
+
+// Variable Length Integers
+
+binaryIO::IOResult binaryIO::detail::readVarUIntSlow(IOStream* const stream, std::uint64_t* const out_value, const unsigned num_bits)
+{
+  const binaryIO::IOSize max_bytes = (num_bits + 6u) / 7u;
+  std::uint64_t          value     = 0u;
+
+  for (binaryIO::IOSize i = 0u; i < max_bytes; ++i)
+  {
+    std::uint8_t             byte;
+    const binaryIO::IOResult result = IOStream_Read(stream, &byte, 1u);
+
+    if (result.ErrorCode() != binaryIO::IOErrorCode::Success)
+    {
+      return binaryIO::IOResult(i, result.ErrorCode());
+    }
+
+    const unsigned      shift = unsigned(i * 7u);
+    const std::uint64_t group = byte & 0x7Fu;
+
+    if (num_bits - shift < 7u && (group >> (num_bits - shift)) != 0u)
+    {
+      break;
+    }
+
+    value |= group << shift;
+
+    if ((byte & 0x80u) == 0u)
+    {
+      if (i != 0u && byte == 0u)
+      {
+        break;
+      }
+
+      *out_value = value;
+      return binaryIO::IOResult(i + 1u, binaryIO::IOErrorCode::Success);
+    }
+  }
+
+  AccumulateError(stream, binaryIO::IOErrorCode::InvalidData);
+  return binaryIO::IOErrorCode::InvalidData;
+}
+
+static unsigned VarInt_CountTrailingZeros(const std::uint64_t value)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+  unsigned long index;
+  _BitScanForward64(&index, value);
+  return unsigned(index);
+#else
+  return unsigned(__builtin_ctzll(value));
+#endif
+}
+
+//
+// Decodes while at least 16 bytes remain so that every 8 byte load and every value is in bounds.
+//
+// Each 8 byte load decodes every value that ends within it, the lengths come from the clear
+// continuation bits and the 7 bit groups are packed together with shifts and masks.
+// Advancing by whole words keeps the load -> length -> next load dependency to one per word
+// rather than one per value which is what limits a byte at a time decoder on mixed lengths.
+//
+template<typename UInt>
+static const std::uint8_t* VarInt_DecodeKernel(const std::uint8_t* bytes, const std::uint8_t* const bytes_end, UInt* const values, const binaryIO::IOSize num_values, binaryIO::IOSize* const in_out_index, bool* const out_is_invalid)
+{
+  constexpr std::uint64_t k_HighBits = 0x8080808080808080u;
+
+  binaryIO::IOSize i = *in_out_index;
+
+  while (i != num_values && bytes_end - bytes >= 16)
+  {
+    std::uint64_t word;
+    std::memcpy(&word, bytes, sizeof(word));
+
+    if constexpr (!binaryIO::k_HostIsLittleEndian)
+    {
+      word = ByteSwapScalar(word);
+    }
+
+    std::uint64_t stop_bits = ~word & k_HighBits;
+
+    // Longer than 8 bytes, only a 64 bit value can be this long.
+    if (stop_bits == 0u)
+    {
+      const binaryIO::IOSize num_bytes = binaryIO::detail::decodeVarUInt(bytes, &values[i]);
+
+      if (num_bytes == 0u)
+      {
+        *out_is_invalid = true;
+        break;
+      }
+
+      ++i;
+      bytes += num_bytes;
+      continue;
+    }
+
+    // A word holds at most 8 values, close to the end only the first value is taken.
+    if (num_values - i < 8u)
+    {
+      stop_bits &= ~(stop_bits - 1u);
+    }
+
+    // A zero byte right after a continuation byte ends an overlong value, only the values before it are taken.
+    const std::uint64_t zero_bytes         = ~(((word & ~k_HighBits) + ~k_HighBits) | word) & k_HighBits;
+    const std::uint64_t overlong_stop_bits = zero_bytes & (word << 8u) & stop_bits;
+
+    if (overlong_stop_bits != 0u)
+    {
+      *out_is_invalid = true;
+      stop_bits &= (overlong_stop_bits & (0u - overlong_stop_bits)) - 1u;
+
+      if (stop_bits == 0u)
+      {
+        break;
+      }
+    }
+
+    unsigned num_consumed_bits = 0u;
+
+    do
+    {
+      const unsigned value_end_bit = (VarInt_CountTrailingZeros(stop_bits) | 7u) + 1u;
+
+      std::uint64_t groups = (word & (~std::uint64_t(0u) >> (64u - value_end_bit))) >> num_consumed_bits & ~k_HighBits;
+      groups               = ((groups & 0x7F007F007F007F00u) >> 1u) | (groups & 0x007F007F007F007Fu);
+      groups               = ((groups & 0x3FFF00003FFF0000u) >> 2u) | (groups & 0x00003FFF00003FFFu);
+      groups               = ((groups & 0x0FFFFFFF00000000u) >> 4u) | (groups & 0x000000000FFFFFFFu);
+
+      bool is_out_of_range = (value_end_bit - num_consumed_bits) / 8u > binaryIO::detail::k_VarIntMaxBytes<UInt>;
+
+      if constexpr (sizeof(UInt) < sizeof(groups))
+      {
+        is_out_of_range |= (groups >> (sizeof(UInt) * CHAR_BIT)) != 0u;
+      }
+
+      if (is_out_of_range)
+      {
+        *out_is_invalid = true;
+        break;
+      }
+
+      values[i++]       = UInt(groups);
+      num_consumed_bits = value_end_bit;
+      stop_bits &= stop_bits - 1u;
+    } while (stop_bits != 0u);
+
+    bytes += num_consumed_bits / 8u;
+
+    if (*out_is_invalid)
+    {
+      break;
+    }
+  }
+
+  *in_out_index = i;
+
+  return bytes;
+}
+
+template<typename UInt>
+static binaryIO::IOResult VarInt_ReadArray(binaryIO::IOStream* const stream, UInt* const values, const binaryIO::IOSize num_values)
+{
+  binaryIO::BufferedIO* const buffered_io = &stream->buffered_io;
+  binaryIO::IOSize            num_read    = 0u;
+
+  while (num_read != num_values)
+  {
+    bool is_invalid = false;
+
+    if (binaryIO::detail::readWindowSize(stream) != 0u)
+    {
+      buffered_io->cursor = VarInt_DecodeKernel(buffered_io->cursor, buffered_io->buffer_end, values, num_values, &num_read, &is_invalid);
+    }
+
+    if (is_invalid)
+    {
+      AccumulateError(stream, binaryIO::IOErrorCode::InvalidData);
+      return binaryIO::IOResult(num_read, binaryIO::IOErrorCode::InvalidData);
+    }
+
+    if (num_read == num_values)
+    {
+      break;
+    }
+
+    // Close to the end of the window, or no window at all, decode a single value which may also refill.
+    const binaryIO::IOErrorCode read_error = binaryIO::detail::readVarUInt(stream, &values[num_read]).ErrorCode();
+
+    if (read_error != binaryIO::IOErrorCode::Success)
+    {
+      return binaryIO::IOResult(num_read, read_error);
+    }
+
+    ++num_read;
+  }
+
+  return binaryIO::IOResult(num_read, binaryIO::IOErrorCode::Success);
+}
+
+template<typename UInt>
+static binaryIO::IOResult VarInt_WriteArray(binaryIO::IOStream* const stream, const UInt* const values, const binaryIO::IOSize num_values)
+{
+  std::uint8_t     staging[1024];
+  binaryIO::IOSize num_staged  = 0u;
+  binaryIO::IOSize num_written = 0u;
+
+  for (binaryIO::IOSize i = 0u; i < num_values; ++i)
+  {
+    if (sizeof(staging) - num_staged < binaryIO::detail::k_VarIntMaxBytes<UInt>)
+    {
+      const binaryIO::IOResult result = IOStream_Write(stream, staging, num_staged);
+
+      num_written += result.Value();
+      num_staged = 0u;
+
+      if (result.ErrorCode() != binaryIO::IOErrorCode::Success)
+      {
+        return binaryIO::IOResult(num_written, result.ErrorCode());
+      }
+    }
+
+    num_staged += binaryIO::detail::encodeVarUInt(staging + num_staged, values[i]);
+  }
+
+  const binaryIO::IOResult result = IOStream_Write(stream, staging, num_staged);
+
+  return binaryIO::IOResult(num_written + result.Value(), result.ErrorCode());
+}
+
+binaryIO::IOResult binaryIO::writeVarUIntArray(IOStream* const stream, const std::uint32_t* const values, const IOSize num_values)
+{
+  return VarInt_WriteArray(stream, values, num_values);
+}
+
+binaryIO::IOResult binaryIO::writeVarUIntArray(IOStream* const stream, const std::uint64_t* const values, const IOSize num_values)
+{
+  return VarInt_WriteArray(stream, values, num_values);
+}
+
+binaryIO::IOResult binaryIO::readVarUIntArray(IOStream* const stream, std::uint32_t* const values, const IOSize num_values)
+{
+  return VarInt_ReadArray(stream, values, num_values);
+}
+
+binaryIO::IOResult binaryIO::readVarUIntArray(IOStream* const stream, std::uint64_t* const values, const IOSize num_values)
+{
+  return VarInt_ReadArray(stream, values, num_values);
+}
+
+// Buffered Stream Adapter
+//
+// The scratch buffer is used as either the read window or the write window, never both at once.
+//
+// user_data.values[0] : IOStream* (inner stream)
+// user_data.values[1] : uint8_t*  (scratch buffer)
+// user_data.values[2] : IOSize    (scratch buffer size)
+//
+
+static binaryIO::IOStream* BufferedStream_Inner(const binaryIO::IOStream* const stream)
+{
+  return static_cast<binaryIO::IOStream*>(stream->user_data.values[0].as_handle);
+}
+
+static std::uint8_t* BufferedStream_Scratch(const binaryIO::IOStream* const stream)
+{
+  return static_cast<std::uint8_t*>(stream->user_data.values[1].as_handle);
+}
+
+static binaryIO::IOSize BufferedStream_ScratchSize(const binaryIO::IOStream* const stream)
+{
+  return stream->user_data.values[2].as_size;
+}
+
+static binaryIO::IOErrorCode BufferedStream_Refill(binaryIO::IOStream* const stream);
+
+static void BufferedStream_ResetReadWindow(binaryIO::IOStream* const stream)
+{
+  std::uint8_t* const scratch = BufferedStream_Scratch(stream);
+
+  stream->buffered_io.buffer_start = scratch;
+  stream->buffered_io.cursor       = scratch;
+  stream->buffered_io.buffer_end   = scratch;
+  stream->buffered_io.Refill       = BufferedStream_Inner(stream)->Read ? &BufferedStream_Refill : nullptr;
+}
+
+static binaryIO::IOErrorCode BufferedStream_Flush(binaryIO::IOStream* const stream)
+{
+  binaryIO::BufferedWriteIO* const buffered_write  = &stream->buffered_write;
+  const binaryIO::IOSize           num_staged_bytes = buffered_write->cursor - buffered_write->buffer_start;
+
+  buffered_write->cursor = buffered_write->buffer_start;
+
+  if (num_staged_bytes != 0u)
+  {
+    return IOStream_Write(BufferedStream_Inner(stream), buffered_write->buffer_start, num_staged_bytes).ErrorCode();
+  }
+
+  return binaryIO::IOErrorCode::Success;
+}
+
+//
+// Commits any staged bytes and closes the write window so that the scratch buffer may be used for reading.
+//
+static binaryIO::IOErrorCode BufferedStream_EndWrite(binaryIO::IOStream* const stream)
+{
+  const binaryIO::IOErrorCode result = BufferedStream_Flush(stream);
+
+  stream->buffered_write.buffer_end = stream->buffered_write.buffer_start;
+
+  return result;
+}
+
+static binaryIO::IOErrorCode BufferedStream_Refill(binaryIO::IOStream* const stream)
+{
+  const binaryIO::IOErrorCode write_error = BufferedStream_EndWrite(stream);
+
+  if (write_error != binaryIO::IOErrorCode::Success)
+  {
+    return BufferedIO_Failure(stream, write_error);
+  }
+
+  std::uint8_t* const         scratch     = BufferedStream_Scratch(stream);
+  const binaryIO::IOResult    read_result = IOStream_Read(BufferedStream_Inner(stream), scratch, BufferedStream_ScratchSize(stream));
+  const binaryIO::IOSize      num_read    = read_result.Value();
+  binaryIO::BufferedIO* const buffered_io = &stream->buffered_io;
+
+  // A short read still refills the window, the error will resurface on the next refill.
+  if (num_read != 0u)
+  {
+    buffered_io->buffer_start = scratch;
+    buffered_io->cursor       = scratch;
+    buffered_io->buffer_end   = scratch + num_read;
+
+    return binaryIO::IOErrorCode::Success;
+  }
+
+  return BufferedIO_Failure(stream, read_result.ErrorCode() != binaryIO::IOErrorCode::Success ? read_result.ErrorCode() : binaryIO::IOErrorCode::EndOfStream);
+}
+
+static bool BufferedStream_HasFailed(const binaryIO::IOStream* const stream)
+{
+  const auto refill = stream->buffered_io.Refill;
+
+  return refill != nullptr && refill != &BufferedStream_Refill;
+}
+
+//
+// The inner stream has been read past the logical position by the number of buffered bytes,
+// this rewinds the inner stream so that it is in sync and empties the read window.
+//
+static binaryIO::IOErrorCode BufferedStream_SyncInner(binaryIO::IOStream* const stream)
+{
+  const binaryIO::IOSize num_buffered_bytes = BufferedIO_NumBytesAvailable(stream);
+
+  if (num_buffered_bytes != 0u && stream->buffered_io.Refill == &BufferedStream_Refill)
+  {
+    const binaryIO::IOErrorCode seek_error = IOStream_Seek(BufferedStream_Inner(stream), -binaryIO::IOOffset(num_buffered_bytes), binaryIO::SeekOrigin::CURRENT).ErrorCode();
+
+    if (seek_error != binaryIO::IOErrorCode::Success)
+    {
+      return seek_error;
+    }
+  }
+
+  BufferedStream_ResetReadWindow(stream);
+  return binaryIO::IOErrorCode::Success;
+}
+
+static binaryIO::IOResult BufferedStream_Size(binaryIO::IOStream* const stream)
+{
+  const binaryIO::IOErrorCode write_error = BufferedStream_Flush(stream);
+
+  if (write_error != binaryIO::IOErrorCode::Success)
+  {
+    return write_error;
+  }
+
+  return IOStream_Size(BufferedStream_Inner(stream));
+}
+
+static binaryIO::IOResult BufferedStream_Read(binaryIO::IOStream* const stream, void* const destination, const binaryIO::IOSize num_destination_bytes)
+{
+  const binaryIO::IOErrorCode write_error = BufferedStream_EndWrite(stream);
+
+  if (write_error != binaryIO::IOErrorCode::Success)
+  {
+    return write_error;
+  }
+
+  const binaryIO::IOSize      scratch_size = BufferedStream_ScratchSize(stream);
+  binaryIO::BufferedIO* const buffered_io  = &stream->buffered_io;
+  std::uint8_t*               write_cursor = static_cast<std::uint8_t*>(destination);
+  binaryIO::IOSize            num_left     = num_destination_bytes;
+
+  while (num_left != 0u)
+  {
+    // After a failed refill the window is the zero buffer which must not be returned as data.
+    if (BufferedStream_HasFailed(stream))
+    {
+      return binaryIO::IOResult(num_destination_bytes - num_left, stream->error_state);
+    }
+
+    if (buffered_io->cursor == buffered_io->buffer_end)
+    {
+      // Large reads bypass the scratch buffer to avoid a redundant copy.
+      if (num_left >= scratch_size && buffered_io->Refill == &BufferedStream_Refill)
+      {
+        const binaryIO::IOResult read_result = IOStream_Read(BufferedStream_Inner(stream), write_cursor, num_left);
+
+        return binaryIO::IOResult((num_destination_bytes - num_left) + read_result.Value(), read_result.ErrorCode());
+      }
+
+      const binaryIO::IOErrorCode refill_error = BufferedIO_Refill(stream);
+
+      if (refill_error != binaryIO::IOErrorCode::Success)
+      {
+        return binaryIO::IOResult(num_destination_bytes - num_left, refill_error);
+      }
+    }
+
+    const binaryIO::IOSize num_bytes_to_copy = std::min(num_left, BufferedIO_NumBytesAvailable(stream));
+
+    std::memcpy(write_cursor, buffered_io->cursor, num_bytes_to_copy);
+
+    write_cursor += num_bytes_to_copy;
+    num_left -= num_bytes_to_copy;
+    buffered_io->cursor += num_bytes_to_copy;
+  }
+
+  return binaryIO::IOResult(num_destination_bytes, binaryIO::IOErrorCode::Success);
+}
+
+static binaryIO::IOResult BufferedStream_Write(binaryIO::IOStream* const stream, const void* const source, const binaryIO::IOSize num_source_bytes)
+{
+  binaryIO::BufferedWriteIO* const buffered_write = &stream->buffered_write;
+
+  // Switching from reading to writing.
+  if (buffered_write->buffer_end == buffered_write->buffer_start)
+  {
+    const binaryIO::IOErrorCode sync_error = BufferedStream_SyncInner(stream);
+
+    if (sync_error != binaryIO::IOErrorCode::Success)
+    {
+      return sync_error;
+    }
+
+    buffered_write->buffer_start = BufferedStream_Scratch(stream);
+    buffered_write->cursor       = buffered_write->buffer_start;
+    buffered_write->buffer_end   = buffered_write->buffer_start + BufferedStream_ScratchSize(stream);
+  }
+
+  if (num_source_bytes > BufferedWrite_NumBytesAvailable(stream))
+  {
+    const binaryIO::IOErrorCode flush_error = BufferedStream_Flush(stream);
+
+    if (flush_error != binaryIO::IOErrorCode::Success)
+    {
+      return flush_error;
+    }
+
+    // Large writes bypass the scratch buffer to avoid a redundant copy.
+    if (num_source_bytes >= BufferedStream_ScratchSize(stream))
+    {
+      return IOStream_Write(BufferedStream_Inner(stream), source, num_source_bytes);
+    }
+  }
+
+  std::memcpy(buffered_write->cursor, source, num_source_bytes);
+  buffered_write->cursor += num_source_bytes;
+
+  return binaryIO::IOResult(num_source_bytes, binaryIO::IOErrorCode::Success);
+}
+
+static binaryIO::IOResult BufferedStream_Seek(binaryIO::IOStream* const stream, const binaryIO::IOOffset offset, const binaryIO::SeekOrigin seek_origin)
+{
+  const binaryIO::IOErrorCode write_error = BufferedStream_EndWrite(stream);
+
+  if (write_error != binaryIO::IOErrorCode::Success)
+  {
+    return write_error;
+  }
+
+  binaryIO::IOStream* const   inner       = BufferedStream_Inner(stream);
+  binaryIO::BufferedIO* const buffered_io = &stream->buffered_io;
+
+  binaryIO::IOOffset inner_offset = offset;
+
+  if (buffered_io->Refill == &BufferedStream_Refill)
+  {
+    const binaryIO::IOOffset num_bytes_behind = buffered_io->cursor - buffered_io->buffer_start;
+    const binaryIO::IOOffset num_bytes_ahead  = buffered_io->buffer_end - buffered_io->cursor;
+
+    if (seek_origin == binaryIO::SeekOrigin::CURRENT)
+    {
+      // Seeks that land within the window do not need to move the inner stream.
+      if (offset >= -num_bytes_behind && offset <= num_bytes_ahead)
+      {
+        const binaryIO::IOResult inner_position = IOStream_Seek(inner, 0, binaryIO::SeekOrigin::CURRENT);
+
+        if (inner_position.ErrorCode() == binaryIO::IOErrorCode::Success)
+        {
+          buffered_io->cursor += offset;
+          return binaryIO::IOResult(inner_position.Value() - (num_bytes_ahead - offset), binaryIO::IOErrorCode::Success);
+        }
+
+        return inner_position;
+      }
+
+      inner_offset -= num_bytes_ahead;
+    }
+  }
+
+  // Any successful seek also restarts buffering for a stream that previously failed a refill.
+  const binaryIO::IOResult result = IOStream_Seek(inner, inner_offset, seek_origin);
+
+  if (result.ErrorCode() == binaryIO::IOErrorCode::Success)
+  {
+    BufferedStream_ResetReadWindow(stream);
+  }
+
+  return result;
+}
+
+static binaryIO::IOErrorCode BufferedStream_Close(binaryIO::IOStream* const stream)
+{
+  const binaryIO::IOErrorCode write_error = BufferedStream_EndWrite(stream);
+
+  if (write_error != binaryIO::IOErrorCode::Success)
+  {
+    return write_error;
+  }
+
+  return IOSteam_SupportsSeek(BufferedStream_Inner(stream)) ? BufferedStream_SyncInner(stream) : binaryIO::IOErrorCode::Success;
+}
+
+static binaryIO::IOErrorCode BufferedStream_AdviseWillNeed(binaryIO::IOStream* const stream, const binaryIO::IOSize offset, const binaryIO::IOSize num_bytes)
+{
+  return IOStream_AdviseWillNeed(BufferedStream_Inner(stream), offset, num_bytes);
+}
+
+binaryIO::IOStream binaryIO::IOStream_MakeBuffered(IOStream* const inner, void* const scratch, const IOSize scratch_size)
+{
+  binaryIOAssert(scratch != nullptr && scratch_size != 0u, "A buffered stream requires a non empty scratch buffer.");
+
+  binaryIO::IOStream result            = {};
+  result.Size                          = inner->Size ? &BufferedStream_Size : nullptr;
+  result.Read                          = inner->Read ? &BufferedStream_Read : nullptr;
+  result.Write                         = inner->Write ? &BufferedStream_Write : nullptr;
+  result.Seek                          = inner->Seek ? &BufferedStream_Seek : nullptr;
+  result.Close                         = &BufferedStream_Close;
+  result.AdviseWillNeed                = inner->AdviseWillNeed ? &BufferedStream_AdviseWillNeed : nullptr;
+  result.user_data.values[0].as_handle = inner;
+  result.user_data.values[1].as_handle = scratch;
+  result.user_data.values[2].as_size   = scratch_size;
+
+  BufferedStream_ResetReadWindow(&result);
+
+  result.buffered_write.buffer_start = static_cast<std::uint8_t*>(scratch);
+  result.buffered_write.cursor       = result.buffered_write.buffer_start;
+  result.buffered_write.buffer_end   = result.buffered_write.buffer_start;
+  result.buffered_write.Flush        = inner->Write ? &BufferedStream_Flush : nullptr;
+
+  return result;
+}
+
+// Block Stream
+//
+// The read window spans the used bytes of the current block, the write window is only open
+// while the cursor is at the end of the stream and covers the spare capacity of the last block.
+// Bytes staged through the write window are committed to the block by `BlockStream_Sync`.
+//
+// user_data.values[0] : BlockStreamState*
+//
+
+namespace
+{
+  struct BlockStreamBlock
+  {
+    BlockStreamBlock* next;
+    binaryIO::IOSize  capacity;
+    binaryIO::IOSize  size;
+
+    std::uint8_t* bytes() { return reinterpret_cast<std::uint8_t*>(this + 1); }
+  };
+
+  struct BlockStreamState
+  {
+    binaryIO::IOAllocator allocator;
+    binaryIO::IOSize      block_size;
+    BlockStreamBlock*     head;
+    BlockStreamBlock*     tail;
+    BlockStreamBlock*     current;
+    binaryIO::IOSize      current_base;  //!< Stream offset of the first byte of `current`.
+    binaryIO::IOSize      total_size;
+  };
+}  // namespace
+
+static BlockStreamState* BlockStream_State(const binaryIO::IOStream* const stream)
+{
+  return static_cast<BlockStreamState*>(stream->user_data.values[0].as_handle);
+}
+
+static BlockStreamBlock* BlockStream_AllocBlock(BlockStreamState* const state, const binaryIO::IOSize min_capacity)
+{
+  const binaryIO::IOSize capacity = std::max(state->block_size, min_capacity);
+  void* const            memory   = state->allocator.Alloc(state->allocator.user_data, sizeof(BlockStreamBlock) + capacity, alignof(BlockStreamBlock));
+
+  return memory ? new (memory) BlockStreamBlock{nullptr, capacity, 0u} : nullptr;
+}
+
+static void BlockStream_Advance(BlockStreamState* const state)
+{
+  state->current_base += state->current->size;
+  state->current = state->current->next;
+}
+
+static binaryIO::IOErrorCode BlockStream_Refill(binaryIO::IOStream* const stream);
+
+static void BlockStream_SetWindows(binaryIO::IOStream* const stream, const binaryIO::IOSize offset)
+{
+  BlockStreamState* const state        = BlockStream_State(stream);
+  BlockStreamBlock* const block        = state->current;
+  std::uint8_t* const     bytes        = block->bytes();
+  const bool              is_at_end    = block == state->tail && offset == block->size;
+  const binaryIO::IOSize  writable_end = is_at_end ? block->capacity : offset;
+
+  stream->buffered_io.buffer_start    = bytes;
+  stream->buffered_io.cursor          = bytes + offset;
+  stream->buffered_io.buffer_end      = bytes + block->size;
+  stream->buffered_io.Refill          = &BlockStream_Refill;
+  stream->buffered_write.buffer_start = bytes + offset;
+  stream->buffered_write.cursor       = bytes + offset;
+  stream->buffered_write.buffer_end   = bytes + writable_end;
+}
+
+//
+// Commits bytes staged in the write window and returns the cursor offset within the current block.
+//
+static binaryIO::IOSize BlockStream_Sync(binaryIO::IOStream* const stream)
+{
+  BlockStreamState* const          state            = BlockStream_State(stream);
+  BlockStreamBlock* const          block            = state->current;
+  binaryIO::BufferedWriteIO* const buffered_write   = &stream->buffered_write;
+  const binaryIO::IOSize           num_staged_bytes = buffered_write->cursor - buffered_write->buffer_start;
+
+  if (num_staged_bytes != 0u)
+  {
+    block->size += num_staged_bytes;
+    state->total_size += num_staged_bytes;
+    buffered_write->buffer_start = buffered_write->cursor;
+
+    return block->size;
+  }
+
+  // A failed refill swaps the read window for a zero buffer, that only happens at the end of the stream.
+  if (stream->buffered_io.buffer_start != block->bytes())
+  {
+    return block->size;
+  }
+
+  return stream->buffered_io.cursor - stream->buffered_io.buffer_start;
+}
+
+static binaryIO::IOErrorCode BlockStream_Flush(binaryIO::IOStream* const stream)
+{
+  BlockStream_Sync(stream);
+  return binaryIO::IOErrorCode::Success;
+}
+
+static binaryIO::IOErrorCode BlockStream_Refill(binaryIO::IOStream* const stream)
+{
+  BlockStreamState* const state  = BlockStream_State(stream);
+  binaryIO::IOSize        offset = BlockStream_Sync(stream);
+
+  if (offset == state->current->size && state->current->next)
+  {
+    BlockStream_Advance(state);
+    offset = 0u;
+  }
+
+  BlockStream_SetWindows(stream, offset);
+
+  if (offset != state->current->size)
+  {
+    return binaryIO::IOErrorCode::Success;
+  }
+
+  // The write window stays open so that appending after reaching the end still works.
+  return BufferedIO_Failure(stream, binaryIO::IOErrorCode::EndOfStream);
+}
+
+static binaryIO::IOResult BlockStream_Size(binaryIO::IOStream* const stream)
+{
+  BlockStream_SetWindows(stream, BlockStream_Sync(stream));
+
+  return BlockStream_State(stream)->total_size;
+}
+
+static binaryIO::IOResult BlockStream_Read(binaryIO::IOStream* const stream, void* const destination, const binaryIO::IOSize num_destination_bytes)
+{
+  BlockStreamState* const state    = BlockStream_State(stream);
+  std::uint8_t* const     out      = static_cast<std::uint8_t*>(destination);
+  binaryIO::IOSize        offset   = BlockStream_Sync(stream);
+  binaryIO::IOSize        num_read = 0u;
+
+  while (num_read != num_destination_bytes)
+  {
+    BlockStreamBlock* const block = state->current;
+
+    if (offset == block->size)
+    {
+      if (!block->next)
+      {
+        break;
+      }
+
+      BlockStream_Advance(state);
+      offset = 0u;
+      continue;
+    }
+
+    const binaryIO::IOSize num_bytes_to_copy = std::min(num_destination_bytes - num_read, block->size - offset);
+
+    std::memcpy(out + num_read, block->bytes() + offset, num_bytes_to_copy);
+    num_read += num_bytes_to_copy;
+    offset += num_bytes_to_copy;
+  }
+
+  BlockStream_SetWindows(stream, offset);
+
+  return binaryIO::IOResult(num_read, num_read == num_destination_bytes ? binaryIO::IOErrorCode::Success : binaryIO::IOErrorCode::EndOfStream);
+}
+
+static binaryIO::IOResult BlockStream_Write(binaryIO::IOStream* const stream, const void* const source, const binaryIO::IOSize num_source_bytes)
+{
+  BlockStreamState* const   state       = BlockStream_State(stream);
+  const std::uint8_t* const in          = static_cast<const std::uint8_t*>(source);
+  binaryIO::IOSize          offset      = BlockStream_Sync(stream);
+  binaryIO::IOSize          num_written = 0u;
+
+  while (num_written != num_source_bytes)
+  {
+    BlockStreamBlock* const block = state->current;
+
+    // Only the last block may grow, earlier blocks are overwritten in place.
+    const binaryIO::IOSize writable_end = block == state->tail ? block->capacity : block->size;
+
+    if (offset == writable_end)
+    {
+      if (!block->next)
+      {
+        BlockStreamBlock* const new_block = BlockStream_AllocBlock(state, num_source_bytes - num_written);
+
+        if (!new_block)
+        {
+          BlockStream_SetWindows(stream, offset);
+          return binaryIO::IOResult(num_written, binaryIO::IOErrorCode::AllocationFailure);
+        }
+
+        block->next = new_block;
+        state->tail = new_block;
+      }
+
+      BlockStream_Advance(state);
+      offset = 0u;
+      continue;
+    }
+
+    const binaryIO::IOSize num_bytes_to_copy = std::min(num_source_bytes - num_written, writable_end - offset);
+
+    std::memcpy(block->bytes() + offset, in + num_written, num_bytes_to_copy);
+    num_written += num_bytes_to_copy;
+    offset += num_bytes_to_copy;
+
+    if (offset > block->size)
+    {
+      state->total_size += offset - block->size;
+      block->size = offset;
+    }
+  }
+
+  BlockStream_SetWindows(stream, offset);
+
+  return binaryIO::IOResult(num_written, binaryIO::IOErrorCode::Success);
+}
+
+static binaryIO::IOResult BlockStream_Seek(binaryIO::IOStream* const stream, const binaryIO::IOOffset offset, const binaryIO::SeekOrigin seek_origin)
+{
+  BlockStreamState* const state        = BlockStream_State(stream);
+  const binaryIO::IOSize  block_offset = BlockStream_Sync(stream);
+  const binaryIO::IOSize  position     = state->current_base + block_offset;
+
+  const binaryIO::IOOffset base_offset[] =
+   {
+    0,
+    binaryIO::IOOffset(position),
+    binaryIO::IOOffset(state->total_size),
+   };
+
+  const binaryIO::IOOffset absolute_location = base_offset[int(seek_origin)] + offset;
+
+  if (absolute_location < 0 || binaryIO::IOSize(absolute_location) > state->total_size)
+  {
+    BlockStream_SetWindows(stream, block_offset);
+    return binaryIO::IOResult(position, binaryIO::IOErrorCode::SeekError);
+  }
+
+  const binaryIO::IOSize target = binaryIO::IOSize(absolute_location);
+
+  // Seeking backwards restarts the walk from the first block.
+  if (target < state->current_base)
+  {
+    state->current      = state->head;
+    state->current_base = 0u;
+  }
+
+  while (state->current->next && target >= state->current_base + state->current->size)
+  {
+    BlockStream_Advance(state);
+  }
+
+  BlockStream_SetWindows(stream, target - state->current_base);
+
+  return binaryIO::IOResult(target, binaryIO::IOErrorCode::Success);
+}
+
+static binaryIO::IOErrorCode BlockStream_Close(binaryIO::IOStream* const stream)
+{
+  BlockStreamState* const state = BlockStream_State(stream);
+
+  // Closing twice must not free the blocks again.
+  if (!state)
+  {
+    return binaryIO::IOErrorCode::Success;
+  }
+
+  const binaryIO::IOAllocator allocator = state->allocator;
+
+  if (allocator.Free)
+  {
+    BlockStreamBlock* block = state->head;
+
+    while (block)
+    {
+      BlockStreamBlock* const next = block->next;
+
+      allocator.Free(allocator.user_data, block, sizeof(BlockStreamBlock) + block->capacity);
+      block = next;
+    }
+
+    allocator.Free(allocator.user_data, state, sizeof(BlockStreamState));
+  }
+
+  stream->user_data.values[0].as_handle = nullptr;
+  stream->buffered_io                   = {};
+  stream->buffered_write                = {};
+
+  return binaryIO::IOErrorCode::Success;
+}
+
+binaryIO::IOAllocator binaryIO::IOAllocator_Default()
+{
+  binaryIO::IOAllocator result;
+  result.Alloc = [](void* const user_data, const IOSize num_bytes, const IOSize alignment) -> void* {
+    (void)user_data;
+    binaryIOAssert(alignment <= alignof(std::max_align_t), "The default allocator only supports fundamental alignments.");
+    return std::malloc(num_bytes);
+  };
+  result.Free = [](void* const user_data, void* const ptr, const IOSize num_bytes) {
+    (void)user_data;
+    (void)num_bytes;
+    std::free(ptr);
+  };
+  result.user_data = nullptr;
+
+  return result;
+}
+
+binaryIO::IOStream binaryIO::IOStream_FromBlockAllocator(const IOAllocator& allocator, const IOSize block_size)
+{
+  binaryIOAssert(allocator.Alloc != nullptr && block_size != 0u, "A block stream requires an allocator and a non zero block size.");
+
+  binaryIO::IOStream result       = {};
+  void* const        state_memory = allocator.Alloc(allocator.user_data, sizeof(BlockStreamState), alignof(BlockStreamState));
+
+  if (!state_memory)
+  {
+    result.error_state = binaryIO::IOErrorCode::AllocationFailure;
+    return result;
+  }
+
+  BlockStreamState* const state = new (state_memory) BlockStreamState{allocator, block_size, nullptr, nullptr, nullptr, 0u, 0u};
+  BlockStreamBlock* const head  = BlockStream_AllocBlock(state, 0u);
+
+  if (!head)
+  {
+    if (allocator.Free)
+    {
+      allocator.Free(allocator.user_data, state_memory, sizeof(BlockStreamState));
+    }
+
+    result.error_state = binaryIO::IOErrorCode::AllocationFailure;
+    return result;
+  }
+
+  state->head    = head;
+  state->tail    = head;
+  state->current = head;
+
+  result.Size                          = &BlockStream_Size;
+  result.Read                          = &BlockStream_Read;
+  result.Write                         = &BlockStream_Write;
+  result.Seek                          = &BlockStream_Seek;
+  result.Close                         = &BlockStream_Close;
+  result.user_data.values[0].as_handle = state;
+  result.buffered_write.Flush          = &BlockStream_Flush;
+
+  BlockStream_SetWindows(&result, 0u);
+
+  return result;
+}
+
+binaryIO::IOResult binaryIO::BlockStream_Linearize(IOStream* const stream, void* const destination, const IOSize num_destination_bytes)
+{
+  if (stream->Close != &BlockStream_Close || !BlockStream_State(stream))
+  {
+    return binaryIO::IOErrorCode::InvalidOperation;
+  }
+
+  BlockStream_SetWindows(stream, BlockStream_Sync(stream));
+
+  const BlockStreamState* const state      = BlockStream_State(stream);
+  std::uint8_t* const           out        = static_cast<std::uint8_t*>(destination);
+  binaryIO::IOSize              num_copied = 0u;
+
+  for (BlockStreamBlock* block = state->head; block && num_copied != num_destination_bytes; block = block->next)
+  {
+    const binaryIO::IOSize num_bytes_to_copy = std::min(num_destination_bytes - num_copied, block->size);
+
+    std::memcpy(out + num_copied, block->bytes(), num_bytes_to_copy);
+    num_copied += num_bytes_to_copy;
+  }
+
+  return binaryIO::IOResult(num_copied, num_copied == state->total_size ? binaryIO::IOErrorCode::Success : binaryIO::IOErrorCode::EndOfStream);
+}
+
+// binary_span_stream.hpp
+//
+// The windows cover the rest of the span so the span's cursor is only written back
+// by the slow paths and by closing / flushing the stream.
+//
+// user_data.values[0] : SpanWriter* / SpanReader*
+//
+
+static binaryIO::SpanWriter* SpanWriterStream_Sync(binaryIO::IOStream* const stream)
+{
+  binaryIO::SpanWriter* const writer = static_cast<binaryIO::SpanWriter*>(stream->user_data.values[0].as_handle);
+
+  writer->cursor                      = stream->buffered_write.cursor;
+  stream->buffered_write.buffer_start = writer->cursor;
+
+  return writer;
+}
+
+static binaryIO::IOResult SpanWriterStream_Size(binaryIO::IOStream* const stream)
+{
+  return SpanWriterStream_Sync(stream)->size();
+}
+
+static binaryIO::IOResult SpanWriterStream_Write(binaryIO::IOStream* const stream, const void* const source, const binaryIO::IOSize num_source_bytes)
+{
+  binaryIO::SpanWriter* const writer = SpanWriterStream_Sync(stream);
+  const binaryIO::IOResult    result = writer->write(source, num_source_bytes);
+
+  stream->buffered_write.buffer_start = writer->cursor;
+  stream->buffered_write.cursor       = writer->cursor;
+
+  return result;
+}
+
+static binaryIO::IOErrorCode SpanWriterStream_Flush(binaryIO::IOStream* const stream)
+{
+  SpanWriterStream_Sync(stream);
+
+  return stream->error_state;
+}
+
+static binaryIO::IOErrorCode SpanWriterStream_Close(binaryIO::IOStream* const stream)
+{
+  binaryIO::SpanWriter* const writer = SpanWriterStream_Sync(stream);
+
+  if (stream->error_state != binaryIO::IOErrorCode::Success)
+  {
+    writer->fail(stream->error_state);
+  }
+
+  return writer->error_state;
+}
+
+binaryIO::IOStream binaryIO::IOStream_FromSpanWriter(SpanWriter* const writer)
+{
+  binaryIO::IOStream result            = {};
+  result.Size                          = &SpanWriterStream_Size;
+  result.Write                         = &SpanWriterStream_Write;
+  result.Close                         = &SpanWriterStream_Close;
+  result.user_data.values[0].as_handle = writer;
+  result.buffered_write.buffer_start   = writer->cursor;
+  result.buffered_write.cursor         = writer->cursor;
+  result.buffered_write.buffer_end     = writer->buffer_end;
+  result.buffered_write.Flush          = &SpanWriterStream_Flush;
+  result.error_state                   = writer->error_state;
+
+  return result;
+}
+
+static binaryIO::SpanReader* SpanReaderStream_Sync(binaryIO::IOStream* const stream)
+{
+  binaryIO::SpanReader* const reader = static_cast<binaryIO::SpanReader*>(stream->user_data.values[0].as_handle);
+
+  // After a failed refill the window no longer refers to the span.
+  if (stream->buffered_io.buffer_start == reader->buffer_start)
+  {
+    reader->cursor = stream->buffered_io.cursor;
+  }
+
+  return reader;
+}
+
+static binaryIO::IOResult SpanReaderStream_Size(binaryIO::IOStream* const stream)
+{
+  return SpanReaderStream_Sync(stream)->size();
+}
+
+static binaryIO::IOResult SpanReaderStream_Read(binaryIO::IOStream* const stream, void* const destination, const binaryIO::IOSize num_destination_bytes)
+{
+  binaryIO::SpanReader* const reader = SpanReaderStream_Sync(stream);
+  const binaryIO::IOResult    result = reader->read(destination, num_destination_bytes);
+
+  if (stream->buffered_io.buffer_start == reader->buffer_start)
+  {
+    stream->buffered_io.cursor = reader->cursor;
+  }
+
+  return result;
+}
+
+static binaryIO::IOErrorCode SpanReaderStream_Refill(binaryIO::IOStream* const stream)
+{
+  // The whole span was the window, hand the end position back before the window is swapped out.
+  SpanReaderStream_Sync(stream);
+
+  return BufferedIO_Failure(stream, binaryIO::IOErrorCode::EndOfStream);
+}
+
+static binaryIO::IOErrorCode SpanReaderStream_Close(binaryIO::IOStream* const stream)
+{
+  binaryIO::SpanReader* const reader = SpanReaderStream_Sync(stream);
+
+  // Includes the `IOErrorCode::EndOfStream` of a failed refill.
+  if (stream->error_state != binaryIO::IOErrorCode::Success)
+  {
+    reader->fail(stream->error_state);
+  }
+
+  return reader->error_state;
+}
+
+binaryIO::IOStream binaryIO::IOStream_FromSpanReader(SpanReader* const reader)
+{
+  binaryIO::IOStream result            = {};
+  result.Size                          = &SpanReaderStream_Size;
+  result.Read                          = &SpanReaderStream_Read;
+  result.Close                         = &SpanReaderStream_Close;
+  result.user_data.values[0].as_handle = reader;
+  result.buffered_io                   = SetupMemoryBufferedIO(reader->buffer_start, reader->size());
+  result.buffered_io.cursor            = reader->cursor;
+  result.buffered_io.Refill            = &SpanReaderStream_Refill;
+  result.error_state                   = reader->error_state;
+
+  return result;
+}
+
+// binary_api_ext.hpp
+
+static binaryIO::IOResult CFile_Size(binaryIO::IOStream* const stream)
+{
+  std::FILE* const file_handle = static_cast<std::FILE*>(stream->user_data.values[0].as_handle);
+
+  // Writes still in the stdio buffer end at the current position since stdio flushes before every seek,
+  // so the logical size is the larger of the two and nothing has to be flushed.
+#if _WIN32
+  const HANDLE       os_handle     = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(file_handle)));
+  const std::int64_t file_position = _ftelli64(file_handle);
+  LARGE_INTEGER      file_size;
+
+  if (GetFileType(os_handle) != FILE_TYPE_DISK || !GetFileSizeEx(os_handle, &file_size))
+  {
+    return binaryIO::IOErrorCode::InvalidOperation;
+  }
+
+  return std::max<binaryIO::IOSize>(binaryIO::IOSize(file_size.QuadPart), file_position > 0 ? binaryIO::IOSize(file_position) : 0u);
+#else
+  const off_t file_position = ftello(file_handle);
+  struct stat file_info;
+
+  // Pipes and terminals have no size.
+  if (fstat(fileno(file_handle), &file_info) != 0 || !S_ISREG(file_info.st_mode))
+  {
+    return binaryIO::IOErrorCode::InvalidOperation;
+  }
+
+  return std::max<binaryIO::IOSize>(binaryIO::IOSize(file_info.st_size), file_position > 0 ? binaryIO::IOSize(file_position) : 0u);
+#endif
+}
+
+static binaryIO::IOResult CFile_Read(binaryIO::IOStream* const stream, void* const destination, const binaryIO::IOSize num_destination_bytes)
+{
+  std::FILE* const file_handle = static_cast<std::FILE*>(stream->user_data.values[0].as_handle);
+
+  if (std::feof(file_handle))
+  {
+    return binaryIO::IOErrorCode::EndOfStream;
+  }
+
+  const std::size_t num_bytes_read = std::fread(destination, sizeof(unsigned char), num_destination_bytes, file_handle);
+
+  binaryIO::IOErrorCode error_code = binaryIO::IOErrorCode::Success;
+
+  if (num_bytes_read != num_destination_bytes)
+  {
+    error_code = std::feof(file_handle) ? binaryIO::IOErrorCode::EndOfStream : binaryIO::IOErrorCode::ReadError;
+  }
+
+  return binaryIO::IOResult(num_bytes_read, error_code);
+}
+
+static binaryIO::IOResult CFile_Write(binaryIO::IOStream* const stream, const void* const source, const binaryIO::IOSize num_source_bytes)
+{
+  std::FILE* const            file_handle       = static_cast<std::FILE*>(stream->user_data.values[0].as_handle);
+  const std::size_t           num_bytes_written = std::fwrite(source, sizeof(unsigned char), num_source_bytes, file_handle);
+  const binaryIO::IOErrorCode error_code        = (num_bytes_written == num_source_bytes) ? binaryIO::IOErrorCode::Success : binaryIO::IOErrorCode::UnknownError;
+
+  return binaryIO::IOResult(num_bytes_written, error_code);
+}
+
+static binaryIO::IOResult CFile_Seek(binaryIO::IOStream* const stream, const binaryIO::IOOffset offset, const binaryIO::SeekOrigin seek_origin)
+{
+  std::FILE* const file_handle = static_cast<std::FILE*>(stream->user_data.values[0].as_handle);
+
+  const int file_origin = [](const binaryIO::SeekOrigin seek_origin) -> int {
+    switch (seek_origin)
+    {
+      case binaryIO::SeekOrigin::BEGIN: return SEEK_SET;
+      case binaryIO::SeekOrigin::CURRENT: return SEEK_CUR;
+      case binaryIO::SeekOrigin::END: return SEEK_END;
       default:
       {
-        binaryIOAssert(false, "Invalid seek origin.\n");
-        break;
+        binaryIOAssert(false, "Invalid seek origin.\n");
+        break;
+      }
+    }
+
+    return -1;
+  }(seek_origin);
+
+  const bool is_null_seek = offset == 0 && file_origin == SEEK_CUR;
+
+#if _WIN32
+  if (is_null_seek || _fseeki64(file_handle, offset, file_origin) == 0)
+#else
+  if (is_null_seek || fseeko(file_handle, offset, file_origin) == 0)
+#endif
+  {
+#if _WIN32
+    const binaryIO::IOOffset file_position = _ftelli64(file_handle);
+#else
+    const binaryIO::IOOffset file_position = ftello(file_handle);
+#endif
+
+    if (file_position != -1L)
+    {
+      return binaryIO::IOResult(file_position, binaryIO::IOErrorCode::Success);
+    }
+  }
+
+  return binaryIO::IOErrorCode::SeekError;
+}
+
+#if !_WIN32
+//
+// Vectored IO bypasses the `FILE` buffer, the buffer is flushed beforehand
+// and the new descriptor position is handed back to stdio afterwards.
+//
+
+static constexpr int k_CFileMaxSegmentsPerCall = 16;  // _XOPEN_IOV_MAX, the smallest IOV_MAX allowed by POSIX.
+
+template<typename Segment, typename TransferFn>
+static binaryIO::IOResult CFile_TransferV(binaryIO::IOStream* const stream, const Segment* const segments, const binaryIO::IOSize num_segments, const binaryIO::IOErrorCode transfer_error, TransferFn&& transfer)
+{
+  std::FILE* const file_handle = static_cast<std::FILE*>(stream->user_data.values[0].as_handle);
+
+  if (std::fflush(file_handle) != 0)
+  {
+    return transfer_error;
+  }
+
+  const int             file_descriptor = fileno(file_handle);
+  binaryIO::IOSize      segment_index   = 0u;
+  binaryIO::IOSize      segment_offset  = 0u;
+  binaryIO::IOSize      num_transferred = 0u;
+  binaryIO::IOErrorCode error_code      = binaryIO::IOErrorCode::Success;
+
+  while (segment_index != num_segments)
+  {
+    iovec io_vectors[k_CFileMaxSegmentsPerCall];
+    int   num_io_vectors = 0;
+
+    for (binaryIO::IOSize i = segment_index; i != num_segments && num_io_vectors != k_CFileMaxSegmentsPerCall; ++i)
+    {
+      const binaryIO::IOSize skip = i == segment_index ? segment_offset : 0u;
+
+      if (segments[i].num_bytes != skip)
+      {
+        io_vectors[num_io_vectors].iov_base = const_cast<std::uint8_t*>(static_cast<const std::uint8_t*>(segments[i].bytes)) + skip;
+        io_vectors[num_io_vectors].iov_len  = segments[i].num_bytes - skip;
+        ++num_io_vectors;
+      }
+    }
+
+    if (num_io_vectors == 0)
+    {
+      break;
+    }
+
+    const ssize_t result = transfer(file_descriptor, io_vectors, num_io_vectors);
+
+    if (result < 0 && errno == EINTR)
+    {
+      continue;
+    }
+
+    if (result <= 0)
+    {
+      error_code = result == 0 ? binaryIO::IOErrorCode::EndOfStream : transfer_error;
+      break;
+    }
+
+    num_transferred += binaryIO::IOSize(result);
+
+    // Advance past the transferred bytes, a partial transfer can stop in the middle of a segment.
+    binaryIO::IOSize num_to_skip = binaryIO::IOSize(result);
+
+    while (segment_index != num_segments && num_to_skip >= segments[segment_index].num_bytes - segment_offset)
+    {
+      num_to_skip -= segments[segment_index].num_bytes - segment_offset;
+      segment_offset = 0u;
+      ++segment_index;
+    }
+
+    segment_offset += num_to_skip;
+  }
+
+  const off_t file_position = lseek(file_descriptor, 0, SEEK_CUR);
+
+  if (file_position != -1)
+  {
+    fseeko(file_handle, file_position, SEEK_SET);
+  }
+
+  return binaryIO::IOResult(num_transferred, error_code);
+}
+
+static binaryIO::IOResult CFile_ReadV(binaryIO::IOStream* const stream, const binaryIO::IOSegment* const segments, const binaryIO::IOSize num_segments)
+{
+  return CFile_TransferV(stream, segments, num_segments, binaryIO::IOErrorCode::ReadError, [](const int fd, const iovec* const io_vectors, const int num_io_vectors) {
+    return readv(fd, io_vectors, num_io_vectors);
+  });
+}
+
+static binaryIO::IOResult CFile_WriteV(binaryIO::IOStream* const stream, const binaryIO::IOConstSegment* const segments, const binaryIO::IOSize num_segments)
+{
+  return CFile_TransferV(stream, segments, num_segments, binaryIO::IOErrorCode::UnknownError, [](const int fd, const iovec* const io_vectors, const int num_io_vectors) {
+    return writev(fd, io_vectors, num_io_vectors);
+  });
+}
+#endif
+
+//
+// Positional IO goes straight to the OS handle, bytes still in the `FILE` write buffer are not visible until flushed.
+// On Windows a `ReadFile` / `WriteFile` with an offset also moves the handle's file pointer,
+// so a sequential read or write after positional IO must be preceded by an absolute `IOStream_Seek`.
+//
+
+template<typename Byte, typename TransferFn>
+static binaryIO::IOResult CFile_TransferAt(binaryIO::IOStream* const stream, const binaryIO::IOSize offset, Byte* const bytes, const binaryIO::IOSize num_bytes, const binaryIO::IOErrorCode transfer_error, TransferFn&& transfer)
+{
+  std::FILE* const file_handle     = static_cast<std::FILE*>(stream->user_data.values[0].as_handle);
+  binaryIO::IOSize num_transferred = 0u;
+
+#if _WIN32
+  const HANDLE os_handle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(file_handle)));
+#else
+  const int os_handle = fileno(file_handle);
+#endif
+
+  while (num_transferred != num_bytes)
+  {
+    const binaryIO::IOSize position  = offset + num_transferred;
+    const binaryIO::IOSize num_chunk = std::min<binaryIO::IOSize>(num_bytes - num_transferred, 0x40000000u);
+
+#if _WIN32
+    OVERLAPPED overlapped = {};
+    overlapped.Offset     = DWORD(position);
+    overlapped.OffsetHigh = DWORD(position >> 32);
+
+    DWORD result = 0;
+
+    if (!transfer(os_handle, bytes + num_transferred, DWORD(num_chunk), &result, &overlapped))
+    {
+      return binaryIO::IOResult(num_transferred, GetLastError() == ERROR_HANDLE_EOF ? binaryIO::IOErrorCode::EndOfStream : transfer_error);
+    }
+#else
+    const ssize_t result = transfer(os_handle, bytes + num_transferred, std::size_t(num_chunk), off_t(position));
+
+    if (result < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+
+      return binaryIO::IOResult(num_transferred, transfer_error);
+    }
+#endif
+
+    if (result == 0)
+    {
+      return binaryIO::IOResult(num_transferred, binaryIO::IOErrorCode::EndOfStream);
+    }
+
+    num_transferred += binaryIO::IOSize(result);
+  }
+
+  return binaryIO::IOResult(num_transferred, binaryIO::IOErrorCode::Success);
+}
+
+static binaryIO::IOResult CFile_ReadAt(binaryIO::IOStream* const stream, const binaryIO::IOSize offset, void* const destination, const binaryIO::IOSize num_destination_bytes)
+{
+#if _WIN32
+  return CFile_TransferAt(stream, offset, static_cast<std::uint8_t*>(destination), num_destination_bytes, binaryIO::IOErrorCode::ReadError, &ReadFile);
+#else
+  return CFile_TransferAt(stream, offset, static_cast<std::uint8_t*>(destination), num_destination_bytes, binaryIO::IOErrorCode::ReadError, &pread);
+#endif
+}
+
+static binaryIO::IOResult CFile_WriteAt(binaryIO::IOStream* const stream, const binaryIO::IOSize offset, const void* const source, const binaryIO::IOSize num_source_bytes)
+{
+#if _WIN32
+  return CFile_TransferAt(stream, offset, static_cast<const std::uint8_t*>(source), num_source_bytes, binaryIO::IOErrorCode::UnknownError, &WriteFile);
+#else
+  return CFile_TransferAt(stream, offset, static_cast<const std::uint8_t*>(source), num_source_bytes, binaryIO::IOErrorCode::UnknownError, &pwrite);
+#endif
+}
+
+static binaryIO::IOErrorCode CFile_AdviseWillNeed(binaryIO::IOStream* const stream, const binaryIO::IOSize offset, const binaryIO::IOSize num_bytes)
+{
+#if _WIN32
+  (void)stream;
+  (void)offset;
+  (void)num_bytes;
+
+  return binaryIO::IOErrorCode::InvalidOperation;
+#else
+  // A length of zero means "to the end of the file" to the OS, here it is an empty range.
+  if (num_bytes == 0u)
+  {
+    return binaryIO::IOErrorCode::Success;
+  }
+
+  constexpr binaryIO::IOSize k_MaxOffset = binaryIO::IOSize(std::numeric_limits<off_t>::max());
+
+  if (offset > k_MaxOffset)
+  {
+    return binaryIO::IOErrorCode::InvalidOperation;
+  }
+
+  const int              file_descriptor = fileno(static_cast<std::FILE*>(stream->user_data.values[0].as_handle));
+  const binaryIO::IOSize range_len       = std::min(num_bytes, k_MaxOffset - offset);
+
+#if defined(__APPLE__)
+  struct radvisory advisory = {};
+  advisory.ra_offset        = off_t(offset);
+  advisory.ra_count         = int(std::min<binaryIO::IOSize>(range_len, binaryIO::IOSize(INT_MAX)));
+
+  return fcntl(file_descriptor, F_RDADVISE, &advisory) != -1 ? binaryIO::IOErrorCode::Success : binaryIO::IOErrorCode::UnknownError;
+#else
+  return posix_fadvise(file_descriptor, off_t(offset), off_t(range_len), POSIX_FADV_WILLNEED) == 0 ? binaryIO::IOErrorCode::Success : binaryIO::IOErrorCode::UnknownError;
+#endif
+#endif
+}
+
+static binaryIO::IOErrorCode CFile_Close(binaryIO::IOStream* const stream)
+{
+  std::FILE* const file_handle = static_cast<std::FILE*>(stream->user_data.values[0].as_handle);
+
+  const int err = std::fclose(file_handle);
+
+  return err == 0 ? binaryIO::IOErrorCode::Success : binaryIO::IOErrorCode::UnknownError;
+}
+
+binaryIO::IOStream binaryIO::IOStream_FromCFile(std::FILE* const file_handle)
+{
+  binaryIO::IOStream result            = {};
+  result.Size                          = &CFile_Size;
+  result.Read                          = &CFile_Read;
+  result.Write                         = &CFile_Write;
+  result.Seek                          = &CFile_Seek;
+  result.Close                         = &CFile_Close;
+  result.ReadAt                        = &CFile_ReadAt;
+  result.WriteAt                       = &CFile_WriteAt;
+  result.AdviseWillNeed                = &CFile_AdviseWillNeed;
+#if !_WIN32
+  result.ReadV                         = &CFile_ReadV;
+  result.WriteV                        = &CFile_WriteV;
+#endif
+  result.user_data.values[0].as_handle = file_handle;
+
+  return result;
+}
+
+static binaryIO::IOErrorCode MappedFile_Close(binaryIO::IOStream* const stream)
+{
+  const binaryIO::MemoryStreamData& memory_stream = stream->user_data.memory_stream;
+
+  if (memory_stream.buffer_start == nullptr)
+  {
+    return binaryIO::IOErrorCode::Success;
+  }
+
+#if _WIN32
+  const bool success = UnmapViewOfFile(memory_stream.buffer_start) != FALSE;
+#else
+  const bool success = munmap(memory_stream.buffer_start, memory_stream.buffer_size) == 0;
+#endif
+
+  stream->user_data.memory_stream     = binaryIO::MemoryStreamData{nullptr, 0u, 0u};
+  stream->buffered_io                 = SetupMemoryBufferedIO(nullptr, 0u);
+  stream->buffered_write.buffer_start = nullptr;
+  stream->buffered_write.cursor       = nullptr;
+  stream->buffered_write.buffer_end   = nullptr;
+
+  return success ? binaryIO::IOErrorCode::Success : binaryIO::IOErrorCode::UnknownError;
+}
+
+static binaryIO::IOErrorCode MappedFile_AdviseWillNeed(binaryIO::IOStream* const stream, const binaryIO::IOSize offset, const binaryIO::IOSize num_bytes)
+{
+  const binaryIO::MemoryStreamData& memory_stream = stream->user_data.memory_stream;
+
+  if (offset >= memory_stream.buffer_size || num_bytes == 0u)
+  {
+    return binaryIO::IOErrorCode::Success;
+  }
+
+  std::uint8_t* const    range_bgn = static_cast<std::uint8_t*>(memory_stream.buffer_start) + offset;
+  const binaryIO::IOSize range_len = std::min(num_bytes, memory_stream.buffer_size - offset);
+
+#if _WIN32
+#if _WIN32_WINNT >= 0x0602 /* _WIN32_WINNT_WIN8 */
+  WIN32_MEMORY_RANGE_ENTRY range = {};
+  range.VirtualAddress           = range_bgn;
+  range.NumberOfBytes            = SIZE_T(range_len);
+
+  return PrefetchVirtualMemory(GetCurrentProcess(), 1u, &range, 0u) ? binaryIO::IOErrorCode::Success : binaryIO::IOErrorCode::UnknownError;
+#else
+  return binaryIO::IOErrorCode::InvalidOperation;
+#endif
+#else
+  // madvise requires a page aligned start, the mapping itself starts on a page boundary.
+  const std::uintptr_t page_size  = std::uintptr_t(sysconf(_SC_PAGESIZE));
+  const std::uintptr_t page_start = reinterpret_cast<std::uintptr_t>(range_bgn) & ~(page_size - 1u);
+  const std::uintptr_t range_end  = reinterpret_cast<std::uintptr_t>(range_bgn) + range_len;
+
+  return madvise(reinterpret_cast<void*>(page_start), std::size_t(range_end - page_start), MADV_WILLNEED) == 0 ? binaryIO::IOErrorCode::Success : binaryIO::IOErrorCode::UnknownError;
+#endif
+}
+
+//
+// The OS handles are released as soon as the view is mapped,
+// the view itself keeps the file alive so only the memory range needs to be stored.
+//
+static void* MappedFile_Map(const char* const path, const binaryIO::MappedFileAccess access, binaryIO::IOSize* const out_size, binaryIO::IOErrorCode* const out_error)
+{
+  const bool is_writable = access == binaryIO::MappedFileAccess::ReadWrite;
+
+  *out_size  = 0u;
+  *out_error = binaryIO::IOErrorCode::ReadError;
+
+#if _WIN32
+  const HANDLE file_handle = CreateFileA(path, is_writable ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+  if (file_handle == INVALID_HANDLE_VALUE)
+  {
+    return nullptr;
+  }
+
+  void*         mapping   = nullptr;
+  LARGE_INTEGER file_size = {};
+
+  if (GetFileSizeEx(file_handle, &file_size))
+  {
+    *out_error = binaryIO::IOErrorCode::Success;
+
+    if (file_size.QuadPart != 0)
+    {
+      const HANDLE mapping_handle = CreateFileMappingA(file_handle, nullptr, is_writable ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+
+      if (mapping_handle)
+      {
+        mapping = MapViewOfFile(mapping_handle, is_writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping_handle);
+      }
+
+      if (mapping)
+      {
+        *out_size = binaryIO::IOSize(file_size.QuadPart);
+      }
+      else
+      {
+        *out_error = binaryIO::IOErrorCode::AllocationFailure;
+      }
+    }
+  }
+
+  CloseHandle(file_handle);
+#else
+  const int file_descriptor = open(path, is_writable ? O_RDWR : O_RDONLY);
+
+  if (file_descriptor == -1)
+  {
+    return nullptr;
+  }
+
+  void*       mapping   = nullptr;
+  struct stat file_info = {};
+
+  if (fstat(file_descriptor, &file_info) == 0)
+  {
+    *out_error = binaryIO::IOErrorCode::Success;
+
+    if (file_info.st_size != 0)
+    {
+      mapping = mmap(nullptr, std::size_t(file_info.st_size), is_writable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, file_descriptor, 0);
+
+      if (mapping != MAP_FAILED)
+      {
+        *out_size = binaryIO::IOSize(file_info.st_size);
+      }
+      else
+      {
+        mapping    = nullptr;
+        *out_error = binaryIO::IOErrorCode::AllocationFailure;
+      }
+    }
+  }
+
+  close(file_descriptor);
+#endif
+
+  return mapping;
+}
+
+binaryIO::IOStream binaryIO::IOStream_FromMappedFile(const char* const path, const MappedFileAccess access)
+{
+  binaryIO::IOSize      num_bytes;
+  binaryIO::IOErrorCode error_code;
+  void* const           bytes = MappedFile_Map(path, access, &num_bytes, &error_code);
+
+  if (error_code != binaryIO::IOErrorCode::Success)
+  {
+    binaryIO::IOStream result = {};
+    result.error_state        = error_code;
+
+    return result;
+  }
+
+  binaryIO::IOStream result = access == MappedFileAccess::ReadWrite ? IOStream_FromRWMemory(bytes, num_bytes) : IOStream_FromROMemory(bytes, num_bytes);
+  result.Close              = &MappedFile_Close;
+  result.AdviseWillNeed     = &MappedFile_AdviseWillNeed;
+
+  return result;
+}
+
+binaryIO::IOErrorCode binaryIO::IOStream_AdviseWillNeed(IOStream* const stream, const IOSize offset, const IOSize num_bytes)
+{
+  return stream->AdviseWillNeed ? stream->AdviseWillNeed(stream, offset, num_bytes) : IOErrorCode::InvalidOperation;
+}
+
+// binary_chunk.hpp
+
+namespace
+{
+  struct Crc32SlicingTables
+  {
+    std::uint32_t table[8][256];
+  };
+
+  constexpr Crc32SlicingTables MakeCrc32SlicingTables()
+  {
+    Crc32SlicingTables result = {};
+
+    for (std::size_t i = 0; i < 256; ++i)
+    {
+      result.table[0][i] = k_Crc32Table[i];
+    }
+
+    for (std::size_t slice = 1; slice < 8; ++slice)
+    {
+      for (std::size_t i = 0; i < 256; ++i)
+      {
+        const std::uint32_t previous = result.table[slice - 1][i];
+
+        result.table[slice][i] = (previous >> 8) ^ k_Crc32Table[previous & 0xFF];
       }
     }
 
-    return -1;
-  }(seek_origin);
+    return result;
+  }
 
-  const bool is_null_seek = offset == 0 && file_origin == SEEK_CUR;
+  constexpr Crc32SlicingTables k_Crc32Slicing = MakeCrc32SlicingTables();
+}  // namespace
 
-#if _WIN32
-  if (is_null_seek || _fseeki64(file_handle, offset, file_origin) == 0)
+static std::uint32_t Crc32_LoadLE32(const std::uint8_t* const bytes)
+{
+  return std::uint32_t(bytes[0]) | (std::uint32_t(bytes[1]) << 8) | (std::uint32_t(bytes[2]) << 16) | (std::uint32_t(bytes[3]) << 24);
+}
+
+static std::uint32_t Crc32_Slicing8(std::uint32_t crc, const std::uint8_t* bytes, std::size_t num_bytes)
+{
+  const auto& t = k_Crc32Slicing.table;
+
+  for (; num_bytes >= 8u; num_bytes -= 8u, bytes += 8u)
+  {
+    const std::uint32_t lo = Crc32_LoadLE32(bytes) ^ crc;
+    const std::uint32_t hi = Crc32_LoadLE32(bytes + 4);
+
+    crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24] ^
+          t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF] ^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+  }
+
+  for (; num_bytes != 0u; --num_bytes, ++bytes)
+  {
+    crc = (crc >> 8) ^ t[0][(*bytes ^ crc) & 0xFF];
+  }
+
+  return crc;
+}
+
+#if BINARY_IO_CRC32_PCLMUL
+//
+// Folding with carry-less multiplication as described in
+// "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction" (Intel, 2009).
+// Requires num_bytes >= 64 and a multiple of 16.
+//
+BINARY_IO_TARGET_PCLMUL static std::uint32_t Crc32_FoldPCLMUL(const std::uint32_t crc, const std::uint8_t* bytes, std::size_t num_bytes)
+{
+  alignas(16) static constexpr std::uint64_t k_K1K2[] = {0x0154442bd4, 0x01c6e41596};
+  alignas(16) static constexpr std::uint64_t k_K3K4[] = {0x01751997d0, 0x00ccaa009e};
+  alignas(16) static constexpr std::uint64_t k_K5K0[] = {0x0163cd6124, 0x0000000000};
+  alignas(16) static constexpr std::uint64_t k_Poly[] = {0x01db710641, 0x01f7011641};
+
+  __m128i x0, x1, x2, x3, x4, x5;
+
+  x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + 0x00));
+  x2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + 0x10));
+  x3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + 0x20));
+  x4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + 0x30));
+  x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(int(crc)));
+  x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(k_K1K2));
+
+  bytes += 64;
+  num_bytes -= 64;
+
+  // Fold 4 lanes of 128 bits in parallel.
+  for (; num_bytes >= 64u; num_bytes -= 64u, bytes += 64u)
+  {
+    const __m128i y5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    const __m128i y6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+    const __m128i y7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+    const __m128i y8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+    x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+    x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, y5), _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + 0x00)));
+    x2 = _mm_xor_si128(_mm_xor_si128(x2, y6), _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + 0x10)));
+    x3 = _mm_xor_si128(_mm_xor_si128(x3, y7), _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + 0x20)));
+    x4 = _mm_xor_si128(_mm_xor_si128(x4, y8), _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + 0x30)));
+  }
+
+  // Fold the 4 lanes into a single 128 bit lane.
+  x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(k_K3K4));
+
+  x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+
+  x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+
+  x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+  // Single lane folds for the remaining 16 byte blocks.
+  for (; num_bytes >= 16u; num_bytes -= 16u, bytes += 16u)
+  {
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes))), x5);
+  }
+
+  // Fold 128 bits down to 64 bits.
+  x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+  x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+  x1 = _mm_srli_si128(x1, 8);
+  x1 = _mm_xor_si128(x1, x2);
+
+  x0 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(k_K5K0));
+
+  x2 = _mm_srli_si128(x1, 4);
+  x1 = _mm_and_si128(x1, x3);
+  x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+
+  // Barrett reduction down to 32 bits.
+  x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(k_Poly));
+
+  x2 = _mm_and_si128(x1, x3);
+  x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+  x2 = _mm_and_si128(x2, x3);
+  x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+
+  return std::uint32_t(_mm_extract_epi32(x1, 1));
+}
+
+static bool Crc32_CPUSupportsPCLMUL()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+  int cpu_info[4];
+  __cpuid(cpu_info, 1);
+
+  const bool has_pclmul = (cpu_info[2] & (1 << 1)) != 0;
+  const bool has_sse41  = (cpu_info[2] & (1 << 19)) != 0;
+
+  return has_pclmul && has_sse41;
 #else
-  if (is_null_seek || fseeko(file_handle, offset, file_origin) == 0)
+  return __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1");
 #endif
+}
+
+static std::uint32_t Crc32_Accelerated(std::uint32_t crc, const std::uint8_t* bytes, std::size_t num_bytes)
+{
+  static const bool s_HasPCLMUL = Crc32_CPUSupportsPCLMUL();
+
+  if (s_HasPCLMUL && num_bytes >= 64u)
   {
-#if _WIN32
-    const binaryIO::IOOffset file_position = _ftelli64(file_handle);
+    const std::size_t num_folded_bytes = num_bytes & ~std::size_t(15u);
+
+    crc = Crc32_FoldPCLMUL(crc, bytes, num_folded_bytes);
+    bytes += num_folded_bytes;
+    num_bytes -= num_folded_bytes;
+  }
+
+  return Crc32_Slicing8(crc, bytes, num_bytes);
+}
+#elif BINARY_IO_CRC32_ARM
+static std::uint32_t Crc32_Accelerated(std::uint32_t crc, const std::uint8_t* bytes, std::size_t num_bytes)
+{
+  for (; num_bytes >= 8u; num_bytes -= 8u, bytes += 8u)
+  {
+    std::uint64_t value;
+    std::memcpy(&value, bytes, sizeof(value));
+    crc = __crc32d(crc, value);
+  }
+
+  for (; num_bytes != 0u; --num_bytes, ++bytes)
+  {
+    crc = __crc32b(crc, *bytes);
+  }
+
+  return crc;
+}
 #else
-    const binaryIO::IOOffset file_position = ftello(file_handle);
+static std::uint32_t Crc32_Accelerated(std::uint32_t crc, const std::uint8_t* bytes, std::size_t num_bytes)
+{
+  return Crc32_Slicing8(crc, bytes, num_bytes);
+}
 #endif
 
-    if (file_position != -1L)
+void crc32_addBytesRuntime(std::uint32_t* in_out_crc, const void* bytes, std::size_t num_bytes)
+{
+  *in_out_crc = Crc32_Accelerated(*in_out_crc, static_cast<const std::uint8_t*>(bytes), num_bytes);
+}
+
+//
+// crc32_combine works in GF(2) polynomial arithmetic modulo the crc polynomial,
+// appending `n` bytes to a crc is a multiplication by x^(8n), the same approach used by zlib.
+//
+
+static constexpr std::uint32_t k_Crc32Polynomial = 0xEDB88320;
+
+static constexpr std::uint32_t Crc32_MultiplyModP(std::uint32_t a, std::uint32_t b)
+{
+  std::uint32_t m = std::uint32_t(1) << 31;
+  std::uint32_t p = 0u;
+
+  for (;;)
+  {
+    if (a & m)
     {
-      return binaryIO::IOResult(file_position, binaryIO::IOErrorCode::Success);
+      p ^= b;
+
+      if ((a & (m - 1u)) == 0u)
+      {
+        break;
+      }
     }
+
+    m >>= 1;
+    b = (b & 1u) ? (b >> 1) ^ k_Crc32Polynomial : b >> 1;
   }
 
-  return binaryIO::IOErrorCode::SeekError;
+  return p;
 }
 
-static binaryIO::IOErrorCode CFile_Close(binaryIO::IOStream* const stream)
+namespace
 {
-  std::FILE* const file_handle = static_cast<std::FILE*>(stream->user_data.values[0].as_handle);
+  struct Crc32PowerTable
+  {
+    std::uint32_t x2n[32];  //!< x^(2^n) modulo p.
+  };
 
-  const int err = std::fclose(file_handle);
+  constexpr Crc32PowerTable MakeCrc32PowerTable()
+  {
+    Crc32PowerTable result = {};
+    std::uint32_t   p      = std::uint32_t(1) << 30;  // x^1
 
-  return err == 0 ? binaryIO::IOErrorCode::Success : binaryIO::IOErrorCode::UnknownError;
+    result.x2n[0] = p;
+
+    for (std::size_t n = 1; n < 32; ++n)
+    {
+      result.x2n[n] = p = Crc32_MultiplyModP(p, p);
+    }
+
+    return result;
+  }
+
+  constexpr Crc32PowerTable k_Crc32Powers = MakeCrc32PowerTable();
+}  // namespace
+
+std::uint32_t crc32_combine(std::uint32_t crc_a, std::uint32_t crc_b, std::uint64_t num_bytes_b)
+{
+  std::uint32_t x_pow = std::uint32_t(1) << 31;  // x^0
+  unsigned      k     = 3u;                      // Bytes to bits.
+
+  for (; num_bytes_b != 0u; num_bytes_b >>= 1, ++k)
+  {
+    if (num_bytes_b & 1u)
+    {
+      x_pow = Crc32_MultiplyModP(k_Crc32Powers.x2n[k & 31], x_pow);
+    }
+  }
+
+  return Crc32_MultiplyModP(x_pow, crc_a) ^ crc_b;
 }
 
-binaryIO::IOStream binaryIO::IOStream_FromCFile(std::FILE* const file_handle)
+// binary_executor.hpp
+
+static void Executor_SerialParallelFor(binaryIO::Executor* const executor, const binaryIO::IOSize num_tasks, const binaryIO::ExecutorTaskFn task, void* const task_data)
 {
-  binaryIO::IOStream result            = {};
-  result.Size                          = nullptr;
-  result.Read                          = &CFile_Read;
-  result.Write                         = &CFile_Write;
-  result.Seek                          = &CFile_Seek;
-  result.Close                         = &CFile_Close;
-  result.user_data.values[0].as_handle = file_handle;
+  (void)executor;
+
+  for (binaryIO::IOSize i = 0u; i < num_tasks; ++i)
+  {
+    task(task_data, i);
+  }
+}
+
+//
+// The helpers sleep between batches, every helper takes part in every batch
+// so a helper is never more than one `batch_index` behind and the caller
+// can reuse the batch fields once `num_busy_helpers` is back to zero.
+//
+
+namespace
+{
+  struct ThreadExecutorState
+  {
+    std::mutex                    lock             = {};
+    std::condition_variable       work_signal      = {};
+    std::condition_variable       done_signal      = {};
+    std::atomic<bool>             is_running       = {false};  //!< Claimed by the thread running the current batch.
+    binaryIO::ExecutorTaskFn      task             = nullptr;
+    void*                         task_data        = nullptr;
+    binaryIO::IOSize              num_tasks        = 0u;
+    std::atomic<binaryIO::IOSize> next_task        = {0u};
+    binaryIO::IOSize              batch_index      = 0u;
+    binaryIO::IOSize              num_busy_helpers = 0u;
+    bool                          is_closing       = false;
+    std::vector<std::thread>      helpers          = {};
+  };
+}  // namespace
+
+static void ThreadExecutor_RunTasks(ThreadExecutorState* const state, const binaryIO::IOSize num_tasks, const binaryIO::ExecutorTaskFn task, void* const task_data)
+{
+  for (binaryIO::IOSize i = state->next_task++; i < num_tasks; i = state->next_task++)
+  {
+    task(task_data, i);
+  }
+}
+
+static void ThreadExecutor_HelperMain(ThreadExecutorState* const state)
+{
+  std::unique_lock<std::mutex> guard{state->lock};
+  binaryIO::IOSize             batch_index = 0u;  // Helpers are started before the first batch.
+
+  for (;;)
+  {
+    state->work_signal.wait(guard, [state, batch_index]() { return state->batch_index != batch_index || state->is_closing; });
+
+    if (state->is_closing)
+    {
+      break;
+    }
+
+    const binaryIO::IOSize         num_tasks = state->num_tasks;
+    const binaryIO::ExecutorTaskFn task      = state->task;
+    void* const                    task_data = state->task_data;
+
+    batch_index = state->batch_index;
+
+    guard.unlock();
+    ThreadExecutor_RunTasks(state, num_tasks, task, task_data);
+    guard.lock();
+
+    if (--state->num_busy_helpers == 0u)
+    {
+      state->done_signal.notify_one();
+    }
+  }
+}
+
+static void Executor_ThreadsParallelFor(binaryIO::Executor* const executor, const binaryIO::IOSize num_tasks, const binaryIO::ExecutorTaskFn task, void* const task_data)
+{
+  ThreadExecutorState* const state       = static_cast<ThreadExecutorState*>(executor->user_data);
+  bool                       was_running = false;
+
+  // Single tasks, batches started from within a task and batches overlapping another thread's stay on the calling thread.
+  if (num_tasks <= 1u || !state->is_running.compare_exchange_strong(was_running, true, std::memory_order_acquire))
+  {
+    Executor_SerialParallelFor(executor, num_tasks, task, task_data);
+    return;
+  }
+
+  {
+    const std::lock_guard<std::mutex> guard{state->lock};
+
+    state->task             = task;
+    state->task_data        = task_data;
+    state->num_tasks        = num_tasks;
+    state->next_task        = 0u;
+    state->num_busy_helpers = state->helpers.size();
+    ++state->batch_index;
+  }
+
+  state->work_signal.notify_all();
+
+  ThreadExecutor_RunTasks(state, num_tasks, task, task_data);
+
+  {
+    std::unique_lock<std::mutex> guard{state->lock};
+    state->done_signal.wait(guard, [state]() { return state->num_busy_helpers == 0u; });
+  }
+
+  state->is_running.store(false, std::memory_order_release);
+}
+
+static void Executor_ThreadsDestroy(binaryIO::Executor* const executor)
+{
+  ThreadExecutorState* const state = static_cast<ThreadExecutorState*>(executor->user_data);
+
+  {
+    const std::lock_guard<std::mutex> guard{state->lock};
+    state->is_closing = true;
+  }
+
+  state->work_signal.notify_all();
+
+  for (std::thread& helper : state->helpers)
+  {
+    helper.join();
+  }
+
+  delete state;
+}
+
+binaryIO::Executor binaryIO::Executor_Serial()
+{
+  binaryIO::Executor result = {};
+  result.ParallelFor        = &Executor_SerialParallelFor;
+  result.num_workers        = 1u;
 
   return result;
 }
 
-#if 0
-static binaryIO::IOErrorCode Generic_Refill(binaryIO::IOStream* const stream)
+binaryIO::Executor binaryIO::Executor_FromThreads(const IOSize num_threads)
 {
-  if (stream->error_state != binaryIO::IOErrorCode::Success)
+  binaryIO::Executor result = Executor_Serial();
+
+  if (num_threads <= 1u)
   {
-    return stream->error_state;
+    return result;
   }
 
-  binaryIO::BufferedIO* const buffered_io = &stream->buffered_io;
+  ThreadExecutorState* const state = new (std::nothrow) ThreadExecutorState();
 
-  std::uint8_t* const         data_bgn            = const_cast<std::uint8_t*>(buffered_io->buffer_start);
-  std::uint8_t* const         read_end            = const_cast<std::uint8_t*>(buffered_io->cursor);
-  std::uint8_t* const         data_end            = const_cast<std::uint8_t*>(buffered_io->buffer_end);
-  std::uint8_t* const         write_start         = std::rotate(data_bgn, read_end, data_end);
-  const std::size_t           num_bytes_in_buffer = static_cast<std::uint8_t*>(stream->user_datas[0]) - write_start;
-  const binaryIO::IOResult    read_result         = IOStream_Read(stream, write_start, num_bytes_in_buffer);
-  const binaryIO::IOErrorCode read_error          = read_result.ErrorCode();
+  if (!state)
+  {
+    return result;
+  }
 
-  if (read_error == binaryIO::IOErrorCode::Success)
+  // Running with fewer helpers than asked for is still correct.
+  try
   {
-    buffered_io->buffer_start = data_bgn;
-    buffered_io->cursor       = buffered_io->buffer_start;
-    buffered_io->buffer_end   = write_start + read_result.Value();
+    state->helpers.reserve(num_threads - 1u);
 
-    return binaryIO::IOErrorCode::Success;
+    for (IOSize i = 1u; i < num_threads; ++i)
+    {
+      state->helpers.emplace_back(&ThreadExecutor_HelperMain, state);
+    }
+  }
+  catch (const std::system_error&)
+  {
+  }
+  catch (const std::bad_alloc&)
+  {
+  }
+
+  if (state->helpers.empty())
+  {
+    delete state;
+    return result;
   }
 
-  return BufferedIO_Failure(stream, read_error);
+  result.ParallelFor = &Executor_ThreadsParallelFor;
+  result.Destroy     = &Executor_ThreadsDestroy;
+  result.user_data   = state;
+  result.num_workers = state->helpers.size() + 1u;
+
+  return result;
+}
+
+void binaryIO::Executor_Destroy(Executor* const executor)
+{
+  if (executor->Destroy)
+  {
+    executor->Destroy(executor);
+  }
+
+  *executor = Executor_Serial();
+}
+
+// Chunk Verification
+
+namespace
+{
+  struct ChunkVerifyRange
+  {
+    const std::uint8_t* bytes;
+    binaryIO::IOSize    num_bytes;
+    std::uint32_t       crc;
+  };
+
+  struct ChunkVerifyEntry
+  {
+    const std::uint8_t* footer;
+    binaryIO::IOSize    first_range;
+    binaryIO::IOSize    num_ranges;
+  };
+}  // namespace
+
+static constexpr binaryIO::IOSize k_ChunkVerifyRangeSize = 1u << 20;
+
+binaryIO::IOResult binaryIO::VerifyChunks(const void* const file_bytes, const IOSize size, Executor& executor)
+{
+  const std::uint8_t* const file_bgn = static_cast<const std::uint8_t*>(file_bytes);
+
+  std::vector<ChunkVerifyEntry> chunks = {};
+  std::vector<ChunkVerifyRange> ranges = {};
+  IOErrorCode                   error  = IOErrorCode::Success;
+
+  for (IOSize offset = 0u; offset != size;)
+  {
+    BinaryChunkHeader header;
+
+    if (size - offset < sizeof(header))
+    {
+      error = IOErrorCode::InvalidData;
+      break;
+    }
+
+    std::memcpy(&header, file_bgn + offset, sizeof(header));
+
+    // Overflow safe form of `offset + header.sizeInfo() <= size`.
+    const IOSize bytes_left = size - offset;
+
+    if (header.header_size < sizeof(BinaryChunkHeader) ||
+        header.data_size > bytes_left ||
+        header.sizeInfo(BinaryChunkParts::HeaderFooter) > bytes_left - header.data_size)
+    {
+      error = IOErrorCode::InvalidData;
+      break;
+    }
+
+    const std::uint8_t* const data       = file_bgn + offset + header.header_size;
+    ChunkVerifyEntry          chunk      = {data + header.data_size, ranges.size(), 0u};
+    IOSize                    data_left  = header.data_size;
+    const std::uint8_t*       data_range = data;
+
+    do
+    {
+      const IOSize range_size = std::min(data_left, k_ChunkVerifyRangeSize);
+
+      ranges.push_back(ChunkVerifyRange{data_range, range_size, 0u});
+      ++chunk.num_ranges;
+
+      data_range += range_size;
+      data_left -= range_size;
+    } while (data_left != 0u);
+
+    chunks.push_back(chunk);
+    offset += header.sizeInfo();
+  }
+
+  executor.ParallelFor(
+   &executor,
+   ranges.size(),
+   [](void* const task_data, const IOSize task_index) {
+     ChunkVerifyRange& range = static_cast<ChunkVerifyRange*>(task_data)[task_index];
+
+     range.crc = crc32_begin();
+     crc32_addBytes(&range.crc, range.bytes, range.num_bytes);
+     crc32_end(&range.crc);
+   },
+   ranges.data());
+
+  for (IOSize chunk_index = 0u; chunk_index < chunks.size(); ++chunk_index)
+  {
+    const ChunkVerifyEntry& chunk = chunks[chunk_index];
+    std::uint32_t           crc   = ranges[chunk.first_range].crc;
+
+    for (IOSize i = 1u; i < chunk.num_ranges; ++i)
+    {
+      const ChunkVerifyRange& range = ranges[chunk.first_range + i];
+
+      crc = crc32_combine(crc, range.crc, range.num_bytes);
+    }
+
+    BinaryChunkFooter footer;
+    std::memcpy(&footer, chunk.footer, sizeof(footer));
+
+    if (footer.crc32_checksum != crc)
+    {
+      return IOResult(chunk_index, IOErrorCode::InvalidData);
+    }
+  }
+
+  return IOResult(chunks.size(), error);
 }
-#endif
 
 /******************************************************************************/
 /*
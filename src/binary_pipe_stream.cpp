@@ -0,0 +1,389 @@
+/******************************************************************************/
+/*!
+ * @file   binary_pipe_stream.cpp
+ * @author Shareef Abdoul-Raheem (https://blufedora.github.io/)
+ * @date   2024-11-14
+ * @brief
+ *   Implementation of the single producer / single consumer pipe streams.
+ *
+ *   The data path only touches the two positions, the mutex and condition
+ *   variable are used to sleep once spinning for a short while did not help.
+ *
+ * @copyright Copyright (c) 2024 Shareef Abdoul-Raheem
+ */
+/******************************************************************************/
+#include "binaryio/binary_pipe_stream.hpp"
+
+#include "binaryio/binary_assert.hpp"  // binaryIOAssert
+
+#include <algorithm>           // min
+#include <atomic>              // atomic, atomic_thread_fence
+#include <condition_variable>  // condition_variable
+#include <cstdint>             // uint8_t, uint64_t
+#include <cstring>             // memcpy
+#include <memory>              // align
+#include <mutex>               // mutex, unique_lock, lock_guard
+#include <new>                 // placement new
+#include <thread>              // this_thread::yield
+
+// Pipe
+//
+// Positions count every byte that went through the pipe so they never wrap, `position % capacity` is the ring index.
+// [read_position, write_position) is published and owned by the reader, the rest of the ring is owned by the writer.
+// The writer's window starts at `write_position` and the reader's window starts at `read_position`.
+//
+// user_data.values[0] : PipeState* (placed at the start of the scratch buffer)
+//
+
+namespace
+{
+  constexpr std::size_t k_PipeCacheLineSize = 64u;
+  constexpr int         k_PipeSpinCount     = 32;  //!< Number of yields before a thread sleeps, keeps a busy pipe out of the kernel.
+
+  struct PipeState
+  {
+    std::uint8_t*    ring;
+    binaryIO::IOSize capacity;
+
+    // Each position is on its own cache line so the two threads do not invalidate each other on every update.
+
+    alignas(k_PipeCacheLineSize) std::atomic<std::uint64_t> write_position;
+    std::atomic<bool> is_writer_closed;
+
+    alignas(k_PipeCacheLineSize) std::atomic<std::uint64_t> read_position;
+    std::atomic<bool> is_reader_closed;
+
+    alignas(k_PipeCacheLineSize) std::mutex lock;
+    std::condition_variable    signal;
+    std::atomic<unsigned>      num_waiting;
+    std::atomic<unsigned>      num_open_ends;
+  };
+}  // namespace
+
+static PipeState* Pipe_State(const binaryIO::IOStream* const stream)
+{
+  return static_cast<PipeState*>(stream->user_data.values[0].as_handle);
+}
+
+template<typename F>
+static void Pipe_WaitUntil(PipeState* const state, F&& is_ready)
+{
+  for (int i = 0; i < k_PipeSpinCount; ++i)
+  {
+    if (is_ready())
+    {
+      return;
+    }
+
+    std::this_thread::yield();
+  }
+
+  std::unique_lock<std::mutex> guard{state->lock};
+
+  // Pairs with the fence in `Pipe_Wake`, either this thread sees the new position or the other thread sees the waiter.
+  state->num_waiting.fetch_add(1u, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  state->signal.wait(guard, is_ready);
+  state->num_waiting.fetch_sub(1u, std::memory_order_relaxed);
+}
+
+static void Pipe_Wake(PipeState* const state)
+{
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  if (state->num_waiting.load(std::memory_order_relaxed) != 0u)
+  {
+    // Taking the lock orders the update before the waiter's check of its predicate.
+    {
+      const std::lock_guard<std::mutex> guard{state->lock};
+    }
+
+    state->signal.notify_all();
+  }
+}
+
+static void Pipe_CloseEnd(binaryIO::IOStream* const stream, std::atomic<bool>* const is_closed)
+{
+  PipeState* const state = Pipe_State(stream);
+
+  is_closed->store(true, std::memory_order_release);
+  Pipe_Wake(state);
+
+  stream->user_data.values[0].as_handle = nullptr;
+
+  if (state->num_open_ends.fetch_sub(1u, std::memory_order_acq_rel) == 1u)
+  {
+    state->~PipeState();
+  }
+}
+
+// Writer
+
+static void PipeWriter_SetWindow(binaryIO::IOStream* const stream)
+{
+  PipeState* const       state          = Pipe_State(stream);
+  const std::uint64_t    write_position = state->write_position.load(std::memory_order_relaxed);
+  const std::uint64_t    read_position  = state->read_position.load(std::memory_order_acquire);
+  const binaryIO::IOSize index          = binaryIO::IOSize(write_position % state->capacity);
+  const binaryIO::IOSize num_free       = state->capacity - binaryIO::IOSize(write_position - read_position);
+  std::uint8_t* const    window         = state->ring + index;
+
+  stream->buffered_write.buffer_start = window;
+  stream->buffered_write.cursor       = window;
+  stream->buffered_write.buffer_end   = window + std::min(num_free, state->capacity - index);
+}
+
+static void PipeWriter_Publish(binaryIO::IOStream* const stream)
+{
+  PipeState* const       state      = Pipe_State(stream);
+  const binaryIO::IOSize num_staged = stream->buffered_write.cursor - stream->buffered_write.buffer_start;
+
+  if (num_staged != 0u)
+  {
+    state->write_position.store(state->write_position.load(std::memory_order_relaxed) + num_staged, std::memory_order_release);
+    Pipe_Wake(state);
+  }
+
+  PipeWriter_SetWindow(stream);
+}
+
+static binaryIO::IOErrorCode PipeWriter_Flush(binaryIO::IOStream* const stream)
+{
+  if (Pipe_State(stream)->is_reader_closed.load(std::memory_order_acquire))
+  {
+    // Nobody will read the staged bytes.
+    if (stream->buffered_write.cursor != stream->buffered_write.buffer_start)
+    {
+      stream->buffered_write.cursor = stream->buffered_write.buffer_start;
+      stream->error_state           = binaryIO::IOErrorCode::EndOfStream;
+    }
+  }
+  else
+  {
+    PipeWriter_Publish(stream);
+  }
+
+  return stream->error_state;
+}
+
+static binaryIO::IOResult PipeWriter_Write(binaryIO::IOStream* const stream, const void* const source, const binaryIO::IOSize num_source_bytes)
+{
+  PipeState* const                 state          = Pipe_State(stream);
+  binaryIO::BufferedWriteIO* const buffered_write = &stream->buffered_write;
+  const std::uint8_t* const        bytes          = static_cast<const std::uint8_t*>(source);
+  binaryIO::IOSize                 num_written    = 0u;
+
+  while (num_written != num_source_bytes)
+  {
+    if (state->is_reader_closed.load(std::memory_order_acquire))
+    {
+      buffered_write->cursor = buffered_write->buffer_start;
+      return binaryIO::IOResult(num_written, binaryIO::IOErrorCode::EndOfStream);
+    }
+
+    if (buffered_write->cursor == buffered_write->buffer_end)
+    {
+      PipeWriter_Publish(stream);
+
+      if (buffered_write->cursor == buffered_write->buffer_end)
+      {
+        Pipe_WaitUntil(state, [state]() {
+          const std::uint64_t write_position = state->write_position.load(std::memory_order_relaxed);
+          const std::uint64_t read_position  = state->read_position.load(std::memory_order_acquire);
+
+          return write_position - read_position != state->capacity || state->is_reader_closed.load(std::memory_order_acquire);
+        });
+
+        PipeWriter_SetWindow(stream);
+      }
+
+      continue;
+    }
+
+    const binaryIO::IOSize num_bytes_to_copy = std::min(num_source_bytes - num_written, BufferedWrite_NumBytesAvailable(stream));
+
+    std::memcpy(buffered_write->cursor, bytes + num_written, num_bytes_to_copy);
+    buffered_write->cursor += num_bytes_to_copy;
+    num_written += num_bytes_to_copy;
+
+    // A full window has nothing left to stage into, hand it over right away.
+    if (buffered_write->cursor == buffered_write->buffer_end)
+    {
+      PipeWriter_Publish(stream);
+    }
+  }
+
+  return binaryIO::IOResult(num_written, binaryIO::IOErrorCode::Success);
+}
+
+static binaryIO::IOErrorCode PipeWriter_Close(binaryIO::IOStream* const stream)
+{
+  if (!Pipe_State(stream))
+  {
+    return binaryIO::IOErrorCode::Success;
+  }
+
+  const binaryIO::IOErrorCode result = PipeWriter_Flush(stream);
+
+  Pipe_CloseEnd(stream, &Pipe_State(stream)->is_writer_closed);
+  stream->buffered_write = {};
+
+  return result;
+}
+
+// Reader
+
+static binaryIO::IOErrorCode PipeReader_Refill(binaryIO::IOStream* const stream);
+
+static bool PipeReader_HasFailed(const binaryIO::IOStream* const stream)
+{
+  return stream->buffered_io.Refill != &PipeReader_Refill;
+}
+
+static void PipeReader_SetWindow(binaryIO::IOStream* const stream)
+{
+  PipeState* const          state          = Pipe_State(stream);
+  const std::uint64_t       read_position  = state->read_position.load(std::memory_order_relaxed);
+  const std::uint64_t       write_position = state->write_position.load(std::memory_order_acquire);
+  const binaryIO::IOSize    index          = binaryIO::IOSize(read_position % state->capacity);
+  const binaryIO::IOSize    num_published  = binaryIO::IOSize(write_position - read_position);
+  const std::uint8_t* const window         = state->ring + index;
+
+  stream->buffered_io.buffer_start = window;
+  stream->buffered_io.cursor       = window;
+  stream->buffered_io.buffer_end   = window + std::min(num_published, state->capacity - index);
+  stream->buffered_io.Refill       = &PipeReader_Refill;
+}
+
+static binaryIO::IOErrorCode PipeReader_Refill(binaryIO::IOStream* const stream)
+{
+  PipeState* const       state        = Pipe_State(stream);
+  const binaryIO::IOSize num_consumed = stream->buffered_io.buffer_end - stream->buffered_io.buffer_start;
+
+  if (num_consumed != 0u)
+  {
+    state->read_position.store(state->read_position.load(std::memory_order_relaxed) + num_consumed, std::memory_order_release);
+    Pipe_Wake(state);
+  }
+
+  PipeReader_SetWindow(stream);
+
+  if (stream->buffered_io.cursor == stream->buffered_io.buffer_end)
+  {
+    Pipe_WaitUntil(state, [state]() {
+      return state->write_position.load(std::memory_order_acquire) != state->read_position.load(std::memory_order_relaxed) ||
+             state->is_writer_closed.load(std::memory_order_acquire);
+    });
+
+    // The writer publishes before closing so this sees every byte it wrote.
+    PipeReader_SetWindow(stream);
+
+    if (stream->buffered_io.cursor == stream->buffered_io.buffer_end)
+    {
+      return BufferedIO_Failure(stream, binaryIO::IOErrorCode::EndOfStream);
+    }
+  }
+
+  return binaryIO::IOErrorCode::Success;
+}
+
+static binaryIO::IOResult PipeReader_Read(binaryIO::IOStream* const stream, void* const destination, const binaryIO::IOSize num_destination_bytes)
+{
+  binaryIO::BufferedIO* const buffered_io = &stream->buffered_io;
+  std::uint8_t* const         out         = static_cast<std::uint8_t*>(destination);
+  binaryIO::IOSize            num_read    = 0u;
+
+  while (num_read != num_destination_bytes)
+  {
+    // After a failed refill the window is the zero buffer which must not be returned as data.
+    if (PipeReader_HasFailed(stream))
+    {
+      return binaryIO::IOResult(num_read, stream->error_state);
+    }
+
+    if (buffered_io->cursor == buffered_io->buffer_end && PipeReader_Refill(stream) != binaryIO::IOErrorCode::Success)
+    {
+      return binaryIO::IOResult(num_read, stream->error_state);
+    }
+
+    const binaryIO::IOSize num_bytes_to_copy = std::min(num_destination_bytes - num_read, BufferedIO_NumBytesAvailable(stream));
+
+    std::memcpy(out + num_read, buffered_io->cursor, num_bytes_to_copy);
+    num_read += num_bytes_to_copy;
+    buffered_io->cursor += num_bytes_to_copy;
+  }
+
+  return binaryIO::IOResult(num_read, binaryIO::IOErrorCode::Success);
+}
+
+static binaryIO::IOErrorCode PipeReader_Close(binaryIO::IOStream* const stream)
+{
+  if (!Pipe_State(stream))
+  {
+    return binaryIO::IOErrorCode::Success;
+  }
+
+  Pipe_CloseEnd(stream, &Pipe_State(stream)->is_reader_closed);
+  stream->buffered_io = {};
+
+  return binaryIO::IOErrorCode::Success;
+}
+
+binaryIO::IOPipe binaryIO::IOStream_MakePipe(void* const scratch, const IOSize scratch_size)
+{
+  void*       state_memory = scratch;
+  std::size_t space        = std::size_t(scratch_size);
+
+  const bool is_large_enough = std::align(alignof(PipeState), sizeof(PipeState), state_memory, space) && space > sizeof(PipeState);
+
+  binaryIOAssert(is_large_enough, "The scratch buffer must hold the pipe state and a non empty ring.");
+  (void)is_large_enough;
+
+  PipeState* const state = new (state_memory) PipeState{};
+
+  state->ring          = reinterpret_cast<std::uint8_t*>(state + 1);
+  state->capacity      = space - sizeof(PipeState);
+  state->num_open_ends = 2u;
+
+  binaryIO::IOPipe result = {};
+
+  result.writer.Write                            = &PipeWriter_Write;
+  result.writer.Close                            = &PipeWriter_Close;
+  result.writer.buffered_write.Flush             = &PipeWriter_Flush;
+  result.writer.user_data.values[0].as_handle    = state;
+  result.reader.Read                             = &PipeReader_Read;
+  result.reader.Close                            = &PipeReader_Close;
+  result.reader.user_data.values[0].as_handle    = state;
+
+  PipeWriter_SetWindow(&result.writer);
+  PipeReader_SetWindow(&result.reader);
+
+  return result;
+}
+
+/******************************************************************************/
+/*
+  MIT License
+
+  Copyright (c) 2024 Shareef Abdoul-Raheem
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+/******************************************************************************/
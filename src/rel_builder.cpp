@@ -0,0 +1,124 @@
+/******************************************************************************/
+/*!
+ * @file   rel_builder.cpp
+ * @author Shareef Abdoul-Raheem (https://blufedora.github.io/)
+ * @date   2024-11-10
+ * @brief
+ *   Allocation, fixup resolution and chunk output of the relative pointer buffer builder.
+ *
+ * @copyright Copyright (c) 2024 Shareef Abdoul-Raheem
+ */
+/******************************************************************************/
+#include "binaryio/rel_builder.hpp"
+
+#include "binaryio/binary_assert.hpp"    // binaryIOAssert
+#include "binaryio/binary_chunk_io.hpp"  // ChunkWriter
+
+binaryIO::IOSize binaryIO::RelBuilder::allocate(const IOSize num_bytes, const IOSize alignment)
+{
+  binaryIOAssert(alignment != 0u && (alignment & (alignment - 1u)) == 0u, "Alignment must be a power of two.");
+  binaryIOAssert(alignment <= alignof(std::max_align_t), "The buffer itself is only aligned to alignof(std::max_align_t).");
+
+  const IOSize offset = (bytes.size() + alignment - 1u) & ~(alignment - 1u);
+
+  bytes.resize(offset + num_bytes, 0u);
+
+  if (alignment > max_alignment)
+  {
+    max_alignment = alignment;
+  }
+
+  return offset;
+}
+
+void binaryIO::RelBuilder::addFixup(const void* const pointer, const IOSize target_offset, const FixupWriteFn write)
+{
+  const std::uint8_t* const location = static_cast<const std::uint8_t*>(pointer);
+
+  binaryIOAssert(location >= bytes.data() && location < bytes.data() + bytes.size(), "Only pointers inside of the buffer can be linked.");
+
+  fixups.push_back(Fixup{IOSize(location - bytes.data()), target_offset, write});
+}
+
+binaryIO::IOErrorCode binaryIO::RelBuilder::finish()
+{
+  IOErrorCode result = IOErrorCode::Success;
+
+  for (const Fixup& fixup : fixups)
+  {
+    const std::ptrdiff_t byte_offset = std::ptrdiff_t(fixup.target_offset) - std::ptrdiff_t(fixup.pointer_offset);
+
+    if (!fixup.write(bytes.data() + fixup.pointer_offset, byte_offset))
+    {
+      result = IOErrorCode::InvalidOperation;
+    }
+  }
+
+  return result;
+}
+
+binaryIO::IOResult binaryIO::RelBuilder::writeChunk(IOStream* const stream, const BinaryChunkTypeID& type_id, const VersionType version, ChunkTOCWriter* const toc)
+{
+  static constexpr std::uint8_t s_Padding[alignof(std::max_align_t)] = {};
+
+  const IOErrorCode finish_error = finish();
+
+  if (finish_error != IOErrorCode::Success)
+  {
+    return finish_error;
+  }
+
+  // Pads so that data is aligned within the stream, `max_alignment` never exceeds the padding available.
+  std::uint16_t num_padding_bytes = 0u;
+
+  if (IOSteam_SupportsSeek(stream))
+  {
+    const IOResult position = IOStream_Seek(stream, 0, SeekOrigin::CURRENT);
+
+    if (position.ErrorCode() == IOErrorCode::Success)
+    {
+      const IOSize data_position = position.Value() + sizeof(BinaryChunkHeader);
+
+      num_padding_bytes = std::uint16_t((max_alignment - data_position % max_alignment) % max_alignment);
+    }
+  }
+
+  ChunkWriter       writer;
+  const IOErrorCode begin_error = writer.begin(stream, type_id, version, s_Padding, num_padding_bytes, bytes.size() + sizeof(s_Padding));
+
+  if (begin_error != IOErrorCode::Success)
+  {
+    return begin_error;
+  }
+
+  const IOResult write_result = writer.write(bytes.data(), bytes.size());
+  const IOResult end_result   = writer.end(toc);
+
+  return write_result.ErrorCode() != IOErrorCode::Success ? write_result : end_result;
+}
+
+/******************************************************************************/
+/*
+  MIT License
+
+  Copyright (c) 2024 Shareef Abdoul-Raheem
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+/******************************************************************************/
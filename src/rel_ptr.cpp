@@ -0,0 +1,254 @@
+/******************************************************************************/
+/*!
+ * @file   rel_ptr.cpp
+ * @author Shareef Abdoul-Raheem (https://blufedora.github.io/)
+ * @date   2024-11-11
+ * @brief
+ *   Bulk conversion between 32 bit relative pointers and absolute pointers.
+ *
+ * @copyright Copyright (c) 2024 Shareef Abdoul-Raheem
+ */
+/******************************************************************************/
+#include "binaryio/rel_ptr.hpp"
+
+#include <cstring>      // memcpy
+#include <limits>       // numeric_limits
+#include <type_traits>  // is_signed_v
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <emmintrin.h>  // _mm_cmpeq_epi32, _mm_mul_epu32, _mm_unpacklo_epi32
+#define BINARY_IO_REL_PTR_SSE2 1
+#endif
+
+namespace
+{
+  // Scalar Kernels
+  //
+  //   Also handle the remainder of the SIMD loops, starting from `first`.
+  //   Values are copied with `memcpy` since the buffers are only known as bytes here.
+  //
+
+  template<typename Offset>
+  void RelPtr32_ToPointersScalar(const std::uint8_t* const rel_ptrs, const std::size_t first, const std::size_t num_pointers, const std::uint8_t alignment, std::uint8_t* const out_pointers)
+  {
+    static constexpr Offset k_OffsetInvalid = Offset(std::is_signed_v<Offset> ? std::numeric_limits<Offset>::min() : std::numeric_limits<Offset>::max());
+
+    for (std::size_t i = first; i < num_pointers; ++i)
+    {
+      Offset offset;
+      std::memcpy(&offset, rel_ptrs + i * sizeof(Offset), sizeof(offset));
+
+      const std::uintptr_t base    = reinterpret_cast<std::uintptr_t>(rel_ptrs + i * sizeof(Offset));
+      const std::uintptr_t address = base + std::uintptr_t(offset) * std::uintptr_t(alignment);
+      const std::uintptr_t mask    = std::uintptr_t(0u) - std::uintptr_t(offset != k_OffsetInvalid);
+      const std::uintptr_t result  = address & mask;
+
+      std::memcpy(out_pointers + i * sizeof(result), &result, sizeof(result));
+    }
+  }
+
+  template<typename Offset>
+  void RelPtr32_FromPointersScalar(const std::uint8_t* const pointers, const std::size_t first, const std::size_t num_pointers, const std::uint8_t alignment, std::uint8_t* const out_rel_ptrs)
+  {
+    static constexpr Offset k_OffsetInvalid = Offset(std::is_signed_v<Offset> ? std::numeric_limits<Offset>::min() : std::numeric_limits<Offset>::max());
+
+    for (std::size_t i = first; i < num_pointers; ++i)
+    {
+      std::uintptr_t address;
+      std::memcpy(&address, pointers + i * sizeof(address), sizeof(address));
+
+      const std::uintptr_t base   = reinterpret_cast<std::uintptr_t>(out_rel_ptrs + i * sizeof(Offset));
+      const std::ptrdiff_t off    = std::ptrdiff_t(address - base);
+      const Offset         offset = address ? Offset(off / std::ptrdiff_t(alignment)) : k_OffsetInvalid;
+
+      std::memcpy(out_rel_ptrs + i * sizeof(Offset), &offset, sizeof(offset));
+    }
+  }
+
+  bool IsPowerOfTwo(const std::uint8_t value, int* const out_shift)
+  {
+    int shift = 0;
+
+    while ((1u << shift) < value)
+    {
+      ++shift;
+    }
+
+    *out_shift = shift;
+    return (1u << shift) == value;
+  }
+
+#if BINARY_IO_REL_PTR_SSE2
+  // SSE2 Kernels
+  //
+  //   Four offsets fill one register and the matching four pointers fill two,
+  //   `base_lo` holds the addresses of the first two `rel_ptr`s of a group and `base_hi` the last two.
+  //
+
+  // Multiplies 64 bit lanes by a 32 bit value from its low and high halves, SSE2 has no 64 bit multiply.
+  __m128i RelPtr32_MulLanes(const __m128i values, const __m128i multiplier)
+  {
+    const __m128i lo = _mm_mul_epu32(values, multiplier);
+    const __m128i hi = _mm_mul_epu32(_mm_srli_epi64(values, 32), multiplier);
+
+    return _mm_add_epi64(lo, _mm_slli_epi64(hi, 32));
+  }
+
+  template<bool is_signed>
+  std::size_t RelPtr32_ToPointersSSE2(const std::uint8_t* const rel_ptrs, const std::size_t num_pointers, const std::uint8_t alignment, std::uint8_t* const out_pointers)
+  {
+    const __m128i invalid    = _mm_set1_epi32(is_signed ? std::numeric_limits<std::int32_t>::min() : -1);
+    const __m128i multiplier = _mm_set1_epi64x(alignment);
+    const __m128i step       = _mm_set1_epi64x(4 * sizeof(std::int32_t));
+    const __m128i half_step  = _mm_set1_epi64x(2 * sizeof(std::int32_t));
+    int           shift;
+    const bool    use_shift = IsPowerOfTwo(alignment, &shift);
+    const __m128i shift_by  = _mm_cvtsi32_si128(shift);
+
+    __m128i base_lo = _mm_set_epi64x(std::int64_t(reinterpret_cast<std::uintptr_t>(rel_ptrs) + sizeof(std::int32_t)), std::int64_t(reinterpret_cast<std::uintptr_t>(rel_ptrs)));
+
+    std::size_t i = 0u;
+
+    for (; i + 4u <= num_pointers; i += 4u)
+    {
+      const __m128i offsets = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rel_ptrs + i * sizeof(std::int32_t)));
+      const __m128i is_null = _mm_cmpeq_epi32(offsets, invalid);
+      const __m128i extend  = is_signed ? _mm_srai_epi32(offsets, 31) : _mm_setzero_si128();
+      __m128i       lo      = _mm_unpacklo_epi32(offsets, extend);
+      __m128i       hi      = _mm_unpackhi_epi32(offsets, extend);
+
+      if (use_shift)
+      {
+        lo = _mm_sll_epi64(lo, shift_by);
+        hi = _mm_sll_epi64(hi, shift_by);
+      }
+      else
+      {
+        lo = RelPtr32_MulLanes(lo, multiplier);
+        hi = RelPtr32_MulLanes(hi, multiplier);
+      }
+
+      const __m128i base_hi = _mm_add_epi64(base_lo, half_step);
+      const __m128i null_lo = _mm_unpacklo_epi32(is_null, is_null);
+      const __m128i null_hi = _mm_unpackhi_epi32(is_null, is_null);
+
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out_pointers + i * sizeof(void*)), _mm_andnot_si128(null_lo, _mm_add_epi64(base_lo, lo)));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out_pointers + (i + 2u) * sizeof(void*)), _mm_andnot_si128(null_hi, _mm_add_epi64(base_hi, hi)));
+
+      base_lo = _mm_add_epi64(base_lo, step);
+    }
+
+    return i;
+  }
+
+  // Only power of two alignments, after the shift the low half of each lane is the offset whether or not it is signed.
+  std::size_t RelPtr32_FromPointersSSE2(const std::uint8_t* const pointers, const std::size_t num_pointers, const std::int32_t invalid_offset, const int shift, std::uint8_t* const out_rel_ptrs)
+  {
+    const __m128i invalid   = _mm_set1_epi32(invalid_offset);
+    const __m128i step      = _mm_set1_epi64x(4 * sizeof(std::int32_t));
+    const __m128i half_step = _mm_set1_epi64x(2 * sizeof(std::int32_t));
+    const __m128i shift_by  = _mm_cvtsi32_si128(shift);
+    const __m128i zero      = _mm_setzero_si128();
+
+    __m128i base_lo = _mm_set_epi64x(std::int64_t(reinterpret_cast<std::uintptr_t>(out_rel_ptrs) + sizeof(std::int32_t)), std::int64_t(reinterpret_cast<std::uintptr_t>(out_rel_ptrs)));
+
+    std::size_t i = 0u;
+
+    for (; i + 4u <= num_pointers; i += 4u)
+    {
+      const __m128i address_lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pointers + i * sizeof(void*)));
+      const __m128i address_hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pointers + (i + 2u) * sizeof(void*)));
+      const __m128i base_hi    = _mm_add_epi64(base_lo, half_step);
+      const __m128i offset_lo  = _mm_srl_epi64(_mm_sub_epi64(address_lo, base_lo), shift_by);
+      const __m128i offset_hi  = _mm_srl_epi64(_mm_sub_epi64(address_hi, base_hi), shift_by);
+
+      // A lane is null when both of its halves are zero.
+      const __m128i zero_lo = _mm_cmpeq_epi32(address_lo, zero);
+      const __m128i zero_hi = _mm_cmpeq_epi32(address_hi, zero);
+      const __m128i null_lo = _mm_and_si128(zero_lo, _mm_shuffle_epi32(zero_lo, _MM_SHUFFLE(2, 3, 0, 1)));
+      const __m128i null_hi = _mm_and_si128(zero_hi, _mm_shuffle_epi32(zero_hi, _MM_SHUFFLE(2, 3, 0, 1)));
+
+      // Packs the low half of each lane into four 32 bit offsets.
+      const __m128i offsets = _mm_unpacklo_epi64(_mm_shuffle_epi32(offset_lo, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_epi32(offset_hi, _MM_SHUFFLE(2, 0, 2, 0)));
+      const __m128i is_null = _mm_unpacklo_epi64(_mm_shuffle_epi32(null_lo, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_epi32(null_hi, _MM_SHUFFLE(2, 0, 2, 0)));
+
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out_rel_ptrs + i * sizeof(std::int32_t)), _mm_or_si128(_mm_andnot_si128(is_null, offsets), _mm_and_si128(is_null, invalid)));
+
+      base_lo = _mm_add_epi64(base_lo, step);
+    }
+
+    return i;
+  }
+#endif
+}  // namespace
+
+void binaryIO::detail::RelPtr32_ToPointers(const void* const rel_ptrs, const std::size_t num_pointers, const std::uint8_t alignment, const bool is_signed, void* const out_pointers)
+{
+  const std::uint8_t* const src = static_cast<const std::uint8_t*>(rel_ptrs);
+  std::uint8_t* const       dst = static_cast<std::uint8_t*>(out_pointers);
+  std::size_t               i   = 0u;
+
+#if BINARY_IO_REL_PTR_SSE2
+  i = is_signed ? RelPtr32_ToPointersSSE2<true>(src, num_pointers, alignment, dst) : RelPtr32_ToPointersSSE2<false>(src, num_pointers, alignment, dst);
+#endif
+
+  if (is_signed)
+  {
+    RelPtr32_ToPointersScalar<std::int32_t>(src, i, num_pointers, alignment, dst);
+  }
+  else
+  {
+    RelPtr32_ToPointersScalar<std::uint32_t>(src, i, num_pointers, alignment, dst);
+  }
+}
+
+void binaryIO::detail::RelPtr32_FromPointers(const void* const pointers, const std::size_t num_pointers, const std::uint8_t alignment, const bool is_signed, void* const out_rel_ptrs)
+{
+  const std::uint8_t* const src = static_cast<const std::uint8_t*>(pointers);
+  std::uint8_t* const       dst = static_cast<std::uint8_t*>(out_rel_ptrs);
+  std::size_t               i   = 0u;
+
+#if BINARY_IO_REL_PTR_SSE2
+  int shift;
+
+  if (IsPowerOfTwo(alignment, &shift))
+  {
+    i = RelPtr32_FromPointersSSE2(src, num_pointers, is_signed ? std::numeric_limits<std::int32_t>::min() : -1, shift, dst);
+  }
+#endif
+
+  if (is_signed)
+  {
+    RelPtr32_FromPointersScalar<std::int32_t>(src, i, num_pointers, alignment, dst);
+  }
+  else
+  {
+    RelPtr32_FromPointersScalar<std::uint32_t>(src, i, num_pointers, alignment, dst);
+  }
+}
+
+/******************************************************************************/
+/*
+  MIT License
+
+  Copyright (c) 2024 Shareef Abdoul-Raheem
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+/******************************************************************************/